@@ -21,6 +21,15 @@
 #include "settings.h"
 
 #include <QDir>
+#include <QNetworkCookie>
+
+static QNetworkCookie createCookie(const QString &domain, const QString &path, const QByteArray &name, const QByteArray &value)
+{
+    QNetworkCookie cookie(name, value);
+    cookie.setDomain(domain);
+    cookie.setPath(path);
+    return cookie;
+}
 
 void CookiesTest::initTestCase()
 {
@@ -86,6 +95,15 @@ void CookiesTest::listMatchesDomainTest_data()
     QTest::newRow("test8") << list2 << "c.a.b.x.google.com" << true;
     QTest::newRow("test9") << list2 << ".a.b.x.google.com" << true;
     QTest::newRow("test_empty") << list2 << "" << false;
+
+    QStringList list3;
+    list3 << QSL(".example.com") << QSL("b.c") << QString();
+
+    QTest::newRow("test_dot1") << list3 << "www.example.com" << true;
+    QTest::newRow("test_dot2") << list3 << ".example.com" << true;
+    QTest::newRow("test_repeated") << list3 << "b.c.b.c" << true;
+    QTest::newRow("test_repeated2") << list3 << "ab.c" << false;
+    QTest::newRow("test_empty_item") << list3 << "com" << false;
 }
 
 void CookiesTest::listMatchesDomainTest()
@@ -97,4 +115,59 @@ void CookiesTest::listMatchesDomainTest()
     QCOMPARE(m_cookieJar->listMatchesDomain(list, cookieDomain), result);
 }
 
+void CookiesTest::replaceCookieTest()
+{
+    CookieJar_Tst jar;
+
+    jar.addCookie(createCookie(QSL(".example.com"), QSL("/"), "name", "value1"));
+    jar.addCookie(createCookie(QSL(".example.com"), QSL("/"), "name", "value2"));
+
+    const QVector<QNetworkCookie> cookies = jar.getAllCookies();
+    QCOMPARE(cookies.count(), 1);
+    QCOMPARE(cookies.at(0).value(), QByteArray("value2"));
+}
+
+void CookiesTest::removeCookieTest()
+{
+    CookieJar_Tst jar;
+
+    jar.addCookie(createCookie(QSL(".example.com"), QSL("/"), "name", "value"));
+    jar.addCookie(createCookie(QSL(".example.com"), QSL("/path"), "name", "value"));
+    jar.addCookie(createCookie(QSL(".example.com"), QSL("/"), "other", "value"));
+
+    // Cookie is identified by name and path, value doesn't matter
+    jar.removeCookie(createCookie(QSL(".example.com"), QSL("/path"), "name", "changed"));
+
+    QVector<QNetworkCookie> cookies = jar.getAllCookies();
+    QCOMPARE(cookies.count(), 2);
+    for (const QNetworkCookie &cookie : qAsConst(cookies)) {
+        QCOMPARE(cookie.path(), QSL("/"));
+    }
+
+    // Same name and path from other domain is not removed
+    jar.removeCookie(createCookie(QSL(".example.org"), QSL("/"), "name", "value"));
+    QCOMPARE(jar.getAllCookies().count(), 2);
+
+    jar.removeCookie(createCookie(QSL(".example.com"), QSL("/"), "name", "value"));
+    cookies = jar.getAllCookies();
+    QCOMPARE(cookies.count(), 1);
+    QCOMPARE(cookies.at(0).name(), QByteArray("other"));
+}
+
+void CookiesTest::allCookiesTest()
+{
+    CookieJar_Tst jar;
+    QVERIFY(jar.getAllCookies().isEmpty());
+
+    for (int i = 0; i < 10; ++i) {
+        jar.addCookie(createCookie(QSL(".domain%1.com").arg(i % 3), QSL("/"), "cookie" + QByteArray::number(i), "value"));
+    }
+    QCOMPARE(jar.getAllCookies().count(), 10);
+
+    for (int i = 0; i < 10; i += 2) {
+        jar.removeCookie(createCookie(QSL(".domain%1.com").arg(i % 3), QSL("/"), "cookie" + QByteArray::number(i), "value"));
+    }
+    QCOMPARE(jar.getAllCookies().count(), 5);
+}
+
 FALKONTEST_MAIN(CookiesTest)
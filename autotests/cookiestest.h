@@ -19,8 +19,11 @@
 #define COOKIESTEST_H
 
 #include <QObject>
+#include <QWebEngineProfile>
+#include <QWebEngineCookieStore>
 
 #include "cookiejar.h"
+#include "mainapplication.h"
 
 class CookieJar_Tst : public CookieJar
 {
@@ -39,6 +42,17 @@ public:
     {
         return CookieJar::listMatchesDomain(list, cookieDomain);
     }
+
+    // Emulate cookie store notifications, CookieJar only listens to its signals
+    void addCookie(const QNetworkCookie &cookie)
+    {
+        emit mApp->webProfile()->cookieStore()->cookieAdded(cookie);
+    }
+
+    void removeCookie(const QNetworkCookie &cookie)
+    {
+        emit mApp->webProfile()->cookieStore()->cookieRemoved(cookie);
+    }
 };
 
 class CookiesTest : public QObject
@@ -55,6 +69,10 @@ private Q_SLOTS:
     void listMatchesDomainTest_data();
     void listMatchesDomainTest();
 
+    void replaceCookieTest();
+    void removeCookieTest();
+    void allCookiesTest();
+
 private:
     CookieJar_Tst *m_cookieJar;
 };
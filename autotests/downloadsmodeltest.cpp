@@ -0,0 +1,66 @@
+/* ============================================================
+* Falkon - Qt web browser
+* Copyright (C) 2018 David Rosca <nowrep@gmail.com>
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program.  If not, see <http://www.gnu.org/licenses/>.
+* ============================================================ */
+#include "downloadsmodeltest.h"
+#include "autotests.h"
+#include "downloadsmodel.h"
+
+void DownloadsModelTest::initTestCase()
+{
+}
+
+void DownloadsModelTest::cleanupTestCase()
+{
+}
+
+void DownloadsModelTest::restoreUrlTest()
+{
+    const QUrl url(QSL("https://example.com/files/some%20file.zip?a=1&b=%C3%A9"));
+    qint64 id = 0;
+
+    {
+        DownloadsModel model;
+
+        DownloadsModel::Entry entry;
+        entry.url = url;
+        entry.path = QSL("/tmp/some file.zip");
+        entry.startDate = QDateTime::currentDateTime();
+        model.storeEntry(&entry);
+
+        id = entry.id;
+        QVERIFY(id > 0);
+    }
+
+    DownloadsModel model;
+    model.fetchMore(QModelIndex());
+
+    QModelIndex restored;
+    for (int i = 0; i < model.rowCount(); ++i) {
+        const QModelIndex index = model.index(i);
+        if (index.data(DownloadsModel::IdRole).toLongLong() == id) {
+            restored = index;
+            break;
+        }
+    }
+
+    QVERIFY(restored.isValid());
+    QCOMPARE(restored.data(DownloadsModel::UrlRole).toUrl(), url);
+    QCOMPARE(restored.data(DownloadsModel::PathRole).toString(), QSL("/tmp/some file.zip"));
+    QCOMPARE(restored.data(DownloadsModel::StateRole).toInt(), int(DownloadsModel::Interrupted));
+}
+
+FALKONTEST_MAIN(DownloadsModelTest)
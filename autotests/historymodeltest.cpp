@@ -0,0 +1,189 @@
+/* ============================================================
+* Falkon - Qt web browser
+* Copyright (C) 2018 David Rosca <nowrep@gmail.com>
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program.  If not, see <http://www.gnu.org/licenses/>.
+* ============================================================ */
+#include "historymodeltest.h"
+#include "autotests.h"
+#include "history.h"
+#include "historymodel.h"
+#include "historydeletejob.h"
+
+#include "modeltest.h"
+
+static HistoryEntry createEntry(int id, int secsAgo)
+{
+    HistoryEntry entry;
+    entry.id = id;
+    entry.count = 1;
+    entry.date = QDateTime::currentDateTime().addSecs(-secsAgo);
+    entry.url = QUrl(QSL("https://%1.example.com/").arg(id));
+    entry.urlString = entry.url.toEncoded();
+    entry.title = QSL("Entry %1").arg(id);
+    return entry;
+}
+
+static QVector<int> todayIds(HistoryModel *model)
+{
+    QVector<int> ids;
+    const QModelIndex today = model->index(0, 0);
+    for (int i = 0; i < model->rowCount(today); ++i) {
+        ids.append(model->index(i, 0, today).data(HistoryModel::IdRole).toInt());
+    }
+    return ids;
+}
+
+static int childInsertions(const QSignalSpy &spy)
+{
+    int count = 0;
+    for (const QList<QVariant> &args : spy) {
+        if (args.at(0).value<QModelIndex>().isValid()) {
+            ++count;
+        }
+    }
+    return count;
+}
+
+void HistoryModelTest::initTestCase()
+{
+    qRegisterMetaType<HistoryEntry>();
+
+    // Start with empty model
+    HistoryDeleteJob *job = mApp->history()->clearHistory();
+    QSignalSpy spy(job, &HistoryDeleteJob::finished);
+    QVERIFY(spy.wait());
+}
+
+void HistoryModelTest::cleanupTestCase()
+{
+}
+
+void HistoryModelTest::batchInsertTest()
+{
+    History *history = mApp->history();
+    HistoryModel model(history);
+    ModelTest modelTest(&model);
+
+    QSignalSpy rowsInsertedSpy(&model, &HistoryModel::rowsInserted);
+
+    emit history->historyEntryAdded(createEntry(1, 30));
+    emit history->historyEntryAdded(createEntry(2, 10));
+    emit history->historyEntryAdded(createEntry(3, 20));
+
+    // Nothing is applied until next event loop iteration
+    QCOMPARE(model.rowCount(), 0);
+    QCOMPARE(rowsInsertedSpy.count(), 0);
+
+    QTRY_COMPARE(model.rowCount(), 1);
+
+    // Today item and all its children are inserted at once
+    QCOMPARE(rowsInsertedSpy.count(), 2);
+    QCOMPARE(childInsertions(rowsInsertedSpy), 1);
+    QCOMPARE(rowsInsertedSpy.at(1).at(1).toInt(), 0);
+    QCOMPARE(rowsInsertedSpy.at(1).at(2).toInt(), 2);
+
+    // Newest first
+    QCOMPARE(todayIds(&model), QVector<int>({2, 3, 1}));
+
+    rowsInsertedSpy.clear();
+
+    emit history->historyEntryAdded(createEntry(4, 0));
+    emit history->historyEntryAdded(createEntry(5, 5));
+
+    QTRY_COMPARE(rowsInsertedSpy.count(), 1);
+    QCOMPARE(childInsertions(rowsInsertedSpy), 1);
+    QCOMPARE(todayIds(&model), QVector<int>({4, 5, 2, 3, 1}));
+}
+
+void HistoryModelTest::editDedupTest()
+{
+    History *history = mApp->history();
+    HistoryModel model(history);
+    ModelTest modelTest(&model);
+
+    const HistoryEntry entry1 = createEntry(1, 30);
+    const HistoryEntry entry2 = createEntry(2, 20);
+    const HistoryEntry entry3 = createEntry(3, 10);
+
+    emit history->historyEntryAdded(entry1);
+    emit history->historyEntryAdded(entry2);
+    emit history->historyEntryAdded(entry3);
+    QTRY_COMPARE(todayIds(&model), QVector<int>({3, 2, 1}));
+
+    QSignalSpy rowsInsertedSpy(&model, &HistoryModel::rowsInserted);
+
+    // Entry edited several times in one event loop turn
+    HistoryEntry edited1 = entry1;
+    edited1.date = QDateTime::currentDateTime();
+    edited1.count = 2;
+    HistoryEntry edited2 = edited1;
+    edited2.title = QSL("Edited");
+    edited2.count = 3;
+
+    emit history->historyEntryEdited(entry1, edited1);
+    emit history->historyEntryEdited(edited1, edited2);
+
+    QTRY_COMPARE(rowsInsertedSpy.count(), 1);
+    QCOMPARE(childInsertions(rowsInsertedSpy), 1);
+    QCOMPARE(rowsInsertedSpy.at(0).at(1).toInt(), 0);
+    QCOMPARE(rowsInsertedSpy.at(0).at(2).toInt(), 0);
+
+    // Only latest version is kept, moved to the top
+    QCOMPARE(todayIds(&model), QVector<int>({1, 3, 2}));
+    const QModelIndex index = model.index(0, 0, model.index(0, 0));
+    QCOMPARE(index.data(HistoryModel::TitleRole).toString(), QSL("Edited"));
+    QCOMPARE(model.index(0, 3, model.index(0, 0)).data().toInt(), 3);
+}
+
+void HistoryModelTest::rangeRemovalTest()
+{
+    History *history = mApp->history();
+    HistoryModel model(history);
+    ModelTest modelTest(&model);
+
+    QVector<HistoryEntry> entries;
+    for (int i = 1; i <= 6; ++i) {
+        entries.append(createEntry(i, 60 - i));
+        emit history->historyEntryAdded(entries.last());
+    }
+    QTRY_COMPARE(todayIds(&model), QVector<int>({6, 5, 4, 3, 2, 1}));
+
+    QSignalSpy rowsRemovedSpy(&model, &HistoryModel::rowsRemoved);
+
+    // Rows 1-2 and 4 are removed as two ranges, last one first
+    emit history->historyEntriesDeleted({entries.at(4), entries.at(3), entries.at(1), entries.at(4)});
+
+    QCOMPARE(rowsRemovedSpy.count(), 2);
+    QCOMPARE(rowsRemovedSpy.at(0).at(1).toInt(), 4);
+    QCOMPARE(rowsRemovedSpy.at(0).at(2).toInt(), 4);
+    QCOMPARE(rowsRemovedSpy.at(1).at(1).toInt(), 1);
+    QCOMPARE(rowsRemovedSpy.at(1).at(2).toInt(), 2);
+    QCOMPARE(todayIds(&model), QVector<int>({6, 3, 1}));
+
+    // Pending entry is applied before removal
+    const HistoryEntry entry7 = createEntry(7, 0);
+    emit history->historyEntryAdded(entry7);
+    emit history->historyEntriesDeleted({entry7});
+    QCOMPARE(todayIds(&model), QVector<int>({6, 3, 1}));
+
+    rowsRemovedSpy.clear();
+
+    // Empty Today item is removed too
+    emit history->historyEntriesDeleted({entries.at(0), entries.at(2), entries.at(5)});
+    QCOMPARE(rowsRemovedSpy.count(), 2);
+    QCOMPARE(model.rowCount(), 0);
+}
+
+FALKONTEST_MAIN(HistoryModelTest)
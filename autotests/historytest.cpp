@@ -0,0 +1,284 @@
+/* ============================================================
+* Falkon - Qt web browser
+* Copyright (C) 2018 David Rosca <nowrep@gmail.com>
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program.  If not, see <http://www.gnu.org/licenses/>.
+* ============================================================ */
+#include "historytest.h"
+#include "autotests.h"
+#include "history.h"
+#include "historydeletejob.h"
+#include "historymodel.h"
+#include "sqldatabase.h"
+
+#include <QThreadPool>
+
+static int addEntry(const QUrl &url, History::VisitTransition transition)
+{
+    History *history = mApp->history();
+    QSignalSpy addedSpy(history, &History::historyEntryAdded);
+    QSignalSpy editedSpy(history, &History::historyEntryEdited);
+
+    history->addHistoryEntry(url, QSL("Title"), transition);
+
+    // New url is added, known url is edited
+    for (int i = 0; i < 50 && addedSpy.isEmpty() && editedSpy.isEmpty(); ++i) {
+        QTest::qWait(100);
+    }
+    if (addedSpy.isEmpty() && editedSpy.isEmpty()) {
+        return -1;
+    }
+
+    if (!addedSpy.isEmpty()) {
+        return addedSpy.at(0).at(0).value<HistoryEntry>().id;
+    }
+    return editedSpy.at(0).at(1).value<HistoryEntry>().id;
+}
+
+static void writePendingVisits()
+{
+    QMetaObject::invokeMethod(mApp->history(), "writePendingVisits");
+    QThreadPool::globalInstance()->waitForDone();
+}
+
+static int rank(const QVector<HistoryEntry> &entries, int id)
+{
+    for (int i = 0; i < entries.size(); ++i) {
+        if (entries.at(i).id == id) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+static int frecency(int id)
+{
+    QSqlQuery query(SqlDatabase::instance()->database());
+    query.prepare(QSL("SELECT frecency FROM history WHERE id=?"));
+    query.addBindValue(id);
+    query.exec();
+    return query.next() ? query.value(0).toInt() : -1;
+}
+
+static int visitCount(int id)
+{
+    QSqlQuery query(SqlDatabase::instance()->database());
+    query.prepare(QSL("SELECT COUNT(*) FROM history_visits WHERE history_id=?"));
+    query.addBindValue(id);
+    query.exec();
+    return query.next() ? query.value(0).toInt() : -1;
+}
+
+static QList<int> insertEntries(const QString &host, int count)
+{
+    QList<int> ids;
+    QSqlDatabase db = SqlDatabase::instance()->database();
+    db.transaction();
+    QSqlQuery query(db);
+    query.prepare(QSL("INSERT INTO history (count, date, url, title) VALUES (1, ?, ?, ?)"));
+    for (int i = 0; i < count; ++i) {
+        query.addBindValue(QDateTime::currentMSecsSinceEpoch());
+        query.addBindValue(QSL("https://%1/%2").arg(host).arg(i));
+        query.addBindValue(QSL("Title %1").arg(i));
+        query.exec();
+        ids.append(query.lastInsertId().toInt());
+    }
+    db.commit();
+    return ids;
+}
+
+static int remainingEntries(const QString &host)
+{
+    QSqlQuery query(SqlDatabase::instance()->database());
+    query.prepare(QSL("SELECT COUNT(*) FROM history WHERE url LIKE ?"));
+    query.addBindValue(QSL("https://%1/%").arg(host));
+    query.exec();
+    return query.next() ? query.value(0).toInt() : -1;
+}
+
+void HistoryTest::initTestCase()
+{
+    qRegisterMetaType<HistoryEntry>();
+    qRegisterMetaType<QVector<HistoryEntry>>();
+
+    QVERIFY(mApp->history());
+    QVERIFY(History::hasFrecency());
+}
+
+void HistoryTest::cleanupTestCase()
+{
+}
+
+void HistoryTest::visitFrecencyTest()
+{
+    QVERIFY(History::visitFrecency(History::TypedTransition) > History::visitFrecency(History::LinkTransition));
+    QCOMPARE(History::visitFrecency(History::LinkTransition), History::visitFrecency(History::FormTransition));
+    QVERIFY(History::visitFrecency(History::LinkTransition) > History::visitFrecency(History::BackForwardTransition));
+    QVERIFY(History::visitFrecency(History::BackForwardTransition) > History::visitFrecency(History::ReloadTransition));
+    QCOMPARE(History::visitFrecency(History::ReloadTransition), 0);
+}
+
+void HistoryTest::recordVisitsTest()
+{
+    const QUrl url(QSL("https://visits.example.com/"));
+
+    const int id = addEntry(url, History::TypedTransition);
+    QVERIFY(id > 0);
+    QCOMPARE(frecency(id), History::visitFrecency(History::TypedTransition));
+
+    QCOMPARE(addEntry(url, History::LinkTransition), id);
+    QCOMPARE(frecency(id), History::visitFrecency(History::TypedTransition) + History::visitFrecency(History::LinkTransition));
+
+    writePendingVisits();
+    QCOMPARE(visitCount(id), 2);
+
+    QSqlQuery query(SqlDatabase::instance()->database());
+    query.prepare(QSL("SELECT transition FROM history_visits WHERE history_id=? ORDER BY id"));
+    query.addBindValue(id);
+    query.exec();
+    QVERIFY(query.next());
+    QCOMPARE(query.value(0).toInt(), int(History::TypedTransition));
+    QVERIFY(query.next());
+    QCOMPARE(query.value(0).toInt(), int(History::LinkTransition));
+}
+
+void HistoryTest::frecencyRankingTest()
+{
+    const int reloaded = addEntry(QUrl(QSL("https://reloaded.example.com/")), History::LinkTransition);
+    QCOMPARE(addEntry(QUrl(QSL("https://reloaded.example.com/")), History::ReloadTransition), reloaded);
+    QCOMPARE(addEntry(QUrl(QSL("https://reloaded.example.com/")), History::ReloadTransition), reloaded);
+    const int typed = addEntry(QUrl(QSL("https://typed.example.com/")), History::TypedTransition);
+    const int linked = addEntry(QUrl(QSL("https://linked.example.com/")), History::BackForwardTransition);
+
+    QVERIFY(reloaded > 0 && typed > 0 && linked > 0);
+
+    // Typed visit ranks above more frequently reloaded page
+    const QVector<HistoryEntry> entries = mApp->history()->mostVisited(100);
+    QVERIFY(rank(entries, typed) >= 0);
+    QVERIFY(rank(entries, typed) < rank(entries, reloaded));
+    QVERIFY(rank(entries, reloaded) < rank(entries, linked));
+}
+
+void HistoryTest::deletedEntryVisitsTest()
+{
+    const int id = addEntry(QUrl(QSL("https://deleted.example.com/")), History::LinkTransition);
+    QVERIFY(id > 0);
+
+    // Visit is still waiting to be written
+    HistoryDeleteJob *job = mApp->history()->deleteHistoryEntry(id);
+    QSignalSpy spy(job, &HistoryDeleteJob::finished);
+    QVERIFY(spy.wait());
+
+    writePendingVisits();
+    QCOMPARE(frecency(id), -1);
+    QCOMPARE(visitCount(id), 0);
+}
+
+void HistoryTest::deleteJobChunksTest()
+{
+    const QString host = QSL("chunks.example.com");
+    const QList<int> ids = insertEntries(host, 1200);
+    QCOMPARE(remainingEntries(host), 1200);
+
+    QSignalSpy deletedSpy(mApp->history(), &History::historyEntriesDeleted);
+
+    HistoryDeleteJob *job = mApp->history()->deleteHistoryEntry(ids);
+    QCOMPARE(job->total(), 1200);
+    QSignalSpy progressSpy(job, &HistoryDeleteJob::progress);
+    QSignalSpy finishedSpy(job, &HistoryDeleteJob::finished);
+    QVERIFY(finishedSpy.wait());
+
+    // One transaction per 500 entries
+    QCOMPARE(progressSpy.count(), 3);
+    QCOMPARE(progressSpy.at(0).at(0).toInt(), 500);
+    QCOMPARE(progressSpy.at(1).at(0).toInt(), 1000);
+    QCOMPARE(progressSpy.at(2).at(0).toInt(), 1200);
+    for (const QList<QVariant> &args : qAsConst(progressSpy)) {
+        QCOMPARE(args.at(1).toInt(), 1200);
+    }
+
+    QCOMPARE(deletedSpy.count(), 3);
+    int deleted = 0;
+    for (const QList<QVariant> &args : qAsConst(deletedSpy)) {
+        deleted += args.at(0).value<QVector<HistoryEntry>>().size();
+    }
+    QCOMPARE(deleted, 1200);
+    QCOMPARE(remainingEntries(host), 0);
+}
+
+void HistoryTest::deleteJobCancelTest()
+{
+    const QString host = QSL("cancel.example.com");
+    const QList<int> ids = insertEntries(host, 1200);
+
+    HistoryDeleteJob *job = new HistoryDeleteJob(ids);
+
+    // Cancel on worker thread right after the first chunk is committed
+    connect(job, &HistoryDeleteJob::chunkDeleted, job, [job]() {
+        job->cancel();
+    }, Qt::DirectConnection);
+
+    QSignalSpy progressSpy(job, &HistoryDeleteJob::progress);
+    QSignalSpy finishedSpy(job, &HistoryDeleteJob::finished);
+    job->start();
+    QVERIFY(finishedSpy.wait());
+
+    QCOMPARE(progressSpy.count(), 1);
+    QCOMPARE(progressSpy.at(0).at(0).toInt(), 500);
+    QCOMPARE(progressSpy.at(0).at(1).toInt(), 1200);
+
+    // First chunk stays deleted
+    QCOMPARE(remainingEntries(host), 700);
+
+    QSqlQuery query(SqlDatabase::instance()->database());
+    query.prepare(QSL("SELECT MIN(id) FROM history WHERE url LIKE ?"));
+    query.addBindValue(QSL("https://%1/%").arg(host));
+    query.exec();
+    QVERIFY(query.next());
+    QCOMPARE(query.value(0).toInt(), ids.at(500));
+}
+
+void HistoryTest::deleteJobModelTest()
+{
+    History *history = mApp->history();
+    HistoryModel model(history);
+
+    QList<int> ids;
+    for (int i = 0; i < 5; ++i) {
+        ids.append(addEntry(QUrl(QSL("https://range%1.example.com/").arg(i)), History::LinkTransition));
+        QVERIFY(ids.last() > 0);
+        QTRY_COMPARE(model.index(0, 0, model.index(0, 0)).data(HistoryModel::IdRole).toInt(), ids.last());
+    }
+
+    const QModelIndex today = model.index(0, 0);
+    const int rowCount = model.rowCount(today);
+
+    QSignalSpy rowsRemovedSpy(&model, &HistoryModel::rowsRemoved);
+
+    // Newest first, entries 1-3 are in rows 1-3
+    HistoryDeleteJob *job = history->deleteHistoryEntry({ids.at(3), ids.at(1), ids.at(2)});
+    QSignalSpy finishedSpy(job, &HistoryDeleteJob::finished);
+    QVERIFY(finishedSpy.wait());
+
+    QCOMPARE(rowsRemovedSpy.count(), 1);
+    QCOMPARE(rowsRemovedSpy.at(0).at(0).value<QModelIndex>(), today);
+    QCOMPARE(rowsRemovedSpy.at(0).at(1).toInt(), 1);
+    QCOMPARE(rowsRemovedSpy.at(0).at(2).toInt(), 3);
+
+    QCOMPARE(model.rowCount(today), rowCount - 3);
+    QCOMPARE(model.index(0, 0, today).data(HistoryModel::IdRole).toInt(), ids.at(4));
+    QCOMPARE(model.index(1, 0, today).data(HistoryModel::IdRole).toInt(), ids.at(0));
+}
+
+FALKONTEST_MAIN(HistoryTest)
@@ -0,0 +1,75 @@
+/* ============================================================
+* Falkon - Qt web browser
+* Copyright (C) 2018 David Rosca <nowrep@gmail.com>
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program.  If not, see <http://www.gnu.org/licenses/>.
+* ============================================================ */
+#include "htmlimportertest.h"
+#include "autotests.h"
+#include "bookmarkitem.h"
+#include "bookmarksimport/htmlimporter.h"
+
+void HtmlImporterTest::importTest()
+{
+    HtmlImporter importer;
+    importer.setPath(QSL(":autotests/data/bookmarks.html"));
+    QVERIFY(importer.prepareImport());
+
+    QScopedPointer<BookmarkItem> root(importer.importBookmarks());
+    QVERIFY(!root.isNull());
+    QVERIFY(!importer.error());
+    QVERIFY(root->isFolder());
+    QCOMPARE(root->title(), QSL("HTML Import"));
+
+    // place: links are skipped, empty folders are kept
+    const QList<BookmarkItem*> top = root->children();
+    QCOMPARE(top.count(), 3);
+    QVERIFY(top.at(0)->isFolder());
+    QCOMPARE(top.at(0)->title(), QSL("Toolbar"));
+    QVERIFY(top.at(1)->isFolder());
+    QCOMPARE(top.at(1)->title(), QSL("Empty"));
+    QCOMPARE(top.at(1)->children().count(), 0);
+    QVERIFY(top.at(2)->isUrl());
+    QCOMPARE(top.at(2)->title(), QSL("Top"));
+    QCOMPARE(top.at(2)->url(), QUrl(QSL("https://top.org/")));
+
+    // Mixed-case tags, single quoted href and trimmed title
+    const QList<BookmarkItem*> toolbar = top.at(0)->children();
+    QCOMPARE(toolbar.count(), 4);
+    QVERIFY(toolbar.at(0)->isUrl());
+    QCOMPARE(toolbar.at(0)->title(), QSL("KDE"));
+    QCOMPARE(toolbar.at(0)->url(), QUrl(QSL("https://kde.org/")));
+    QVERIFY(toolbar.at(1)->isUrl());
+    QCOMPARE(toolbar.at(1)->title(), QSL("Falkon"));
+    QCOMPARE(toolbar.at(1)->url(), QUrl(QSL("https://falkon.org/")));
+    QVERIFY(toolbar.at(2)->isFolder());
+    QCOMPARE(toolbar.at(2)->title(), QSL("Nested"));
+
+    // href must not be matched inside another attribute name
+    QVERIFY(toolbar.at(3)->isUrl());
+    QCOMPARE(toolbar.at(3)->title(), QSL("Right"));
+    QCOMPARE(toolbar.at(3)->url(), QUrl(QSL("https://right.org/")));
+
+    // Mixed-case attributes, unquoted href and link without title
+    const QList<BookmarkItem*> nested = toolbar.at(2)->children();
+    QCOMPARE(nested.count(), 2);
+    QVERIFY(nested.at(0)->isUrl());
+    QCOMPARE(nested.at(0)->title(), QSL("Example"));
+    QCOMPARE(nested.at(0)->url(), QUrl(QSL("https://example.com/?a=1&b=2")));
+    QVERIFY(nested.at(1)->isUrl());
+    QCOMPARE(nested.at(1)->title(), QSL("https://unquoted.org/"));
+    QCOMPARE(nested.at(1)->url(), QUrl(QSL("https://unquoted.org/")));
+}
+
+FALKONTEST_MAIN(HtmlImporterTest)
@@ -0,0 +1,204 @@
+/* ============================================================
+* Falkon - Qt web browser
+* Copyright (C) 2018 David Rosca <nowrep@gmail.com>
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program.  If not, see <http://www.gnu.org/licenses/>.
+* ============================================================ */
+#include "qmlstaticdatatest.h"
+#include "autotests.h"
+#include "webtab.h"
+#include "qml/qmlplugins.h"
+#include "qml/qmlstaticdata.h"
+#include "qml/api/history/qmlhistoryitem.h"
+
+#include "sqldatabase.h"
+#include "history.h"
+
+#include <QPointer>
+#include <QQmlEngine>
+#include <QQmlComponent>
+
+static void processDeferredDeletes()
+{
+    QCoreApplication::sendPostedEvents(nullptr, QEvent::DeferredDelete);
+}
+
+static HistoryEntry createEntry(int id)
+{
+    HistoryEntry entry;
+    entry.id = id;
+    entry.count = 1;
+    entry.date = QDateTime(QDate(2018, 1, 1));
+    entry.url = QUrl(QSL("https://example.com/%1").arg(id));
+    entry.urlString = entry.url.toString();
+    entry.title = QSL("Page %1").arg(id);
+    return entry;
+}
+
+static int aliveCount(const QVector<QPointer<QObject>> &objects)
+{
+    int count = 0;
+    for (const QPointer<QObject> &object : objects) {
+        if (object) {
+            ++count;
+        }
+    }
+    return count;
+}
+
+static void collectGarbage(QQmlEngine *engine)
+{
+    engine->collectGarbage();
+    processDeferredDeletes();
+}
+
+// Keeps wrappers received from History singleton until released
+static QObject *createHistoryClient(QQmlEngine *engine)
+{
+    QQmlComponent component(engine);
+    component.setData(QByteArrayLiteral(
+        "import QtQml 2.0\n"
+        "import org.kde.falkon 1.0\n"
+        "QtObject {\n"
+        "    property var items: []\n"
+        "    property var lastVisited: null\n"
+        "    function search(text) { items = History.search(text); return items.length; }\n"
+        "    function item(i) { return items[i]; }\n"
+        "    function visitedItem() { return lastVisited; }\n"
+        "    function release() { items = []; lastVisited = null; }\n"
+        "    Component.onCompleted: History.visited.connect(function(item) { lastVisited = item; })\n"
+        "}\n"), QUrl());
+
+    QObject *client = component.create();
+    if (!client) {
+        qWarning() << component.errorString();
+    }
+    return client;
+}
+
+static QObject *callObject(QObject *client, const char *method)
+{
+    QVariant result;
+    QMetaObject::invokeMethod(client, method, Q_RETURN_ARG(QVariant, result));
+    return result.value<QObject*>();
+}
+
+void QmlStaticDataTest::initTestCase()
+{
+    QmlPlugins::registerQmlTypes();
+
+    QSqlDatabase db = SqlDatabase::instance()->database();
+    db.transaction();
+    QSqlQuery query(db);
+    query.prepare(QSL("INSERT INTO history (count, date, url, title) VALUES (1, ?, ?, ?)"));
+    for (int i = 0; i < 1000; ++i) {
+        query.addBindValue(QDateTime::currentMSecsSinceEpoch());
+        query.addBindValue(QSL("https://released.example.com/%1").arg(i));
+        query.addBindValue(QSL("Released %1").arg(i));
+        query.exec();
+    }
+    db.commit();
+}
+
+void QmlStaticDataTest::cleanupTestCase()
+{
+}
+
+void QmlStaticDataTest::historyItemNotCachedTest()
+{
+    const HistoryEntry entry = createEntry(-1);
+
+    QScopedPointer<QmlHistoryItem> item(QmlStaticData::instance().getHistoryItem(entry));
+    QScopedPointer<QmlHistoryItem> item2(QmlStaticData::instance().getHistoryItem(entry));
+    QVERIFY(item);
+    QVERIFY(item2);
+    QVERIFY(item.data() != item2.data());
+    QCOMPARE(QQmlEngine::objectOwnership(item.data()), QQmlEngine::JavaScriptOwnership);
+}
+
+void QmlStaticDataTest::historyItemReleasedTest()
+{
+    QQmlEngine engine;
+    QScopedPointer<QObject> client(createHistoryClient(&engine));
+    QVERIFY(client);
+
+    // Sustained activity, wrappers from previous calls are collected
+    for (int round = 0; round < 3; ++round) {
+        QVariant count;
+        QMetaObject::invokeMethod(client.data(), "search", Q_RETURN_ARG(QVariant, count), Q_ARG(QVariant, QSL("released.example.com")));
+        QCOMPARE(count.toInt(), 1000);
+
+        QVector<QPointer<QObject>> items;
+        for (int i = 0; i < count.toInt(); ++i) {
+            QVariant item;
+            QMetaObject::invokeMethod(client.data(), "item", Q_RETURN_ARG(QVariant, item), Q_ARG(QVariant, i));
+            items.append(item.value<QObject*>());
+        }
+
+        QCOMPARE(aliveCount(items), 1000);
+
+        QMetaObject::invokeMethod(client.data(), "release");
+        collectGarbage(&engine);
+
+        QCOMPARE(aliveCount(items), 0);
+    }
+}
+
+void QmlStaticDataTest::historyItemEnginesTest()
+{
+    QQmlEngine engine1;
+    QQmlEngine engine2;
+    QScopedPointer<QObject> client1(createHistoryClient(&engine1));
+    QScopedPointer<QObject> client2(createHistoryClient(&engine2));
+    QVERIFY(client1);
+    QVERIFY(client2);
+
+    const HistoryEntry entry = createEntry(-2);
+    emit mApp->history()->historyEntryAdded(entry);
+
+    // Each engine receives its own wrapper
+    QPointer<QObject> item1 = callObject(client1.data(), "visitedItem");
+    QPointer<QObject> item2 = callObject(client2.data(), "visitedItem");
+    QVERIFY(item1);
+    QVERIFY(item2);
+    QVERIFY(item1 != item2);
+
+    // Collecting wrapper in one engine doesn't affect the other one
+    QMetaObject::invokeMethod(client1.data(), "release");
+    collectGarbage(&engine1);
+    collectGarbage(&engine2);
+
+    QVERIFY(!item1);
+    QVERIFY(item2);
+    QCOMPARE(item2->property("title").toString(), entry.title);
+
+    QMetaObject::invokeMethod(client2.data(), "release");
+    collectGarbage(&engine2);
+    QVERIFY(!item2);
+}
+
+void QmlStaticDataTest::tabWrapperLifetimeTest()
+{
+    WebTab *webTab = new WebTab;
+
+    QPointer<QObject> tab = QmlStaticData::instance().getTab(webTab);
+    QVERIFY(tab);
+    QCOMPARE(QmlStaticData::instance().getTab(webTab), tab.data());
+
+    delete webTab;
+    processDeferredDeletes();
+    QVERIFY(!tab);
+}
+
+FALKONTEST_MAIN(QmlStaticDataTest)
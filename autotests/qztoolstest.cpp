@@ -17,6 +17,7 @@
 * ============================================================ */
 #include "qztoolstest.h"
 #include "qztools.h"
+#include "htmltemplate.h"
 
 #include <QDir>
 #include <QtTest/QtTest>
@@ -181,6 +182,37 @@ public:
     }
 };
 
+void QzToolsTest::htmlTemplateRender_data()
+{
+    QTest::addColumn<QString>("input");
+    QTest::addColumn<QString>("result");
+
+    QTest::newRow("Empty") << "" << "";
+    QTest::newRow("NoPlaceholder") << "<p>text</p>" << "<p>text</p>";
+    QTest::newRow("Simple") << "<title>%TITLE%</title>" << "<title>Falkon</title>";
+    QTest::newRow("Adjacent") << "%TITLE%%TITLE-EDIT%" << "FalkonEdit";
+    QTest::newRow("OnlyPlaceholder") << "%TITLE%" << "Falkon";
+    QTest::newRow("Unknown") << "a %UNKNOWN% b" << "a %UNKNOWN% b";
+    QTest::newRow("Direction") << "dir=\"%DIRECTION%\" %LEFT_STR%-%RIGHT_STR%" << "dir=\"ltr\" left-right";
+    QTest::newRow("CssPercent") << "width: 100%; %TITLE% 50%" << "width: 100%; Falkon 50%";
+    QTest::newRow("Lowercase") << "%title% %TITLE%" << "%title% Falkon";
+    QTest::newRow("Unterminated") << "a %TITLE" << "a %TITLE";
+    QTest::newRow("ValueNotExpanded") << "%RULE%" << "%TITLE%";
+}
+
+void QzToolsTest::htmlTemplateRender()
+{
+    QFETCH(QString, input);
+    QFETCH(QString, result);
+
+    HtmlTemplate::Values values;
+    values[QSL("TITLE")] = QSL("Falkon");
+    values[QSL("TITLE-EDIT")] = QSL("Edit");
+    values[QSL("RULE")] = QSL("%TITLE%");
+
+    QCOMPARE(HtmlTemplate(input).render(values), result);
+}
+
 void QzToolsTest::ensureUniqueFilename()
 {
     QCOMPARE(QzTools::ensureUniqueFilename(createPath("test.out")), createPath("test.out"));
@@ -40,6 +40,9 @@ private Q_SLOTS:
     void escapeSqlGlobString_data();
     void escapeSqlGlobString();
 
+    void htmlTemplateRender_data();
+    void htmlTemplateRender();
+
     void ensureUniqueFilename();
     void copyRecursivelyTest();
     void removeRecursivelyTest();
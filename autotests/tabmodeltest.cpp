@@ -118,6 +118,38 @@ void TabModelTest::dataTest()
 
     delete w;
 }
+
+void TabModelTest::dataChangedTest()
+{
+    BrowserWindow *w = mApp->createWindow(Qz::BW_NewWindow);
+    TabModel model(w);
+    ModelTest modelTest(&model);
+
+    w->tabWidget()->addView(QUrl());
+    w->tabWidget()->addView(QUrl());
+
+    QTRY_COMPARE(model.rowCount(), 3);
+    QTest::qWait(0);
+
+    QSignalSpy dataChangedSpy(&model, &TabModel::dataChanged);
+
+    w->tabWidget()->setCurrentIndex(0);
+    w->tabWidget()->setCurrentIndex(2);
+
+    // Changes are coalesced and emitted in next event loop iteration
+    QCOMPARE(dataChangedSpy.count(), 0);
+    QTRY_VERIFY(dataChangedSpy.count() > 0);
+
+    QCOMPARE(dataChangedSpy.at(0).at(0).value<QModelIndex>(), model.index(0, 0));
+    QCOMPARE(dataChangedSpy.at(0).at(1).value<QModelIndex>(), model.index(2, 0));
+    QVERIFY(dataChangedSpy.at(0).at(2).value<QVector<int>>().contains(TabModel::CurrentTabRole));
+
+    QCOMPARE(model.index(0, 0).data(TabModel::CurrentTabRole).toBool(), false);
+    QCOMPARE(model.index(2, 0).data(TabModel::CurrentTabRole).toBool(), true);
+
+    delete w;
+}
+
 void TabModelTest::pinTabTest()
 {
     BrowserWindow *w = mApp->createWindow(Qz::BW_NewWindow);
@@ -29,6 +29,7 @@ private Q_SLOTS:
 
     void basicTest();
     void dataTest();
+    void dataChangedTest();
     void pinTabTest();
     void treeModelTest();
     void resetTreeModelTest();
@@ -18,7 +18,7 @@
 
 #include "adblockurlinterceptor.h"
 #include "adblockrule.h"
-#include "qztools.h"
+#include "htmltemplate.h"
 
 #include <QUrlQuery>
 
@@ -37,13 +37,12 @@ void AdBlockUrlInterceptor::interceptRequest(QWebEngineUrlRequestInfo &request)
     }
 
     if (request.resourceType() == QWebEngineUrlRequestInfo::ResourceTypeMainFrame) {
-        QString page;
-        page.append(QzTools::readAllFileContents(QSL(":adblock/data/adblock.html")));
-        page.replace(QSL("%FAVICON%"), QSL("qrc:adblock/data/adblock_big.png"));
-        page.replace(QSL("%IMAGE%"), QSL("qrc:adblock/data/adblock_big.png"));
-        page.replace(QSL("%TITLE%"), tr("Blocked content"));
-        page.replace(QSL("%RULE%"), tr("Blocked by <i>%1 (%2)</i>").arg(ruleFilter, ruleSubscription));
-        page = QzTools::applyDirectionToPage(page);
+        HtmlTemplate::Values values;
+        values[QSL("FAVICON")] = QSL("qrc:adblock/data/adblock_big.png");
+        values[QSL("IMAGE")] = QSL("qrc:adblock/data/adblock_big.png");
+        values[QSL("TITLE")] = tr("Blocked content");
+        values[QSL("RULE")] = tr("Blocked by <i>%1 (%2)</i>").arg(ruleFilter, ruleSubscription);
+        const QString page = HtmlTemplate::fromFile(QSL(":adblock/data/adblock.html")).render(values);
         request.redirect(QUrl(QString::fromUtf8(QByteArray("data:text/html;base64,") + page.toUtf8().toBase64())));
     } else {
         request.block(true);
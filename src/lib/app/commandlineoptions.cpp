@@ -79,6 +79,10 @@ void CommandLineOptions::parseActions()
     wmclassOption.setValueName(QSL("WM_CLASS"));
     wmclassOption.setDescription(QSL("Application class (X11 only)."));
 
+    QCommandLineOption traceStartupOption(QStringList({QSL("trace-startup")}));
+    traceStartupOption.setValueName(QSL("file"));
+    traceStartupOption.setDescription(QSL("Writes startup trace in Chrome trace format to file."));
+
     // Parser
     QCommandLineParser parser;
     parser.setApplicationDescription(QSL("QtWebEngine based browser"));
@@ -97,6 +101,7 @@ void CommandLineOptions::parseActions()
     parser.addOption(openWindowOption);
     parser.addOption(fullscreenOption);
     parser.addOption(wmclassOption);
+    parser.addOption(traceStartupOption);
     parser.addPositionalArgument(QSL("URL"), QSL("URLs to open"), QSL("[URL...]"));
 
     // parse() and not process() so we can pass arbitrary options to Chromium
@@ -198,6 +203,13 @@ void CommandLineOptions::parseActions()
         m_actions.append(pair);
     }
 
+    if (parser.isSet(traceStartupOption)) {
+        ActionPair pair;
+        pair.action = Qz::CL_TraceStartup;
+        pair.text = parser.value(traceStartupOption);
+        m_actions.append(pair);
+    }
+
     if (parser.positionalArguments().isEmpty())
         return;
 
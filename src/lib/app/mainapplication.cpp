@@ -17,6 +17,7 @@
 * ============================================================ */
 #include "mainapplication.h"
 #include "history.h"
+#include "historydeletejob.h"
 #include "qztools.h"
 #include "updater.h"
 #include "autofill.h"
@@ -47,6 +48,7 @@
 #include "sessionmanager.h"
 #include "closedwindowsmanager.h"
 #include "protocolhandlermanager.h"
+#include "startupprofiler.h"
 #include "../config.h"
 
 #include <QWebEngineSettings>
@@ -205,6 +207,9 @@ MainApplication::MainApplication(int &argc, char** argv)
             case Qz::CL_WMClass:
                 m_wmClass = pair.text.toUtf8();
                 break;
+            case Qz::CL_TraceStartup:
+                StartupProfiler::start(pair.text);
+                break;
             default:
                 break;
             }
@@ -275,20 +280,33 @@ MainApplication::MainApplication(int &argc, char** argv)
     QDesktopServices::setUrlHandler(QSL("https"), this, "addNewTab");
     QDesktopServices::setUrlHandler(QSL("ftp"), this, "addNewTab");
 
-    ProfileManager profileManager;
-    profileManager.initConfigDir();
-    profileManager.initCurrentProfile(startProfile);
+    {
+        StartupProfiler::Phase phase(QSL("Profile"));
+        ProfileManager profileManager;
+        profileManager.initConfigDir();
+        profileManager.initCurrentProfile(startProfile);
 
-    Settings::createSettings(DataPaths::currentProfilePath() + QLatin1String("/settings.ini"));
+        Settings::createSettings(DataPaths::currentProfilePath() + QLatin1String("/settings.ini"));
+    }
 
-    m_webProfile = isPrivate() ? new QWebEngineProfile(this) : QWebEngineProfile::defaultProfile();
-    connect(m_webProfile, &QWebEngineProfile::downloadRequested, this, &MainApplication::downloadRequested);
+    {
+        StartupProfiler::Phase phase(QSL("WebEngineProfile"));
+        m_webProfile = isPrivate() ? new QWebEngineProfile(this) : QWebEngineProfile::defaultProfile();
+        connect(m_webProfile, &QWebEngineProfile::downloadRequested, this, &MainApplication::downloadRequested);
+    }
 
-    m_networkManager = new NetworkManager(this);
+    {
+        StartupProfiler::Phase phase(QSL("NetworkManager"));
+        m_networkManager = new NetworkManager(this);
+    }
 
-    setupUserScripts();
+    {
+        StartupProfiler::Phase phase(QSL("UserScripts"));
+        setupUserScripts();
+    }
 
     if (!isPrivate() && !isTestModeEnabled()) {
+        StartupProfiler::Phase phase(QSL("SessionManager"));
         m_sessionManager = new SessionManager(this);
         m_autoSaver = new AutoSaver(this);
         connect(m_autoSaver, &AutoSaver::save, m_sessionManager, &SessionManager::autoSaveLastSession);
@@ -315,17 +333,34 @@ MainApplication::MainApplication(int &argc, char** argv)
             m_restoreManager = new RestoreManager(sessionManager()->askSessionFromUser());
     }
 
-    loadSettings();
+    {
+        StartupProfiler::Phase phase(QSL("LoadSettings"));
+        loadSettings();
+    }
+
+    {
+        StartupProfiler::Phase phase(QSL("ProtocolHandlers"));
+        mApp->protocolHandlerManager();
+    }
 
+    // Plugins stay on critical path, they add UI (sidebars, tab bars) to first window
+    // and AdBlock needs to be ready before first page starts loading
     m_plugins = new PluginProxy(this);
-    m_autoFill = new AutoFill(this);
-    mApp->protocolHandlerManager();
 
-    if (!noAddons)
+    if (!noAddons) {
+        StartupProfiler::Phase phase(QSL("Plugins"));
         m_plugins->loadPlugins();
+    }
 
-    BrowserWindow* window = createWindow(Qz::BW_FirstAppWindow, startUrl);
-    connect(window, SIGNAL(startingCompleted()), this, SLOT(restoreOverrideCursor()));
+    BrowserWindow* window = nullptr;
+    {
+        StartupProfiler::Phase phase(QSL("FirstWindow"));
+        window = createWindow(Qz::BW_FirstAppWindow, startUrl);
+        connect(window, SIGNAL(startingCompleted()), this, SLOT(restoreOverrideCursor()));
+        connect(window, &BrowserWindow::startingCompleted, this, []() {
+            StartupProfiler::mark(QSL("FirstWindowCompleted"));
+        });
+    }
 
     connect(this, &QApplication::focusChanged, this, &MainApplication::onFocusChanged);
 
@@ -349,6 +384,7 @@ MainApplication::MainApplication(int &argc, char** argv)
         }
 
         if (!m_isStartingAfterCrash && m_restoreManager) {
+            StartupProfiler::Phase phase(QSL("RestoreSession"));
             restoreSession(window, m_restoreManager->restoreData());
         }
     }
@@ -375,6 +411,8 @@ MainApplication::~MainApplication()
     m_bookmarks = nullptr;
     delete m_cookieJar;
     m_cookieJar = nullptr;
+    delete m_history;
+    m_history = nullptr;
 
     Settings::syncSettings();
 }
@@ -529,6 +567,9 @@ Bookmarks* MainApplication::bookmarks()
 
 AutoFill* MainApplication::autoFill()
 {
+    if (!m_autoFill) {
+        m_autoFill = new AutoFill(this);
+    }
     return m_autoFill;
 }
 
@@ -748,6 +789,9 @@ void MainApplication::postLaunch()
     createJumpList();
     initPulseSupport();
 
+    StartupProfiler::mark(QSL("PostLaunch"));
+    QTimer::singleShot(0, this, &MainApplication::runDeferredInitStep);
+
     QTimer::singleShot(5000, this, &MainApplication::runDeferredPostLaunchActions);
 }
 
@@ -770,6 +814,7 @@ QByteArray MainApplication::saveState() const
     QDataStream stream(&data, QIODevice::WriteOnly);
 
     stream << Qz::sessionVersion;
+    stream << SessionHeader(restoreData);
     stream << restoreData;
 
     return data;
@@ -800,7 +845,8 @@ void MainApplication::saveSettings()
     settings.endGroup();
 
     if (deleteHistory) {
-        m_history->clearHistory();
+        m_history->clearHistory()->waitForFinished();
+        downloadManager()->clearHistory();
     }
     if (deleteHtml5Storage) {
         ClearPrivateData::clearLocalStorage();
@@ -812,7 +858,9 @@ void MainApplication::saveSettings()
         QzTools::removeRecursively(mApp->webProfile()->cachePath());
     }
 
-    m_searchEnginesManager->saveSettings();
+    if (m_searchEnginesManager) {
+        m_searchEnginesManager->saveSettings();
+    }
     m_plugins->shutdown();
     m_networkManager->shutdown();
 
@@ -901,6 +949,51 @@ void MainApplication::onFocusChanged()
     }
 }
 
+bool MainApplication::isDeferredInitFinished() const
+{
+    return m_isDeferredInitFinished;
+}
+
+void MainApplication::runDeferredInitStep()
+{
+    if (m_isClosing) {
+        return;
+    }
+
+    // Subsystems not needed to show first window are initialized one per
+    // event loop iteration, so the window can paint and handle input in between
+    switch (m_deferredInitStep++) {
+    case 0: {
+        StartupProfiler::Phase phase(QSL("AutoFill"));
+        autoFill();
+        break;
+    }
+    case 1: {
+        StartupProfiler::Phase phase(QSL("SearchEngines"));
+        // Engines are loaded from database on first access
+        searchEnginesManager()->allEngines();
+        break;
+    }
+    case 2: {
+        StartupProfiler::Phase phase(QSL("HistoryModel"));
+        history()->model();
+        break;
+    }
+    case 3: {
+        StartupProfiler::Phase phase(QSL("IconDatabase"));
+        IconProvider::instance();
+        break;
+    }
+    default:
+        m_isDeferredInitFinished = true;
+        emit deferredInitFinished();
+        StartupProfiler::finish();
+        return;
+    }
+
+    QTimer::singleShot(0, this, &MainApplication::runDeferredInitStep);
+}
+
 void MainApplication::runDeferredPostLaunchActions()
 {
     checkDefaultWebBrowser();
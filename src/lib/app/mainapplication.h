@@ -75,6 +75,10 @@ public:
     bool isPortable() const;
     bool isStartingAfterCrash() const;
 
+    // AutoFill, search engines, history model and icon database are initialized
+    // after first window is shown. Getters still create them on demand.
+    bool isDeferredInitFinished() const;
+
     int windowCount() const;
     QList<BrowserWindow*> windows() const;
 
@@ -135,6 +139,7 @@ public Q_SLOTS:
 Q_SIGNALS:
     void settingsReloaded();
     void activeWindowChanged(BrowserWindow* window);
+    void deferredInitFinished();
 
 private Q_SLOTS:
     void postLaunch();
@@ -144,6 +149,7 @@ private Q_SLOTS:
     void messageReceived(const QString &message);
     void windowDestroyed(QObject* window);
     void onFocusChanged();
+    void runDeferredInitStep();
     void runDeferredPostLaunchActions();
 
     void downloadRequested(QWebEngineDownloadItem *download);
@@ -168,6 +174,8 @@ private:
     bool m_isPortable;
     bool m_isClosing;
     bool m_isStartingAfterCrash;
+    bool m_isDeferredInitFinished = false;
+    int m_deferredInitStep = 0;
 
     History* m_history;
     Bookmarks* m_bookmarks;
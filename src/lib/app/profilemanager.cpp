@@ -23,6 +23,7 @@
 #include "sqldatabase.h"
 
 #include <QDir>
+#include <QDateTime>
 #include <QSqlError>
 #include <QSqlQuery>
 #include <QSqlDatabase>
@@ -90,6 +91,7 @@ void ProfileManager::initCurrentProfile(const QString &profileName)
 
     updateCurrentProfile();
     connectDatabase();
+    updateDatabase();
 }
 
 int ProfileManager::createProfile(const QString &profileName)
@@ -170,7 +172,8 @@ void ProfileManager::updateCurrentProfile()
         QString profileVersion = versionFile.readAll();
         versionFile.close();
 
-        updateProfile(Qz::VERSION, profileVersion.trimmed());
+        m_profileVersion = profileVersion.trimmed();
+        updateProfile(Qz::VERSION, m_profileVersion);
     }
     else {
         copyDataToProfile();
@@ -214,6 +217,64 @@ void ProfileManager::updateProfile(const QString &current, const QString &profil
     }
 }
 
+void ProfileManager::updateDatabase()
+{
+    // Database of new profile is created with current schema
+    if (m_profileVersion.isEmpty() || mApp->isPrivate()) {
+        return;
+    }
+
+    QSqlDatabase db = SqlDatabase::instance()->database();
+    if (!db.isOpen()) {
+        return;
+    }
+
+    Updater::Version prof(m_profileVersion);
+
+    // 3.1: History visits and frecency ranking
+    // Development profiles have the same version before and after the change
+    if (prof < Updater::Version(QStringLiteral("3.1.0")) && !db.record(QSL("history")).contains(QSL("frecency"))) {
+        db.transaction();
+
+        if (!db.tables().contains(QSL("history_visits"))) {
+            db.exec(QSL("CREATE TABLE history_visits ("
+                        "id INTEGER PRIMARY KEY,"
+                        "history_id INTEGER NOT NULL,"
+                        "date INTEGER NOT NULL,"
+                        "transition INTEGER DEFAULT 0 NOT NULL,"
+                        "referrer TEXT"
+                        ")"));
+            db.exec(QSL("CREATE INDEX history_visits_historyidindex ON history_visits (history_id)"));
+            db.exec(QSL("CREATE INDEX history_visits_dateindex ON history_visits (date)"));
+        }
+
+        db.exec(QSL("ALTER TABLE history ADD COLUMN frecency INTEGER DEFAULT 0 NOT NULL"));
+
+        // Estimate initial frecency from visit count and age of last visit
+        const qint64 day = 24 * 60 * 60 * 1000;
+        const qint64 now = QDateTime::currentMSecsSinceEpoch();
+        QSqlQuery query(db);
+        query.prepare(QSL("UPDATE history SET frecency = count * CASE "
+                          "WHEN date > ? THEN 100 "
+                          "WHEN date > ? THEN 70 "
+                          "WHEN date > ? THEN 50 "
+                          "WHEN date > ? THEN 30 "
+                          "ELSE 10 END"));
+        query.addBindValue(now - 4 * day);
+        query.addBindValue(now - 14 * day);
+        query.addBindValue(now - 31 * day);
+        query.addBindValue(now - 90 * day);
+        query.exec();
+
+        db.exec(QSL("CREATE INDEX history_frecencyindex ON history (frecency)"));
+
+        if (!db.commit()) {
+            qWarning() << "Failed to update history database" << db.lastError().text();
+            db.rollback();
+        }
+    }
+}
+
 void ProfileManager::copyDataToProfile()
 {
     QDir profileDir(DataPaths::currentProfilePath());
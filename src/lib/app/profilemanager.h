@@ -54,6 +54,10 @@ private:
     void migrateFromQupZilla();
 
     void connectDatabase();
+    // Migrates database schema of profile from older version
+    void updateDatabase();
+
+    QString m_profileVersion;
 };
 
 #endif // PROFILEMANAGER_H
@@ -20,7 +20,7 @@
 
 namespace Qz
 {
-const int sessionVersion = 0x0004;
+const int sessionVersion = 0x0005;
 
 FALKON_EXPORT const char *APPNAME = "Falkon";
 FALKON_EXPORT const char *VERSION = FALKON_VERSION;
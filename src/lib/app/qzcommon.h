@@ -83,7 +83,8 @@ enum CommandLineAction {
     CL_StartNewInstance,
     CL_StartPortable,
     CL_ExitAction,
-    CL_WMClass
+    CL_WMClass,
+    CL_TraceStartup
 };
 
 enum ObjectName {
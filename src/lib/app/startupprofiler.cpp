@@ -0,0 +1,208 @@
+/* ============================================================
+* Falkon - Qt web browser
+* Copyright (C) 2018 David Rosca <nowrep@gmail.com>
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program.  If not, see <http://www.gnu.org/licenses/>.
+* ============================================================ */
+#include "startupprofiler.h"
+
+#include <QFile>
+#include <QMutex>
+#include <QThread>
+#include <QVector>
+#include <QJsonArray>
+#include <QJsonObject>
+#include <QJsonDocument>
+#include <QElapsedTimer>
+#include <QCoreApplication>
+
+#ifdef Q_OS_WIN
+#include <windows.h>
+#else
+#include <sys/resource.h>
+#endif
+
+namespace {
+
+struct TraceEvent
+{
+    QString name;
+    quintptr threadId;
+    qint64 wallStart;
+    qint64 wallDuration;
+    qint64 cpuStart;
+    qint64 cpuDuration;
+    bool instant;
+};
+
+struct ProfilerData
+{
+    QMutex mutex;
+    QString fileName;
+    QElapsedTimer timer;
+    QVector<TraceEvent> events;
+    bool enabled = false;
+};
+
+Q_GLOBAL_STATIC(ProfilerData, s_data)
+
+// Process CPU time (user + system) in microseconds
+qint64 cpuTime()
+{
+#ifdef Q_OS_WIN
+    FILETIME creationTime, exitTime, kernelTime, userTime;
+    if (!GetProcessTimes(GetCurrentProcess(), &creationTime, &exitTime, &kernelTime, &userTime)) {
+        return 0;
+    }
+    ULARGE_INTEGER kernel, user;
+    kernel.LowPart = kernelTime.dwLowDateTime;
+    kernel.HighPart = kernelTime.dwHighDateTime;
+    user.LowPart = userTime.dwLowDateTime;
+    user.HighPart = userTime.dwHighDateTime;
+    // 100 ns units
+    return (kernel.QuadPart + user.QuadPart) / 10;
+#else
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) != 0) {
+        return 0;
+    }
+    return qint64(usage.ru_utime.tv_sec + usage.ru_stime.tv_sec) * 1000000
+            + usage.ru_utime.tv_usec + usage.ru_stime.tv_usec;
+#endif
+}
+
+quintptr currentThreadId()
+{
+    return reinterpret_cast<quintptr>(QThread::currentThreadId());
+}
+
+}
+
+StartupProfiler::Phase::Phase(const QString &name)
+    : m_index(StartupProfiler::begin(name))
+{
+}
+
+StartupProfiler::Phase::~Phase()
+{
+    StartupProfiler::end(m_index);
+}
+
+void StartupProfiler::start(const QString &fileName)
+{
+    QMutexLocker locker(&s_data->mutex);
+    s_data->fileName = fileName;
+    s_data->events.clear();
+    s_data->timer.start();
+    s_data->enabled = true;
+}
+
+bool StartupProfiler::isEnabled()
+{
+    QMutexLocker locker(&s_data->mutex);
+    return s_data->enabled;
+}
+
+int StartupProfiler::begin(const QString &name)
+{
+    QMutexLocker locker(&s_data->mutex);
+    if (!s_data->enabled) {
+        return -1;
+    }
+
+    TraceEvent event;
+    event.name = name;
+    event.threadId = currentThreadId();
+    event.wallStart = s_data->timer.nsecsElapsed() / 1000;
+    event.wallDuration = 0;
+    event.cpuStart = cpuTime();
+    event.cpuDuration = 0;
+    event.instant = false;
+
+    s_data->events.append(event);
+    return s_data->events.count() - 1;
+}
+
+void StartupProfiler::end(int index)
+{
+    QMutexLocker locker(&s_data->mutex);
+    if (!s_data->enabled || index < 0 || index >= s_data->events.count()) {
+        return;
+    }
+
+    TraceEvent &event = s_data->events[index];
+    event.wallDuration = s_data->timer.nsecsElapsed() / 1000 - event.wallStart;
+    event.cpuDuration = cpuTime() - event.cpuStart;
+}
+
+void StartupProfiler::mark(const QString &name)
+{
+    const int index = begin(name);
+    if (index < 0) {
+        return;
+    }
+
+    QMutexLocker locker(&s_data->mutex);
+    s_data->events[index].instant = true;
+}
+
+void StartupProfiler::finish()
+{
+    QMutexLocker locker(&s_data->mutex);
+    if (!s_data->enabled) {
+        return;
+    }
+
+    s_data->enabled = false;
+
+    const qint64 pid = QCoreApplication::applicationPid();
+    QJsonArray traceEvents;
+
+    for (const TraceEvent &event : qAsConst(s_data->events)) {
+        QJsonObject object;
+        object[QSL("name")] = event.name;
+        object[QSL("cat")] = QSL("startup");
+        object[QSL("pid")] = pid;
+        object[QSL("tid")] = QString::number(event.threadId);
+        object[QSL("ts")] = event.wallStart;
+
+        if (event.instant) {
+            object[QSL("ph")] = QSL("i");
+            object[QSL("s")] = QSL("p");
+        }
+        else {
+            object[QSL("ph")] = QSL("X");
+            object[QSL("dur")] = event.wallDuration;
+
+            QJsonObject args;
+            args[QSL("cpu_ms")] = event.cpuDuration / 1000.0;
+            object[QSL("args")] = args;
+        }
+
+        traceEvents.append(object);
+    }
+
+    QJsonObject trace;
+    trace[QSL("traceEvents")] = traceEvents;
+    trace[QSL("displayTimeUnit")] = QSL("ms");
+
+    QFile file(s_data->fileName);
+    if (!file.open(QFile::WriteOnly | QFile::Truncate)) {
+        qWarning() << "Cannot write startup trace to" << s_data->fileName;
+        return;
+    }
+
+    file.write(QJsonDocument(trace).toJson(QJsonDocument::Compact));
+    s_data->events.clear();
+}
@@ -0,0 +1,57 @@
+/* ============================================================
+* Falkon - Qt web browser
+* Copyright (C) 2018 David Rosca <nowrep@gmail.com>
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program.  If not, see <http://www.gnu.org/licenses/>.
+* ============================================================ */
+#ifndef STARTUPPROFILER_H
+#define STARTUPPROFILER_H
+
+#include <QString>
+
+#include "qzcommon.h"
+
+// Records named startup phases with wall and CPU time.
+// Trace is written in Chrome trace event format (chrome://tracing).
+class FALKON_EXPORT StartupProfiler
+{
+public:
+    // Records phase from construction until destruction
+    class FALKON_EXPORT Phase
+    {
+    public:
+        explicit Phase(const QString &name);
+        ~Phase();
+
+    private:
+        int m_index;
+    };
+
+    // Enables profiler, trace will be written to fileName by finish()
+    static void start(const QString &fileName);
+    static bool isEnabled();
+
+    // Records single point in time
+    static void mark(const QString &name);
+
+    // Writes trace and disables profiler
+    static void finish();
+
+private:
+    // Returns index of the phase to be passed to end(), or -1 when disabled
+    static int begin(const QString &name);
+    static void end(int index);
+};
+
+#endif // STARTUPPROFILER_H
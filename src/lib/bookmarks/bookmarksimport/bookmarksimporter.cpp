@@ -26,6 +26,16 @@ BookmarksImporter::~BookmarksImporter()
 {
 }
 
+QString BookmarksImporter::path() const
+{
+    return m_path;
+}
+
+void BookmarksImporter::setPath(const QString &path)
+{
+    m_path = path;
+}
+
 bool BookmarksImporter::error() const
 {
     return !m_error.isEmpty();
@@ -37,6 +37,9 @@ public:
     bool error() const;
     QString errorString() const;
 
+    QString path() const;
+    void setPath(const QString &path);
+
     virtual QString description() const = 0;
     virtual QString standardPath() const = 0;
 
@@ -53,6 +56,8 @@ protected:
     // Empty error = no error
     void setError(const QString &error);
 
+    QString m_path;
+
 private:
     QString m_error;
 };
@@ -20,8 +20,8 @@
 
 #include <QDir>
 #include <QFileDialog>
-#include <QVariantList>
 #include <QJsonDocument>
+#include <QJsonObject>
 
 ChromeImporter::ChromeImporter(QObject* parent)
     : BookmarksImporter(parent)
@@ -68,42 +68,45 @@ BookmarkItem* ChromeImporter::importBookmarks()
     const QByteArray data = m_file.readAll();
     m_file.close();
 
+    // Walk the parsed document directly, converting it to QVariant copies the whole tree
     QJsonParseError err;
-    QJsonDocument json = QJsonDocument::fromJson(data, &err);
-    const QVariant res = json.toVariant();
+    const QJsonDocument json = QJsonDocument::fromJson(data, &err);
 
-    if (err.error != QJsonParseError::NoError || res.type() != QVariant::Map) {
+    if (err.error != QJsonParseError::NoError || !json.isObject()) {
         setError(BookmarksImporter::tr("Cannot parse JSON file!"));
         return nullptr;
     }
 
-    QVariantMap rootMap = res.toMap().value(QSL("roots")).toMap();
+    const QJsonObject rootObject = json.object().value(QSL("roots")).toObject();
 
     BookmarkItem* root = new BookmarkItem(BookmarkItem::Folder);
     root->setTitle(QSL("Chrome Import"));
 
+    const QJsonObject bookmarkBar = rootObject.value(QSL("bookmark_bar")).toObject();
     BookmarkItem* toolbar = new BookmarkItem(BookmarkItem::Folder, root);
-    toolbar->setTitle(rootMap.value(QSL("bookmark_bar")).toMap().value(QSL("name")).toString());
-    readBookmarks(rootMap.value(QSL("bookmark_bar")).toMap().value(QSL("children")).toList(), toolbar);
+    toolbar->setTitle(bookmarkBar.value(QSL("name")).toString());
+    readBookmarks(bookmarkBar.value(QSL("children")).toArray(), toolbar);
 
+    const QJsonObject otherObject = rootObject.value(QSL("other")).toObject();
     BookmarkItem* other = new BookmarkItem(BookmarkItem::Folder, root);
-    other->setTitle(rootMap.value(QSL("other")).toMap().value(QSL("name")).toString());
-    readBookmarks(rootMap.value(QSL("other")).toMap().value(QSL("children")).toList(), other);
+    other->setTitle(otherObject.value(QSL("name")).toString());
+    readBookmarks(otherObject.value(QSL("children")).toArray(), other);
 
+    const QJsonObject syncedObject = rootObject.value(QSL("synced")).toObject();
     BookmarkItem* synced = new BookmarkItem(BookmarkItem::Folder, root);
-    synced->setTitle(rootMap.value(QSL("synced")).toMap().value(QSL("name")).toString());
-    readBookmarks(rootMap.value(QSL("synced")).toMap().value(QSL("synced")).toList(), other);
+    synced->setTitle(syncedObject.value(QSL("name")).toString());
+    readBookmarks(syncedObject.value(QSL("children")).toArray(), synced);
 
     return root;
 }
 
-void ChromeImporter::readBookmarks(const QVariantList &list, BookmarkItem* parent)
+void ChromeImporter::readBookmarks(const QJsonArray &list, BookmarkItem* parent)
 {
     Q_ASSERT(parent);
 
-    foreach (const QVariant &entry, list) {
-        const QVariantMap map = entry.toMap();
-        const QString typeString = map.value(QSL("type")).toString();
+    for (const QJsonValue &entry : list) {
+        const QJsonObject object = entry.toObject();
+        const QString typeString = object.value(QSL("type")).toString();
         BookmarkItem::Type type;
 
         if (typeString == QLatin1String("url")) {
@@ -117,14 +120,15 @@ void ChromeImporter::readBookmarks(const QVariantList &list, BookmarkItem* paren
         }
 
         BookmarkItem* item = new BookmarkItem(type, parent);
-        item->setTitle(map.value(QSL("name")).toString());
+        item->setTitle(object.value(QSL("name")).toString());
 
         if (item->isUrl()) {
-            item->setUrl(QUrl::fromEncoded(map.value(QSL("url")).toByteArray()));
+            item->setUrl(QUrl::fromEncoded(object.value(QSL("url")).toString().toUtf8()));
         }
 
-        if (map.contains(QSL("children"))) {
-            readBookmarks(map.value(QSL("children")).toList(), item);
+        const QJsonValue children = object.value(QSL("children"));
+        if (children.isArray()) {
+            readBookmarks(children.toArray(), item);
         }
     }
 }
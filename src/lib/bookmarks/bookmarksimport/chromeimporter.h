@@ -19,7 +19,7 @@
 #define CHROMEIMPORTER_H
 
 #include <QFile>
-#include <QVariantList>
+#include <QJsonArray>
 
 #include "bookmarksimporter.h"
 
@@ -37,9 +37,8 @@ public:
     BookmarkItem* importBookmarks() override;
 
 private:
-    void readBookmarks(const QVariantList &list, BookmarkItem* parent);
+    void readBookmarks(const QJsonArray &list, BookmarkItem* parent);
 
-    QString m_path;
     QFile m_file;
 };
 
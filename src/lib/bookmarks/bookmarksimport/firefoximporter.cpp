@@ -20,6 +20,7 @@
 
 #include <QDir>
 #include <QVariant>
+#include <QVector>
 #include <QSqlError>
 #include <QFileDialog>
 #include <QSqlQuery>
@@ -83,13 +84,16 @@ bool FirefoxImporter::prepareImport()
 
 BookmarkItem* FirefoxImporter::importBookmarks()
 {
-    QList<Item> items;
+    QVector<Item> items;
 
     BookmarkItem* root = new BookmarkItem(BookmarkItem::Folder);
     root->setTitle(QStringLiteral("Firefox Import"));
 
     QSqlQuery query(QSqlDatabase::database(CONNECTION));
-    query.prepare(QStringLiteral("SELECT id, parent, type, title, fk FROM moz_bookmarks WHERE fk NOT NULL OR type = 3"));
+    query.setForwardOnly(true);
+    query.prepare(QStringLiteral("SELECT b.id, b.parent, b.type, b.title, p.url FROM moz_bookmarks b "
+                                 "LEFT JOIN moz_places p ON p.id = b.fk "
+                                 "WHERE b.fk NOT NULL OR b.type = 3"));
     query.exec();
 
     while (query.next()) {
@@ -98,21 +102,12 @@ BookmarkItem* FirefoxImporter::importBookmarks()
         item.parent = query.value(1).toInt();
         item.type = typeFromValue(query.value(2).toInt());
         item.title = query.value(3).toString();
-        int fk = query.value(4).toInt();
+        item.url = query.value(4).toUrl();
 
         if (item.type == BookmarkItem::Invalid) {
             continue;
         }
 
-        QSqlQuery query(QSqlDatabase::database(CONNECTION));
-        query.prepare(QStringLiteral("SELECT url FROM moz_places WHERE id=?"));
-        query.addBindValue(fk);
-        query.exec();
-
-        if (query.next()) {
-            item.url = query.value(0).toUrl();
-        }
-
         if (item.url.scheme() == QLatin1String("place")) {
             continue;
         }
@@ -126,7 +121,9 @@ BookmarkItem* FirefoxImporter::importBookmarks()
 
     QHash<int, BookmarkItem*> hash;
 
-    foreach (const Item &item, items) {
+    hash.reserve(items.size());
+
+    for (const Item &item : qAsConst(items)) {
         BookmarkItem* parent = hash.value(item.parent);
         BookmarkItem* bookmark = new BookmarkItem(item.type, parent ? parent : root);
         bookmark->setTitle(item.title.isEmpty() ? item.url.toString() : item.title);
@@ -55,7 +55,6 @@ private:
 
     BookmarkItem::Type typeFromValue(int value);
 
-    QString m_path;
 
 };
 
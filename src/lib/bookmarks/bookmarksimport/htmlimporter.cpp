@@ -20,7 +20,7 @@
 
 #include <QUrl>
 #include <QFileDialog>
-#include <QRegularExpression>
+#include <QVector>
 
 HtmlImporter::HtmlImporter(QObject* parent)
     : BookmarksImporter(parent)
@@ -57,103 +57,110 @@ bool HtmlImporter::prepareImport()
     return true;
 }
 
-static int qzMin(int a, int b)
+static bool isTag(const QStringRef &tag, const QLatin1String &name)
 {
-    if (a > -1 && b > -1) {
-        return qMin(a, b);
+    if (!tag.startsWith(name, Qt::CaseInsensitive)) {
+        return false;
     }
+    return tag.size() == name.size() || tag.at(name.size()).isSpace();
+}
 
-    if (a > -1) {
-        return a;
-    }
-    else {
-        return b;
+static QStringRef attributeValue(const QStringRef &tag, const QLatin1String &name)
+{
+    int pos = 0;
+    while ((pos = tag.indexOf(name, pos, Qt::CaseInsensitive)) != -1) {
+        const int nameStart = pos;
+        const int valueStart = pos + name.size();
+        pos = valueStart;
+
+        if (nameStart == 0 || !tag.at(nameStart - 1).isSpace() || valueStart >= tag.size() || tag.at(valueStart) != QL1C('=')) {
+            continue;
+        }
+
+        int start = valueStart + 1;
+        if (start >= tag.size()) {
+            break;
+        }
+
+        const QChar quote = tag.at(start);
+        int end;
+        if (quote == QL1C('"') || quote == QL1C('\'')) {
+            ++start;
+            end = tag.indexOf(quote, start);
+        } else {
+            end = start;
+            while (end < tag.size() && !tag.at(end).isSpace()) {
+                ++end;
+            }
+        }
+
+        if (end == -1) {
+            end = tag.size();
+        }
+        return tag.mid(start, end - start);
     }
+
+    return QStringRef();
 }
 
 BookmarkItem* HtmlImporter::importBookmarks()
 {
-    QString bookmarks = QString::fromUtf8(m_file.readAll());
+    const QString bookmarks = QString::fromUtf8(m_file.readAll());
     m_file.close();
 
-    // Converting tags to lower case -,-
-    // For some reason Qt::CaseInsensitive is not every time insensitive :-D
-
-    bookmarks.replace(QLatin1String("<DL"), QLatin1String("<dl"));
-    bookmarks.replace(QLatin1String("</DL"), QLatin1String("</dl"));
-    bookmarks.replace(QLatin1String("<DT"), QLatin1String("<dt"));
-    bookmarks.replace(QLatin1String("</DT"), QLatin1String("</dt"));
-    bookmarks.replace(QLatin1String("<P"), QLatin1String("<p"));
-    bookmarks.replace(QLatin1String("</P"), QLatin1String("</p"));
-    bookmarks.replace(QLatin1String("<A"), QLatin1String("<a"));
-    bookmarks.replace(QLatin1String("</A"), QLatin1String("</a"));
-    bookmarks.replace(QLatin1String("HREF="), QLatin1String("href="));
-    bookmarks.replace(QLatin1String("<H3"), QLatin1String("<h3"));
-    bookmarks.replace(QLatin1String("</H3"), QLatin1String("</h3"));
-
-    bookmarks = bookmarks.left(bookmarks.lastIndexOf(QLatin1String("</dl><p>")));
-    int start = bookmarks.indexOf(QLatin1String("<dl><p>"));
-
     BookmarkItem* root = new BookmarkItem(BookmarkItem::Folder);
     root->setTitle(QStringLiteral("HTML Import"));
 
-    QList<BookmarkItem*> folders;
+    QVector<BookmarkItem*> folders;
     folders.append(root);
 
-    while (start > 0) {
-        QString string = bookmarks.mid(start);
-
-        int posOfFolder = string.indexOf(QLatin1String("<dt><h3"));
-        int posOfEndFolder = string.indexOf(QLatin1String("</dl><p>"));
-        int posOfLink = string.indexOf(QLatin1String("<dt><a"));
-
-        int nearest = qzMin(posOfLink, qzMin(posOfFolder, posOfEndFolder));
-        if (nearest == -1) {
+    // Single pass over the tags, folders are opened by <h3> and closed by </dl>
+    int pos = 0;
+    while ((pos = bookmarks.indexOf(QL1C('<'), pos)) != -1) {
+        const int tagEnd = bookmarks.indexOf(QL1C('>'), pos);
+        if (tagEnd == -1) {
             break;
         }
 
-        if (nearest == posOfFolder) {
-            // Next is folder
-            QRegularExpression rx(QSL("<dt><h3(.*)>(.*)</h3>"), QRegularExpression::InvertedGreedinessOption | QRegularExpression::DotMatchesEverythingOption);
-            QRegularExpressionMatch match = rx.match(string);
-            QString folderName = match.captured(2).trimmed();
+        const QStringRef tag = bookmarks.midRef(pos + 1, tagEnd - pos - 1);
+        pos = tagEnd + 1;
 
-            BookmarkItem* folder = new BookmarkItem(BookmarkItem::Folder, folders.isEmpty() ? root : folders.last());
-            folder->setTitle(folderName);
+        if (isTag(tag, QL1S("h3"))) {
+            const int end = bookmarks.indexOf(QL1S("</h3"), pos, Qt::CaseInsensitive);
+            if (end == -1) {
+                break;
+            }
+
+            BookmarkItem* folder = new BookmarkItem(BookmarkItem::Folder, folders.last());
+            folder->setTitle(bookmarks.midRef(pos, end - pos).trimmed().toString());
             folders.append(folder);
 
-            start += posOfFolder + match.captured(0).size();
+            pos = end;
         }
-        else if (nearest == posOfEndFolder) {
-            // Next is end of folder
-            if (!folders.isEmpty()) {
-                folders.removeLast();
+        else if (isTag(tag, QL1S("a"))) {
+            const int end = bookmarks.indexOf(QL1S("</a"), pos, Qt::CaseInsensitive);
+            if (end == -1) {
+                break;
             }
 
-            start += posOfEndFolder + 8;
-        }
-        else {
-            // Next is link
-            QRegularExpression rx(QSL("<dt><a(.*)>(.*)</a>"), QRegularExpression::InvertedGreedinessOption | QRegularExpression::DotMatchesEverythingOption);
-            QRegularExpressionMatch match = rx.match(string);
-
-            QString arguments = match.captured(1);
-            QString linkName = match.captured(2).trimmed();
-
-            QRegularExpression rx2(QSL("href=\"(.*)\""), QRegularExpression::InvertedGreedinessOption | QRegularExpression::DotMatchesEverythingOption);
-            QRegularExpressionMatch match2 = rx2.match(arguments);
-
-            QUrl url = QUrl::fromEncoded(match2.captured(1).trimmed().toUtf8());
+            const QString linkName = bookmarks.midRef(pos, end - pos).trimmed().toString();
+            const QUrl url = QUrl::fromEncoded(attributeValue(tag, QL1S("href")).trimmed().toUtf8());
 
-            start += posOfLink + match.captured(0).size();
+            pos = end;
 
             if (url.isEmpty() || url.scheme() == QL1S("place") || url.scheme() == QL1S("about"))
                 continue;
 
-            BookmarkItem* b = new BookmarkItem(BookmarkItem::Url, folders.isEmpty() ? root : folders.last());
+            BookmarkItem* b = new BookmarkItem(BookmarkItem::Url, folders.last());
             b->setTitle(linkName.isEmpty() ? url.toString() : linkName);
             b->setUrl(url);
         }
+        else if (tag.compare(QL1S("/dl"), Qt::CaseInsensitive) == 0) {
+            // Closing tag of the top level list is never matched by any folder
+            if (folders.size() > 1) {
+                folders.removeLast();
+            }
+        }
     }
 
     return root;
@@ -36,7 +36,6 @@ public:
     BookmarkItem* importBookmarks() override;
 
 private:
-    QString m_path;
     QFile m_file;
 };
 
@@ -38,7 +38,6 @@ public:
 private:
     void readDir(const QDir &dir, BookmarkItem* parent);
 
-    QString m_path;
 };
 
 #endif // IEIMPORTER_H
@@ -51,7 +51,6 @@ private:
     QString m_key;
     QString m_value;
 
-    QString m_path;
     QFile m_file;
     QTextStream m_stream;
 };
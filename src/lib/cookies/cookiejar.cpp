@@ -32,6 +32,7 @@
 CookieJar::CookieJar(QObject* parent)
     : QObject(parent)
     , m_client(mApp->webProfile()->cookieStore())
+    , m_cookiesCount(0)
 {
     loadSettings();
     m_client->loadAllCookies();
@@ -61,6 +62,9 @@ void CookieJar::loadSettings()
     m_whitelist = settings.value("whitelist", QStringList()).toStringList();
     m_blacklist = settings.value("blacklist", QStringList()).toStringList();
     settings.endGroup();
+
+    m_whitelistDomains = compileDomainList(m_whitelist);
+    m_blacklistDomains = compileDomainList(m_blacklist);
 }
 
 void CookieJar::setAllowCookies(bool allow)
@@ -75,7 +79,14 @@ void CookieJar::deleteCookie(const QNetworkCookie &cookie)
 
 QVector<QNetworkCookie> CookieJar::getAllCookies() const
 {
-    return m_cookies;
+    QVector<QNetworkCookie> cookies;
+    cookies.reserve(m_cookiesCount);
+
+    for (const QVector<QNetworkCookie> &bucket : m_cookies) {
+        cookies += bucket;
+    }
+
+    return cookies;
 }
 
 void CookieJar::deleteAllCookies(bool deleteAll)
@@ -85,11 +96,16 @@ void CookieJar::deleteAllCookies(bool deleteAll)
         return;
     }
 
-    for (const QNetworkCookie &cookie : qAsConst(m_cookies)) {
-        if (!listMatchesDomain(m_whitelist, cookie.domain())) {
-            m_client->deleteCookie(cookie);
+    QVector<QNetworkCookie> cookies;
+    for (auto it = m_cookies.constBegin(); it != m_cookies.constEnd(); ++it) {
+        if (!domainSetMatches(m_whitelistDomains, it.key())) {
+            cookies += it.value();
         }
     }
+
+    for (const QNetworkCookie &cookie : qAsConst(cookies)) {
+        m_client->deleteCookie(cookie);
+    }
 }
 
 bool CookieJar::matchDomain(QString cookieDomain, QString siteDomain) const
@@ -110,15 +126,58 @@ bool CookieJar::matchDomain(QString cookieDomain, QString siteDomain) const
 
 bool CookieJar::listMatchesDomain(const QStringList &list, const QString &cookieDomain) const
 {
-    foreach (const QString &d, list) {
-        if (matchDomain(d, cookieDomain)) {
+    return domainSetMatches(compileDomainList(list), cookieDomain);
+}
+
+// static
+CookieJar::DomainSet CookieJar::compileDomainList(const QStringList &list)
+{
+    DomainSet set;
+    set.reserve(list.count());
+
+    for (const QString &d : list) {
+        const QString domain = d.startsWith(QLatin1Char('.')) ? d.mid(1) : d;
+        if (!domain.isEmpty()) {
+            set.insert(domain);
+        }
+    }
+
+    return set;
+}
+
+// static
+bool CookieJar::domainSetMatches(const DomainSet &set, const QString &domain)
+{
+    if (set.isEmpty() || domain.isEmpty()) {
+        return false;
+    }
+
+    // Same as matchDomain(): domain itself or any of its parent domains
+    int pos = domain.startsWith(QLatin1Char('.')) ? 1 : 0;
+    while (pos >= 0 && pos < domain.size()) {
+        if (set.contains(domain.mid(pos))) {
             return true;
         }
+        pos = domain.indexOf(QLatin1Char('.'), pos);
+        if (pos >= 0) {
+            ++pos;
+        }
     }
 
     return false;
 }
 
+static int cookieIndex(const QVector<QNetworkCookie> &bucket, const QNetworkCookie &cookie)
+{
+    for (int i = 0; i < bucket.count(); ++i) {
+        const QNetworkCookie &c = bucket.at(i);
+        if (c.name() == cookie.name() && c.path() == cookie.path()) {
+            return i;
+        }
+    }
+    return -1;
+}
+
 void CookieJar::slotCookieAdded(const QNetworkCookie &cookie)
 {
     if (rejectCookie(QString(), cookie, cookie.domain())) {
@@ -126,21 +185,45 @@ void CookieJar::slotCookieAdded(const QNetworkCookie &cookie)
         return;
     }
 
-    m_cookies.append(cookie);
+    QVector<QNetworkCookie> &bucket = m_cookies[cookie.domain()];
+    const int index = cookieIndex(bucket, cookie);
+    if (index < 0) {
+        bucket.append(cookie);
+        ++m_cookiesCount;
+    }
+    else {
+        bucket[index] = cookie;
+    }
+
     emit cookieAdded(cookie);
 }
 
 void CookieJar::slotCookieRemoved(const QNetworkCookie &cookie)
 {
-    if (m_cookies.removeOne(cookie))
-        emit cookieRemoved(cookie);
+    auto it = m_cookies.find(cookie.domain());
+    if (it == m_cookies.end()) {
+        return;
+    }
+
+    const int index = cookieIndex(it.value(), cookie);
+    if (index < 0) {
+        return;
+    }
+
+    it.value().remove(index);
+    if (it.value().isEmpty()) {
+        m_cookies.erase(it);
+    }
+    --m_cookiesCount;
+
+    emit cookieRemoved(cookie);
 }
 
 #if QTWEBENGINEWIDGETS_VERSION >= QT_VERSION_CHECK(5, 11, 0)
 bool CookieJar::cookieFilter(const QWebEngineCookieStore::FilterRequest &request) const
 {
     if (!m_allowCookies) {
-        bool result = listMatchesDomain(m_whitelist, request.origin.host());
+        bool result = domainSetMatches(m_whitelistDomains, request.origin.host());
         if (!result) {
 #ifdef COOKIE_DEBUG
             qDebug() << "not in whitelist" << request.origin;
@@ -150,7 +233,7 @@ bool CookieJar::cookieFilter(const QWebEngineCookieStore::FilterRequest &request
     }
 
     if (m_allowCookies) {
-        bool result = listMatchesDomain(m_blacklist, request.origin.host());
+        bool result = domainSetMatches(m_blacklistDomains, request.origin.host());
         if (result) {
 #ifdef COOKIE_DEBUG
             qDebug() << "found in blacklist" << request.origin.host();
@@ -175,7 +258,7 @@ bool CookieJar::rejectCookie(const QString &domain, const QNetworkCookie &cookie
     Q_UNUSED(domain)
 
     if (!m_allowCookies) {
-        bool result = listMatchesDomain(m_whitelist, cookieDomain);
+        bool result = domainSetMatches(m_whitelistDomains, cookieDomain);
         if (!result) {
 #ifdef COOKIE_DEBUG
             qDebug() << "not in whitelist" << cookie;
@@ -185,7 +268,7 @@ bool CookieJar::rejectCookie(const QString &domain, const QNetworkCookie &cookie
     }
 
     if (m_allowCookies) {
-        bool result = listMatchesDomain(m_blacklist, cookieDomain);
+        bool result = domainSetMatches(m_blacklistDomains, cookieDomain);
         if (result) {
 #ifdef COOKIE_DEBUG
             qDebug() << "found in blacklist" << cookie;
@@ -19,6 +19,8 @@
 #define COOKIEJAR_H
 
 #include <QVector>
+#include <QHash>
+#include <QSet>
 #include <QStringList>
 #include <QWebEngineCookieStore>
 #include <QtWebEngineWidgetsVersion>
@@ -52,6 +54,12 @@ protected:
     bool matchDomain(QString cookieDomain, QString siteDomain) const;
     bool listMatchesDomain(const QStringList &list, const QString &cookieDomain) const;
 
+    // Set of domains without leading dot, matched by looking up every label suffix of domain
+    typedef QSet<QString> DomainSet;
+
+    static DomainSet compileDomainList(const QStringList &list);
+    static bool domainSetMatches(const DomainSet &set, const QString &domain);
+
 private:
     void slotCookieAdded(const QNetworkCookie &cookie);
     void slotCookieRemoved(const QNetworkCookie &cookie);
@@ -69,9 +77,14 @@ private:
 
     QStringList m_whitelist;
     QStringList m_blacklist;
+    DomainSet m_whitelistDomains;
+    DomainSet m_blacklistDomains;
 
     QWebEngineCookieStore *m_client;
-    QVector<QNetworkCookie> m_cookies;
+
+    // Cookies bucketed by domain, cookie in bucket is identified by path and name
+    QHash<QString, QVector<QNetworkCookie>> m_cookies;
+    int m_cookiesCount;
 };
 
 #endif // COOKIEJAR_H
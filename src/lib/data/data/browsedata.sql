@@ -1,5 +1,8 @@
 -- Falkon browsedata.db
 
+-- Must be set before the first table is created
+PRAGMA auto_vacuum = INCREMENTAL;
+
 -- Tables
 CREATE TABLE autofill (
     id INTEGER PRIMARY KEY,
@@ -32,10 +35,22 @@ CREATE TABLE history (
     url TEXT NOT NULL,
     title TEXT,
     date INTEGER DEFAULT 0 NOT NULL,
-    count INTEGER DEFAULT 0 NOT NULL
+    count INTEGER DEFAULT 0 NOT NULL,
+    frecency INTEGER DEFAULT 0 NOT NULL
 );
 CREATE INDEX history_titleindex ON history (title);
 CREATE UNIQUE INDEX history_urluniqueindex ON history (url);
+CREATE INDEX history_frecencyindex ON history (frecency);
+
+CREATE TABLE history_visits (
+    id INTEGER PRIMARY KEY,
+    history_id INTEGER NOT NULL,
+    date INTEGER NOT NULL,
+    transition INTEGER DEFAULT 0 NOT NULL,
+    referrer TEXT
+);
+CREATE INDEX history_visits_historyidindex ON history_visits (history_id);
+CREATE INDEX history_visits_dateindex ON history_visits (date);
 
 CREATE TABLE search_engines (
     id INTEGER PRIMARY KEY,
@@ -55,4 +70,16 @@ CREATE TABLE icons (
 );
 CREATE UNIQUE INDEX icons_urluniqueindex ON icons (url);
 
+CREATE TABLE downloads (
+    id INTEGER PRIMARY KEY,
+    url TEXT NOT NULL,
+    path TEXT NOT NULL,
+    state INTEGER DEFAULT 0 NOT NULL,
+    received_bytes INTEGER DEFAULT 0 NOT NULL,
+    total_bytes INTEGER DEFAULT 0 NOT NULL,
+    start_date INTEGER DEFAULT 0 NOT NULL,
+    end_date INTEGER DEFAULT 0 NOT NULL
+);
+CREATE INDEX downloads_startdateindex ON downloads (start_date);
+
 -- Data
@@ -0,0 +1,172 @@
+/* ============================================================
+* Falkon - Qt web browser
+* Copyright (C) 2018 David Rosca <nowrep@gmail.com>
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program.  If not, see <http://www.gnu.org/licenses/>.
+* ============================================================ */
+#include "downloaditemdelegate.h"
+#include "downloadsmodel.h"
+
+#include <QPainter>
+#include <QFileInfo>
+#include <QMouseEvent>
+#include <QApplication>
+#include <QFileIconProvider>
+
+static const int s_iconSize = 30;
+static const int s_buttonSize = 20;
+static const int s_progressBarHeight = 8;
+
+DownloadItemDelegate::DownloadItemDelegate(QObject* parent)
+    : QStyledItemDelegate(parent)
+    , m_rowHeight(0)
+    , m_padding(0)
+{
+}
+
+void DownloadItemDelegate::paint(QPainter* painter, const QStyleOptionViewItem &option, const QModelIndex &index) const
+{
+    QStyleOptionViewItem opt = option;
+    initStyleOption(&opt, index);
+
+    const QWidget* w = opt.widget;
+    const QStyle* style = w ? w->style() : QApplication::style();
+    const int center = opt.rect.height() / 2 + opt.rect.top();
+    const bool downloading = index.data(DownloadsModel::StateRole).toInt() == DownloadsModel::Downloading;
+
+    QFont titleFont = opt.font;
+    titleFont.setBold(true);
+
+    const QFontMetrics titleMetrics(titleFont);
+    const QPalette::ColorRole colorRole = opt.state & QStyle::State_Selected ? QPalette::HighlightedText : QPalette::Text;
+
+    QPalette::ColorGroup cg = opt.state & QStyle::State_Enabled ? QPalette::Normal : QPalette::Disabled;
+    if (cg == QPalette::Normal && !(opt.state & QStyle::State_Active)) {
+        cg = QPalette::Inactive;
+    }
+
+    QPalette textPalette = opt.palette;
+    textPalette.setCurrentColorGroup(cg);
+
+    int leftPosition = opt.rect.left() + m_padding;
+    int rightPosition = opt.rect.right() - m_padding;
+
+    // Draw background
+    style->drawPrimitive(QStyle::PE_PanelItemViewItem, &opt, painter, w);
+
+    // Draw file icon
+    const QRect iconRect(leftPosition, center - s_iconSize / 2, s_iconSize, s_iconSize);
+    const QString fileName = index.data(DownloadsModel::FileNameRole).toString();
+    painter->drawPixmap(iconRect, fileIcon(fileName, w).pixmap(s_iconSize));
+    leftPosition = iconRect.right() + m_padding;
+
+    // Draw cancel button
+    if (downloading) {
+        const QRect buttonRect = cancelButtonRect(opt);
+        painter->drawPixmap(buttonRect, QIcon::fromTheme(QSL("process-stop")).pixmap(s_buttonSize));
+        rightPosition = buttonRect.left() - m_padding;
+    }
+
+    // Draw file name
+    QRect nameRect(leftPosition, opt.rect.top() + m_padding, rightPosition - leftPosition, titleMetrics.height());
+    painter->setFont(titleFont);
+    style->drawItemText(painter, nameRect, Qt::TextSingleLine | Qt::AlignLeft, textPalette, true,
+                        titleMetrics.elidedText(fileName, Qt::ElideMiddle, nameRect.width()), colorRole);
+
+    // Draw progress bar
+    QRect infoRect(nameRect.x(), nameRect.bottom() + opt.fontMetrics.leading(), nameRect.width(), opt.fontMetrics.height());
+    if (downloading) {
+        QStyleOptionProgressBar bar;
+        bar.rect = QRect(nameRect.x(), nameRect.bottom() + 3, nameRect.width(), s_progressBarHeight);
+        bar.state = QStyle::State_Enabled | QStyle::State_Horizontal;
+        bar.direction = opt.direction;
+        bar.palette = opt.palette;
+        bar.fontMetrics = opt.fontMetrics;
+        bar.minimum = 0;
+        bar.maximum = index.data(DownloadsModel::TotalBytesRole).toLongLong() > 0 ? 100 : 0;
+        bar.progress = index.data(DownloadsModel::ProgressRole).toInt();
+        bar.textVisible = false;
+        style->drawControl(QStyle::CE_ProgressBar, &bar, painter, w);
+        infoRect.moveTop(bar.rect.bottom() + 3);
+    }
+
+    // Draw info
+    const QString info = opt.fontMetrics.elidedText(index.data(DownloadsModel::InfoRole).toString(), Qt::ElideRight, infoRect.width());
+    painter->setFont(opt.font);
+    style->drawItemText(painter, infoRect, Qt::TextSingleLine | Qt::AlignLeft, textPalette, true, info, colorRole);
+}
+
+QSize DownloadItemDelegate::sizeHint(const QStyleOptionViewItem &option, const QModelIndex &index) const
+{
+    // All rows have the same height so the view can use uniform item sizes
+    if (!m_rowHeight) {
+        QStyleOptionViewItem opt(option);
+        initStyleOption(&opt, index);
+
+        const QWidget* w = opt.widget;
+        const QStyle* style = w ? w->style() : QApplication::style();
+        const int padding = style->pixelMetric(QStyle::PM_FocusFrameHMargin, 0) + 1;
+
+        QFont titleFont = opt.font;
+        titleFont.setBold(true);
+
+        m_padding = padding > 5 ? padding : 5;
+
+        const QFontMetrics titleMetrics(titleFont);
+
+        m_rowHeight = 2 * m_padding + titleMetrics.height() + s_progressBarHeight + 6 + opt.fontMetrics.height();
+    }
+
+    return QSize(200, m_rowHeight);
+}
+
+bool DownloadItemDelegate::editorEvent(QEvent* event, QAbstractItemModel* model, const QStyleOptionViewItem &option, const QModelIndex &index)
+{
+    if (event->type() == QEvent::MouseButtonRelease
+        && index.data(DownloadsModel::StateRole).toInt() == DownloadsModel::Downloading) {
+        QMouseEvent* e = static_cast<QMouseEvent*>(event);
+        if (e->button() == Qt::LeftButton && cancelButtonRect(option).contains(e->pos())) {
+            emit cancelRequested(index);
+            return true;
+        }
+    }
+
+    return QStyledItemDelegate::editorEvent(event, model, option, index);
+}
+
+QIcon DownloadItemDelegate::fileIcon(const QString &fileName, const QWidget* widget) const
+{
+    // Icons are looked up by suffix only, so they can be shared between rows
+    const QString suffix = QFileInfo(fileName).suffix().toLower();
+
+    auto it = m_iconCache.constFind(suffix);
+    if (it != m_iconCache.constEnd()) {
+        return it.value();
+    }
+
+    QIcon icon = QFileIconProvider().icon(QFileInfo(fileName));
+    if (icon.isNull()) {
+        const QStyle* style = widget ? widget->style() : QApplication::style();
+        icon = style->standardIcon(QStyle::SP_FileIcon);
+    }
+
+    m_iconCache.insert(suffix, icon);
+    return icon;
+}
+
+QRect DownloadItemDelegate::cancelButtonRect(const QStyleOptionViewItem &option) const
+{
+    const int center = option.rect.height() / 2 + option.rect.top();
+    return QRect(option.rect.right() - m_padding - s_buttonSize, center - s_buttonSize / 2, s_buttonSize, s_buttonSize);
+}
@@ -20,7 +20,8 @@
 #include "browserwindow.h"
 #include "mainapplication.h"
 #include "downloadoptionsdialog.h"
-#include "downloaditem.h"
+#include "downloadsmodel.h"
+#include "downloaditemdelegate.h"
 #include "networkmanager.h"
 #include "desktopnotificationsfactory.h"
 #include "qztools.h"
@@ -33,10 +34,13 @@
 #include "tabbar.h"
 #include "locationbar.h"
 
+#include <QMenu>
+#include <QClipboard>
 #include <QMessageBox>
 #include <QCloseEvent>
 #include <QDir>
 #include <QShortcut>
+#include <QDesktopServices>
 #include <QStandardPaths>
 #include <QWebEngineHistory>
 #include <QWebEngineDownloadItem>
@@ -47,11 +51,14 @@
 #include <QWindow>
 #include <QWinTaskbarButton>
 #include <QWinTaskbarProgress>
+#include "Shlwapi.h"
+#include "shellapi.h"
 #endif
 
 DownloadManager::DownloadManager(QWidget* parent)
     : QWidget(parent)
     , ui(new Ui::DownloadManager)
+    , m_model(new DownloadsModel(this))
     , m_isClosing(false)
     , m_lastDownloadOption(NoOption)
 {
@@ -65,6 +72,20 @@ DownloadManager::DownloadManager(QWidget* parent)
     ui->clearButton->setIcon(QIcon::fromTheme("edit-clear"));
     QzTools::centerWidgetOnScreen(this);
 
+    DownloadItemDelegate* delegate = new DownloadItemDelegate(ui->list);
+    ui->list->setItemDelegate(delegate);
+    ui->list->setModel(m_model);
+
+    connect(delegate, &DownloadItemDelegate::cancelRequested, m_model, &DownloadsModel::cancelDownload);
+    connect(ui->list, &QAbstractItemView::doubleClicked, this, &DownloadManager::openFile);
+    connect(ui->list, &QWidget::customContextMenuRequested, this, &DownloadManager::customContextMenuRequested);
+    connect(ui->search, &QLineEdit::textChanged, this, &DownloadManager::searchChanged);
+
+    connect(m_model, &DownloadsModel::progressChanged, this, &DownloadManager::updateDownloadsInfo);
+    connect(m_model, &DownloadsModel::downloadFinished, this, &DownloadManager::downloadFinished);
+    connect(m_model, &DownloadsModel::countChanged, this, &DownloadManager::downloadsCountChanged);
+    connect(m_model, &DownloadsModel::countChanged, this, &DownloadManager::updateStatistics);
+
     connect(ui->clearButton, &QAbstractButton::clicked, this, &DownloadManager::clearList);
 
     QShortcut* clearShortcut = new QShortcut(QKeySequence("CTRL+L"), this);
@@ -96,11 +117,12 @@ void DownloadManager::loadSettings()
 
 void DownloadManager::show()
 {
-    m_timer.start(500, this);
-
     QWidget::show();
     raise();
     activateWindow();
+
+    // Statistics are not updated while hidden
+    updateStatistics();
 }
 
 void DownloadManager::resizeEvent(QResizeEvent* e)
@@ -212,89 +234,140 @@ void DownloadManager::startExternalManager(const QUrl &url)
     m_lastDownloadOption = ExternalManager;
 }
 
-void DownloadManager::timerEvent(QTimerEvent* e)
+void DownloadManager::updateDownloadsInfo()
 {
-    QVector<QTime> remTimes;
-    QVector<int> progresses;
-    QVector<double> speeds;
-
-    if (e->timerId() == m_timer.timerId()) {
-        if (!ui->list->count()) {
-            ui->speedLabel->clear();
-            setWindowTitle(tr("Download Manager"));
-#ifdef Q_OS_WIN
-            taskbarButton()->progress()->hide();
-#endif
-            return;
-        }
-        for (int i = 0; i < ui->list->count(); i++) {
-            DownloadItem* downItem = qobject_cast<DownloadItem*>(ui->list->itemWidget(ui->list->item(i)));
-            if (!downItem || downItem->isCancelled() || !downItem->isDownloading()) {
-                continue;
-            }
-            progresses.append(downItem->progress());
-            remTimes.append(downItem->remainingTime());
-            speeds.append(downItem->currentSpeed());
-        }
-        if (remTimes.isEmpty()) {
-            return;
-        }
+    const int count = m_model->activeCount();
 
-        QTime remaining;
-        foreach (const QTime &time, remTimes) {
-            if (time > remaining) {
-                remaining = time;
-            }
-        }
-
-        int progress = 0;
-        foreach (int prog, progresses) {
-            progress += prog;
-        }
-        progress = progress / progresses.count();
+    if (count == 0) {
+        return;
+    }
 
-        double speed = 0.00;
-        foreach (double spee, speeds) {
-            speed += spee;
-        }
+    const int progress = m_model->totalProgress();
 
 #ifndef Q_OS_WIN
-        ui->speedLabel->setText(tr("%1% of %2 files (%3) %4 remaining").arg(QString::number(progress), QString::number(progresses.count()),
-                                DownloadItem::currentSpeedToString(speed),
-                                DownloadItem::remaingTimeToString(remaining)));
+    ui->speedLabel->setText(tr("%1% of %2 files (%3) %4 remaining").arg(QString::number(progress), QString::number(count),
+                            DownloadsModel::currentSpeedToString(m_model->totalSpeed()),
+                            DownloadsModel::remainingTimeToString(m_model->remainingTime())));
 #endif
-        setWindowTitle(tr("%1% - Download Manager").arg(progress));
+    setWindowTitle(tr("%1% - Download Manager").arg(progress));
 #ifdef Q_OS_WIN
-        taskbarButton()->progress()->show();
-        taskbarButton()->progress()->setValue(progress);
+    taskbarButton()->progress()->show();
+    taskbarButton()->progress()->setValue(progress);
 #endif
+}
+
+void DownloadManager::updateStatistics()
+{
+    if (m_model->activeCount() > 0 || !isVisible()) {
+        return;
     }
 
-    QWidget::timerEvent(e);
+    const DownloadsModel::Statistics stats = m_model->statistics();
+    if (stats.count == 0) {
+        ui->speedLabel->clear();
+        return;
+    }
+
+    ui->speedLabel->setText(tr("%1 downloads, %2 completed (%3), %4 failed").arg(QString::number(stats.count), QString::number(stats.completed),
+                            QzTools::fileSizeToString(stats.completedBytes), QString::number(stats.failed)));
 }
 
 void DownloadManager::clearList()
 {
-    QList<DownloadItem*> items;
-    for (int i = 0; i < ui->list->count(); i++) {
-        DownloadItem* downItem = qobject_cast<DownloadItem*>(ui->list->itemWidget(ui->list->item(i)));
-        if (!downItem) {
-            continue;
-        }
-        if (downItem->isDownloading()) {
-            continue;
-        }
-        items.append(downItem);
+    m_model->removeFinished();
+}
+
+void DownloadManager::clearHistory(const QDateTime &since)
+{
+    m_model->removeFinished(QDateTime(), since);
+}
+
+void DownloadManager::searchChanged(const QString &text)
+{
+    m_model->setFilter(text.trimmed());
+}
+
+void DownloadManager::customContextMenuRequested(const QPoint &pos)
+{
+    const QModelIndex index = ui->list->indexAt(pos);
+
+    QMenu menu;
+
+    if (index.isValid()) {
+        const int state = index.data(DownloadsModel::StateRole).toInt();
+
+        menu.addAction(QIcon::fromTheme("document-open"), tr("Open File"), this, [=]() {
+            openFile(index);
+        })->setEnabled(state == DownloadsModel::Completed);
+        menu.addAction(tr("Open Folder"), this, [=]() {
+            openFolder(index);
+        });
+        menu.addSeparator();
+        menu.addAction(QIcon::fromTheme("edit-copy"), tr("Copy Download Link"), this, [=]() {
+            QApplication::clipboard()->setText(index.data(DownloadsModel::UrlRole).toUrl().toString());
+        });
+        menu.addSeparator();
+        menu.addAction(QIcon::fromTheme("process-stop"), tr("Cancel downloading"), this, [=]() {
+            m_model->cancelDownload(index);
+        })->setEnabled(state == DownloadsModel::Downloading);
+        menu.addAction(QIcon::fromTheme("list-remove"), tr("Remove From List"), this, [=]() {
+            m_model->removeDownload(index);
+        })->setEnabled(state != DownloadsModel::Downloading);
+        menu.addSeparator();
     }
-    qDeleteAll(items);
-    emit downloadsCountChanged();
+
+    QMenu* clearMenu = menu.addMenu(QIcon::fromTheme("edit-clear"), tr("Clear Downloads"));
+    clearMenu->addAction(tr("Older Than Day"), this, [=]() {
+        m_model->removeFinished(QDateTime::currentDateTime().addDays(-1));
+    });
+    clearMenu->addAction(tr("Older Than Week"), this, [=]() {
+        m_model->removeFinished(QDateTime::currentDateTime().addDays(-7));
+    });
+    clearMenu->addAction(tr("Older Than Month"), this, [=]() {
+        m_model->removeFinished(QDateTime::currentDateTime().addMonths(-1));
+    });
+    clearMenu->addSeparator();
+    clearMenu->addAction(tr("All"), this, &DownloadManager::clearList);
+
+    menu.exec(ui->list->viewport()->mapToGlobal(pos));
 }
 
-void DownloadManager::download(QWebEngineDownloadItem *downloadItem)
+void DownloadManager::openFile(const QModelIndex &index)
 {
-    QTime downloadTimer;
-    downloadTimer.start();
+    if (index.data(DownloadsModel::StateRole).toInt() != DownloadsModel::Completed) {
+        return;
+    }
+
+    QFileInfo info(index.data(DownloadsModel::PathRole).toString());
+    if (info.exists()) {
+        QDesktopServices::openUrl(QUrl::fromLocalFile(info.absoluteFilePath()));
+    }
+    else {
+        QMessageBox::warning(this, tr("Not found"), tr("Sorry, the file \n %1 \n was not found!").arg(info.absoluteFilePath()));
+    }
+}
+
+void DownloadManager::openFolder(const QModelIndex &index)
+{
+    const QString path = index.data(DownloadsModel::PathRole).toString();
+
+#ifdef Q_OS_WIN
+    QString winFileName = path;
+
+    if (index.data(DownloadsModel::StateRole).toInt() == DownloadsModel::Downloading) {
+        winFileName.append(QSL(".download"));
+    }
+
+    winFileName.replace(QLatin1Char('/'), "\\");
+    QString shExArg = "/e,/select,\"" + winFileName + "\"";
+    ShellExecute(NULL, NULL, TEXT("explorer.exe"), shExArg.toStdWString().c_str(), NULL, SW_SHOW);
+#else
+    QDesktopServices::openUrl(QUrl::fromLocalFile(QFileInfo(path).absolutePath()));
+#endif
+}
 
+void DownloadManager::download(QWebEngineDownloadItem *downloadItem)
+{
     closeDownloadTab(downloadItem);
 
     QString downloadPath;
@@ -396,52 +469,32 @@ void DownloadManager::download(QWebEngineDownloadItem *downloadItem)
     downloadItem->setPath(downloadPath);
     downloadItem->accept();
 
-    // Create download item
-    QListWidgetItem* listItem = new QListWidgetItem(ui->list);
-    DownloadItem* downItem = new DownloadItem(listItem, downloadItem, QFileInfo(downloadPath).absolutePath(), QFileInfo(downloadPath).fileName(), openFile, this);
-    downItem->setDownTimer(downloadTimer);
-    downItem->startDownloading();
-    connect(downItem, &DownloadItem::deleteItem, this, &DownloadManager::deleteItem);
-    connect(downItem, &DownloadItem::downloadFinished, this, &DownloadManager::downloadFinished);
-    ui->list->setItemWidget(listItem, downItem);
-    listItem->setSizeHint(downItem->sizeHint());
-    downItem->show();
-
-    m_activeDownloadsCount++;
-    emit downloadsCountChanged();
+    m_model->addDownload(downloadItem, openFile);
+    ui->list->scrollToTop();
+}
+
+DownloadsModel* DownloadManager::model() const
+{
+    return m_model;
 }
 
 int DownloadManager::downloadsCount() const
 {
-    return ui->list->count();
+    return m_model->sessionCount();
 }
 
 int DownloadManager::activeDownloadsCount() const
 {
-    return m_activeDownloadsCount;
+    return m_model->activeCount();
 }
 
-void DownloadManager::downloadFinished(bool success)
+void DownloadManager::downloadFinished(const QModelIndex &index, bool success, bool openFile)
 {
-    m_activeDownloadsCount = 0;
-    bool downloadingAllFilesFinished = true;
-    for (int i = 0; i < ui->list->count(); i++) {
-        DownloadItem* downItem = qobject_cast<DownloadItem*>(ui->list->itemWidget(ui->list->item(i)));
-        if (!downItem) {
-            continue;
-        }
-        if (downItem->isDownloading()) {
-            m_activeDownloadsCount++;
-        }
-        if (downItem->isCancelled() || !downItem->isDownloading()) {
-            continue;
-        }
-        downloadingAllFilesFinished = false;
+    if (success && openFile) {
+        this->openFile(index);
     }
 
-    emit downloadsCountChanged();
-
-    if (downloadingAllFilesFinished) {
+    if (m_model->activeCount() == 0) {
         if (success && qApp->activeWindow() != this) {
             mApp->desktopNotifications()->showNotification(QIcon::fromTheme(QSL("download"), QIcon(QSL(":icons/other/download.svg"))).pixmap(48), tr("Falkon: Download Finished"), tr("All files have been successfully downloaded."));
             if (!m_closeOnFinish) {
@@ -454,38 +507,20 @@ void DownloadManager::downloadFinished(bool success)
 #ifdef Q_OS_WIN
         taskbarButton()->progress()->hide();
 #endif
+        updateStatistics();
         if (m_closeOnFinish) {
             close();
         }
     }
 }
 
-void DownloadManager::deleteItem(DownloadItem* item)
-{
-    if (item && !item->isDownloading()) {
-        delete item;
-    }
-}
-
 bool DownloadManager::canClose()
 {
     if (m_isClosing) {
         return true;
     }
 
-    bool isDownloading = false;
-    for (int i = 0; i < ui->list->count(); i++) {
-        DownloadItem* downItem = qobject_cast<DownloadItem*>(ui->list->itemWidget(ui->list->item(i)));
-        if (!downItem) {
-            continue;
-        }
-        if (downItem->isDownloading()) {
-            isDownloading = true;
-            break;
-        }
-    }
-
-    return !isDownloading;
+    return m_model->activeCount() == 0;
 }
 
 bool DownloadManager::useExternalManager() const
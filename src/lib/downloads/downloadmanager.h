@@ -20,7 +20,7 @@
 
 #include <QWidget>
 #include <QPointer>
-#include <QBasicTimer>
+#include <QDateTime>
 
 #include "qzcommon.h"
 
@@ -31,11 +31,11 @@ class DownloadManager;
 
 class QUrl;
 class QNetworkAccessManager;
-class QListWidgetItem;
+class QModelIndex;
 class QWebEngineDownloadItem;
 class QWinTaskbarButton;
 
-class DownloadItem;
+class DownloadsModel;
 class WebPage;
 
 class FALKON_EXPORT DownloadManager : public QWidget
@@ -66,6 +66,8 @@ public:
 
     void download(QWebEngineDownloadItem *downloadItem);
 
+    DownloadsModel* model() const;
+
     int downloadsCount() const;
     int activeDownloadsCount() const;
 
@@ -77,20 +79,28 @@ public:
     void setLastDownloadPath(const QString &lastPath) { m_lastDownloadPath = lastPath; }
     void setLastDownloadOption(DownloadOption option) { m_lastDownloadOption = option; }
 
+    // Removes finished downloads from the list and database, or only those started since date
+    void clearHistory(const QDateTime &since = QDateTime());
+
 public Q_SLOTS:
     void show();
 
 private Q_SLOTS:
     void clearList();
-    void deleteItem(DownloadItem* item);
-    void downloadFinished(bool success);
+    void searchChanged(const QString &text);
+    void customContextMenuRequested(const QPoint &pos);
+    void openFile(const QModelIndex &index);
+    void openFolder(const QModelIndex &index);
 
 Q_SIGNALS:
     void resized(QSize);
     void downloadsCountChanged();
 
 private:
-    void timerEvent(QTimerEvent* e) override;
+    void downloadFinished(const QModelIndex &index, bool success, bool openFile);
+    void updateDownloadsInfo();
+    void updateStatistics();
+
     void closeEvent(QCloseEvent* e) override;
     void resizeEvent(QResizeEvent* e) override;
     void keyPressEvent(QKeyEvent* e) override;
@@ -99,14 +109,13 @@ private:
     QWinTaskbarButton *taskbarButton();
 
     Ui::DownloadManager* ui;
-    QBasicTimer m_timer;
+    DownloadsModel* m_model;
 
     QString m_lastDownloadPath;
     QString m_downloadPath;
     bool m_useNativeDialog;
     bool m_isClosing;
     bool m_closeOnFinish;
-    int m_activeDownloadsCount = 0;
 
     bool m_useExternalManager;
     QString m_externalExecutable;
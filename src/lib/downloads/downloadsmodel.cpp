@@ -0,0 +1,649 @@
+/* ============================================================
+* Falkon - Qt web browser
+* Copyright (C) 2018 David Rosca <nowrep@gmail.com>
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program.  If not, see <http://www.gnu.org/licenses/>.
+* ============================================================ */
+#include "downloadsmodel.h"
+#include "sqldatabase.h"
+#include "mainapplication.h"
+#include "qztools.h"
+
+#include <QFileInfo>
+#include <QSqlQuery>
+#include <QTimerEvent>
+#include <QWebEngineDownloadItem>
+
+#include <limits>
+
+static const int s_fetchSize = 100;
+
+DownloadsModel::DownloadsModel(QObject *parent)
+    : QAbstractListModel(parent)
+    , m_lastFetchedId(std::numeric_limits<qint64>::max())
+{
+    QSqlDatabase db = SqlDatabase::instance()->database();
+    if (!db.tables().contains(QSL("downloads"))) {
+        db.exec(QSL("CREATE TABLE downloads (id INTEGER PRIMARY KEY, url TEXT NOT NULL, path TEXT NOT NULL,"
+                    "state INTEGER DEFAULT 0 NOT NULL, received_bytes INTEGER DEFAULT 0 NOT NULL,"
+                    "total_bytes INTEGER DEFAULT 0 NOT NULL, start_date INTEGER DEFAULT 0 NOT NULL,"
+                    "end_date INTEGER DEFAULT 0 NOT NULL)"));
+        db.exec(QSL("CREATE INDEX downloads_startdateindex ON downloads (start_date)"));
+    }
+}
+
+DownloadsModel::~DownloadsModel()
+{
+    qDeleteAll(m_entries);
+}
+
+int DownloadsModel::rowCount(const QModelIndex &parent) const
+{
+    if (parent.isValid()) {
+        return 0;
+    }
+    return m_entries.count();
+}
+
+QVariant DownloadsModel::data(const QModelIndex &index, int role) const
+{
+    if (!index.isValid() || index.row() >= m_entries.count()) {
+        return QVariant();
+    }
+
+    const Entry *entry = m_entries.at(index.row());
+
+    switch (role) {
+    case IdRole:
+        return entry->id;
+    case UrlRole:
+        return entry->url;
+    case PathRole:
+        return entry->path;
+    case Qt::DisplayRole:
+    case FileNameRole:
+        return QFileInfo(entry->path).fileName();
+    case Qt::ToolTipRole:
+        return entry->url.toDisplayString();
+    case StateRole:
+        return entry->state;
+    case ReceivedBytesRole:
+        return entry->receivedBytes;
+    case TotalBytesRole:
+        return entry->totalBytes;
+    case SpeedRole:
+        return entry->speed;
+    case ProgressRole:
+        return progress(entry);
+    case StartDateRole:
+        return entry->startDate;
+    case EndDateRole:
+        return entry->endDate;
+    case InfoRole:
+        return infoText(entry);
+    default:
+        return QVariant();
+    }
+}
+
+bool DownloadsModel::canFetchMore(const QModelIndex &parent) const
+{
+    return !parent.isValid() && m_canFetchMore;
+}
+
+void DownloadsModel::fetchMore(const QModelIndex &parent)
+{
+    if (parent.isValid() || !m_canFetchMore) {
+        return;
+    }
+
+    QString sql = QSL("SELECT id, url, path, state, received_bytes, total_bytes, start_date, end_date "
+                      "FROM downloads WHERE id < ?");
+    if (!m_filter.isEmpty()) {
+        sql.append(QSL(" AND (path LIKE ? ESCAPE '!' OR url LIKE ? ESCAPE '!')"));
+    }
+    sql.append(QSL(" ORDER BY id DESC LIMIT %1").arg(s_fetchSize));
+
+    QSqlQuery query(SqlDatabase::instance()->database());
+    query.prepare(sql);
+    query.addBindValue(m_lastFetchedId);
+    if (!m_filter.isEmpty()) {
+        QString pattern = m_filter;
+        pattern.replace(QL1C('!'), QL1S("!!"));
+        pattern.replace(QL1C('%'), QL1S("!%"));
+        pattern.replace(QL1C('_'), QL1S("!_"));
+        pattern = QL1C('%') + pattern + QL1C('%');
+        query.addBindValue(pattern);
+        query.addBindValue(pattern);
+    }
+    query.exec();
+
+    QVector<Entry*> entries;
+    QVector<qint64> staleIds;
+    int fetched = 0;
+
+    while (query.next()) {
+        ++fetched;
+        const qint64 id = query.value(0).toLongLong();
+        m_lastFetchedId = id;
+
+        // Downloads from this session are already listed
+        if (m_loadedIds.contains(id)) {
+            continue;
+        }
+
+        Entry *entry = new Entry;
+        entry->id = id;
+        entry->url = query.value(1).toUrl();
+        entry->path = query.value(2).toString();
+        entry->state = static_cast<State>(query.value(3).toInt());
+        entry->receivedBytes = query.value(4).toLongLong();
+        entry->totalBytes = query.value(5).toLongLong();
+        entry->startDate = QDateTime::fromMSecsSinceEpoch(query.value(6).toLongLong());
+        entry->endDate = QDateTime::fromMSecsSinceEpoch(query.value(7).toLongLong());
+
+        // Browser was closed or crashed while downloading
+        if (entry->state == Downloading) {
+            entry->state = Interrupted;
+            staleIds.append(id);
+        }
+
+        m_loadedIds.insert(id);
+        entries.append(entry);
+    }
+
+    m_canFetchMore = fetched == s_fetchSize;
+
+    for (qint64 id : qAsConst(staleIds)) {
+        QSqlQuery update(SqlDatabase::instance()->database());
+        update.prepare(QSL("UPDATE downloads SET state=? WHERE id=?"));
+        update.addBindValue(Interrupted);
+        update.addBindValue(id);
+        update.exec();
+    }
+
+    if (entries.isEmpty()) {
+        return;
+    }
+
+    beginInsertRows(QModelIndex(), m_entries.count(), m_entries.count() + entries.count() - 1);
+    m_entries.append(entries);
+    endInsertRows();
+}
+
+QModelIndex DownloadsModel::addDownload(QWebEngineDownloadItem *download, bool openFile)
+{
+    Entry *entry = new Entry;
+    entry->url = download->url();
+    entry->path = download->path();
+    entry->receivedBytes = download->receivedBytes();
+    entry->totalBytes = download->totalBytes();
+    entry->startDate = QDateTime::currentDateTime();
+    entry->openFile = openFile;
+    entry->download = download;
+    entry->timer.start();
+
+    storeEntry(entry);
+
+    beginInsertRows(QModelIndex(), 0, 0);
+    m_entries.prepend(entry);
+    endInsertRows();
+
+    m_loadedIds.insert(entry->id);
+    m_sessionIds.insert(entry->id);
+    m_activeEntries.insert(entry);
+    updateStats(entry, 1);
+
+    connect(download, &QWebEngineDownloadItem::downloadProgress, this, [=](qint64 received, qint64 total) {
+        downloadProgress(entry, received, total);
+    });
+    connect(download, &QWebEngineDownloadItem::finished, this, [=]() {
+        finished(entry);
+    });
+
+    if (!m_timer.isActive()) {
+        m_timer.start(500, this);
+    }
+
+    emit countChanged();
+
+    return index(0);
+}
+
+void DownloadsModel::cancelDownload(const QModelIndex &index)
+{
+    if (!index.isValid() || index.row() >= m_entries.count()) {
+        return;
+    }
+
+    Entry *entry = m_entries.at(index.row());
+    if (m_activeEntries.contains(entry) && entry->download) {
+        entry->download->cancel();
+    }
+}
+
+void DownloadsModel::removeDownload(const QModelIndex &index)
+{
+    if (!index.isValid() || index.row() >= m_entries.count()) {
+        return;
+    }
+
+    if (m_activeEntries.contains(m_entries.at(index.row()))) {
+        return;
+    }
+
+    const qint64 id = m_entries.at(index.row())->id;
+    if (id > 0) {
+        QSqlQuery query(SqlDatabase::instance()->database());
+        query.prepare(QSL("DELETE FROM downloads WHERE id=?"));
+        query.addBindValue(id);
+        query.exec();
+    }
+
+    removeRows({index.row()});
+}
+
+void DownloadsModel::removeFinished(const QDateTime &olderThan, const QDateTime &newerThan)
+{
+    QStringList activeIds;
+    for (const Entry *entry : qAsConst(m_activeEntries)) {
+        activeIds.append(QString::number(entry->id));
+    }
+
+    QString sql = QSL("DELETE FROM downloads WHERE id NOT IN (%1)").arg(activeIds.join(QL1C(',')));
+    if (olderThan.isValid()) {
+        sql.append(QSL(" AND start_date < %1").arg(olderThan.toMSecsSinceEpoch()));
+    }
+    if (newerThan.isValid()) {
+        sql.append(QSL(" AND start_date >= %1").arg(newerThan.toMSecsSinceEpoch()));
+    }
+
+    QSqlQuery query(SqlDatabase::instance()->database());
+    query.exec(sql);
+
+    QVector<int> rows;
+    for (int i = 0; i < m_entries.count(); ++i) {
+        const Entry *entry = m_entries.at(i);
+        if (m_activeEntries.contains(entry)) {
+            continue;
+        }
+        if ((!olderThan.isValid() || entry->startDate < olderThan) && (!newerThan.isValid() || entry->startDate >= newerThan)) {
+            rows.append(i);
+        }
+    }
+
+    if (!olderThan.isValid() && !newerThan.isValid()) {
+        QSet<qint64> activeSessionIds;
+        for (const Entry *entry : qAsConst(m_activeEntries)) {
+            activeSessionIds.insert(entry->id);
+        }
+        m_sessionIds = activeSessionIds;
+    }
+
+    removeRows(rows);
+}
+
+QString DownloadsModel::filter() const
+{
+    return m_filter;
+}
+
+void DownloadsModel::setFilter(const QString &filter)
+{
+    if (m_filter == filter) {
+        return;
+    }
+
+    beginResetModel();
+
+    m_filter = filter;
+
+    // Active downloads are always listed
+    QVector<Entry*> entries;
+    for (Entry *entry : qAsConst(m_entries)) {
+        if (m_activeEntries.contains(entry)) {
+            entries.append(entry);
+        } else {
+            m_changedEntries.remove(entry);
+            delete entry;
+        }
+    }
+    m_entries = entries;
+
+    m_loadedIds.clear();
+    for (const Entry *entry : qAsConst(m_entries)) {
+        m_loadedIds.insert(entry->id);
+    }
+
+    m_lastFetchedId = std::numeric_limits<qint64>::max();
+    m_canFetchMore = true;
+
+    endResetModel();
+}
+
+DownloadsModel::Statistics DownloadsModel::statistics() const
+{
+    Statistics stats;
+
+    QSqlQuery query(SqlDatabase::instance()->database());
+    query.prepare(QSL("SELECT COUNT(*), SUM(state=?), SUM(state=? OR state=?), SUM(CASE WHEN state=? THEN total_bytes ELSE 0 END) FROM downloads"));
+    query.addBindValue(Completed);
+    query.addBindValue(Cancelled);
+    query.addBindValue(Interrupted);
+    query.addBindValue(Completed);
+    query.exec();
+
+    if (query.next()) {
+        stats.count = query.value(0).toInt();
+        stats.completed = query.value(1).toInt();
+        stats.failed = query.value(2).toInt();
+        stats.completedBytes = query.value(3).toLongLong();
+    }
+
+    return stats;
+}
+
+int DownloadsModel::sessionCount() const
+{
+    return m_sessionIds.count();
+}
+
+int DownloadsModel::activeCount() const
+{
+    return m_activeEntries.count();
+}
+
+int DownloadsModel::totalProgress() const
+{
+    return m_activeEntries.isEmpty() ? 0 : m_progressSum / m_activeEntries.count();
+}
+
+double DownloadsModel::totalSpeed() const
+{
+    return m_speedSum;
+}
+
+QTime DownloadsModel::remainingTime() const
+{
+    QTime time(0, 0, 0);
+    if (m_speedSum > 0) {
+        time = time.addSecs((m_totalSum - m_receivedSum) / m_speedSum);
+    }
+    return time;
+}
+
+// static
+QString DownloadsModel::remainingTimeToString(QTime time)
+{
+    if (time < QTime(0, 0, 10)) {
+        return tr("few seconds");
+    }
+    else if (time < QTime(0, 1)) {
+        //~ singular %n second
+        //~ plural %n seconds
+        return tr("%n seconds", "", time.second());
+    }
+    else if (time < QTime(1, 0)) {
+        //~ singular %n minute
+        //~ plural %n minutes
+        return tr("%n minutes", "", time.minute());
+    }
+    else {
+        //~ singular %n hour
+        //~ plural %n hours
+        return tr("%n hours", "", time.hour());
+    }
+}
+
+// static
+QString DownloadsModel::currentSpeedToString(double speed)
+{
+    if (speed < 0) {
+        return tr("Unknown speed");
+    }
+
+    speed /= 1024; // kB
+    if (speed < 1000) {
+        return QString::number(speed, 'f', 0) + QLatin1String(" ") + tr("kB/s");
+    }
+
+    speed /= 1024; //MB
+    if (speed < 1000) {
+        return QString::number(speed, 'f', 2) + QLatin1String(" ") + tr("MB/s");
+    }
+
+    speed /= 1024; //GB
+    return QString::number(speed, 'f', 2) + QLatin1String(" ") + tr("GB/s");
+}
+
+int DownloadsModel::progress(const Entry *entry) const
+{
+    return entry->totalBytes > 0 ? int(entry->receivedBytes * 100 / entry->totalBytes) : 0;
+}
+
+QString DownloadsModel::infoText(const Entry *entry) const
+{
+    const QString host = entry->url.host();
+
+    switch (entry->state) {
+    case Completed:
+        return tr("Done - %1 (%2)").arg(host, entry->endDate.toString(Qt::DefaultLocaleShortDate));
+
+    case Cancelled:
+        return tr("Cancelled - %1").arg(host);
+
+    case Interrupted:
+        return tr("Error - %1").arg(host);
+
+    default:
+        break;
+    }
+
+    if (entry->speed <= 0) {
+        return tr("Remaining time unavailable");
+    }
+
+    QTime time(0, 0, 0);
+    time = time.addSecs((entry->totalBytes - entry->receivedBytes) / entry->speed);
+
+    const QString speed = currentSpeedToString(entry->speed);
+    const QString currSize = QzTools::fileSizeToString(entry->receivedBytes);
+
+    if (entry->totalBytes <= 0) {
+        return tr("%2 - unknown size (%3)").arg(currSize, speed);
+    }
+
+    return tr("Remaining %1 - %2 of %3 (%4)").arg(remainingTimeToString(time), currSize,
+                                                   QzTools::fileSizeToString(entry->totalBytes), speed);
+}
+
+void DownloadsModel::storeEntry(Entry *entry)
+{
+    // Database is opened read-only in private mode
+    if (!mApp->isPrivate()) {
+        QSqlQuery query(SqlDatabase::instance()->database());
+        query.prepare(QSL("INSERT INTO downloads (url, path, state, received_bytes, total_bytes, start_date) VALUES (?, ?, ?, ?, ?, ?)"));
+        query.addBindValue(QString::fromUtf8(entry->url.toEncoded()));
+        query.addBindValue(entry->path);
+        query.addBindValue(Downloading);
+        query.addBindValue(entry->receivedBytes);
+        query.addBindValue(entry->totalBytes);
+        query.addBindValue(entry->startDate.toMSecsSinceEpoch());
+
+        if (query.exec()) {
+            entry->id = query.lastInsertId().toLongLong();
+            return;
+        }
+
+        qWarning() << "Failed to store download" << query.lastError().text();
+    }
+
+    // Negative ids of downloads that are not stored never collide with database ids
+    entry->id = --m_lastMemoryId;
+}
+
+int DownloadsModel::entryRow(const Entry *entry) const
+{
+    // Active downloads are at the top
+    for (int i = 0; i < m_entries.count(); ++i) {
+        if (m_entries.at(i) == entry) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+void DownloadsModel::downloadProgress(Entry *entry, qint64 received, qint64 total)
+{
+    if (!m_activeEntries.contains(entry)) {
+        return;
+    }
+
+    updateStats(entry, -1);
+
+    const qint64 elapsed = entry->timer.elapsed();
+    entry->speed = elapsed > 0 ? received * 1000.0 / elapsed : 0;
+    entry->receivedBytes = received;
+    entry->totalBytes = total;
+
+    updateStats(entry, 1);
+
+    // Views are updated from timerEvent
+    m_changedEntries.insert(entry);
+}
+
+void DownloadsModel::finished(Entry *entry)
+{
+    if (!m_activeEntries.contains(entry)) {
+        return;
+    }
+
+    updateStats(entry, -1);
+    m_activeEntries.remove(entry);
+    m_changedEntries.remove(entry);
+
+    if (entry->download) {
+        switch (entry->download->state()) {
+        case QWebEngineDownloadItem::DownloadCompleted:
+            entry->state = Completed;
+            break;
+        case QWebEngineDownloadItem::DownloadCancelled:
+            entry->state = Cancelled;
+            break;
+        default:
+            entry->state = Interrupted;
+            break;
+        }
+        entry->receivedBytes = entry->download->receivedBytes();
+        entry->totalBytes = entry->download->totalBytes();
+        entry->download->disconnect(this);
+    } else {
+        entry->state = Interrupted;
+    }
+
+    entry->endDate = QDateTime::currentDateTime();
+    entry->download.clear();
+
+    if (entry->id > 0) {
+        QSqlQuery query(SqlDatabase::instance()->database());
+        query.prepare(QSL("UPDATE downloads SET state=?, received_bytes=?, total_bytes=?, end_date=? WHERE id=?"));
+        query.addBindValue(entry->state);
+        query.addBindValue(entry->receivedBytes);
+        query.addBindValue(entry->totalBytes);
+        query.addBindValue(entry->endDate.toMSecsSinceEpoch());
+        query.addBindValue(entry->id);
+        query.exec();
+    }
+
+    if (m_activeEntries.isEmpty()) {
+        m_timer.stop();
+    }
+
+    const QModelIndex idx = index(entryRow(entry));
+    emit dataChanged(idx, idx);
+    emit countChanged();
+    emit downloadFinished(idx, entry->state == Completed, entry->openFile);
+}
+
+void DownloadsModel::updateStats(const Entry *entry, int sign)
+{
+    m_progressSum += sign * progress(entry);
+    m_speedSum += sign * entry->speed;
+    if (entry->totalBytes > 0) {
+        m_receivedSum += sign * entry->receivedBytes;
+        m_totalSum += sign * entry->totalBytes;
+    }
+}
+
+void DownloadsModel::removeRows(const QVector<int> &rows)
+{
+    // Rows are sorted, remove contiguous ranges from the end
+    int i = rows.count() - 1;
+    while (i >= 0) {
+        const int last = rows.at(i);
+        int first = last;
+        while (i > 0 && rows.at(i - 1) == first - 1) {
+            --i;
+            --first;
+        }
+        --i;
+
+        beginRemoveRows(QModelIndex(), first, last);
+        for (int row = first; row <= last; ++row) {
+            Entry *entry = m_entries.at(row);
+            m_loadedIds.remove(entry->id);
+            m_sessionIds.remove(entry->id);
+            delete entry;
+        }
+        m_entries.remove(first, last - first + 1);
+        endRemoveRows();
+    }
+
+    if (!rows.isEmpty()) {
+        emit countChanged();
+    }
+}
+
+void DownloadsModel::timerEvent(QTimerEvent *event)
+{
+    if (event->timerId() != m_timer.timerId()) {
+        QAbstractListModel::timerEvent(event);
+        return;
+    }
+
+    if (m_changedEntries.isEmpty()) {
+        return;
+    }
+
+    int first = -1;
+    int last = -1;
+    for (int i = 0; i < m_entries.count(); ++i) {
+        if (m_changedEntries.contains(m_entries.at(i))) {
+            if (first < 0) {
+                first = i;
+            }
+            last = i;
+            if (m_changedEntries.count() == 1) {
+                break;
+            }
+        }
+    }
+    m_changedEntries.clear();
+
+    if (first >= 0) {
+        emit dataChanged(index(first), index(last));
+    }
+
+    emit progressChanged();
+}
@@ -0,0 +1,161 @@
+/* ============================================================
+* Falkon - Qt web browser
+* Copyright (C) 2018 David Rosca <nowrep@gmail.com>
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program.  If not, see <http://www.gnu.org/licenses/>.
+* ============================================================ */
+#ifndef DOWNLOADSMODEL_H
+#define DOWNLOADSMODEL_H
+
+#include <QAbstractListModel>
+#include <QElapsedTimer>
+#include <QBasicTimer>
+#include <QDateTime>
+#include <QPointer>
+#include <QSet>
+#include <QUrl>
+
+#include "qzcommon.h"
+
+class QWebEngineDownloadItem;
+
+// Downloads of current session and download history stored in browsedata.db
+class FALKON_EXPORT DownloadsModel : public QAbstractListModel
+{
+    Q_OBJECT
+
+public:
+    enum Roles {
+        IdRole = Qt::UserRole + 1,
+        UrlRole = Qt::UserRole + 2,
+        PathRole = Qt::UserRole + 3,
+        FileNameRole = Qt::UserRole + 4,
+        StateRole = Qt::UserRole + 5,
+        ReceivedBytesRole = Qt::UserRole + 6,
+        TotalBytesRole = Qt::UserRole + 7,
+        SpeedRole = Qt::UserRole + 8,
+        ProgressRole = Qt::UserRole + 9,
+        StartDateRole = Qt::UserRole + 10,
+        EndDateRole = Qt::UserRole + 11,
+        InfoRole = Qt::UserRole + 12
+    };
+
+    // Values are stored in database
+    enum State {
+        Downloading = 0,
+        Completed = 1,
+        Cancelled = 2,
+        Interrupted = 3
+    };
+
+    struct Statistics {
+        int count = 0;
+        int completed = 0;
+        int failed = 0;
+        qint64 completedBytes = 0;
+    };
+
+    explicit DownloadsModel(QObject *parent = nullptr);
+    ~DownloadsModel();
+
+    int rowCount(const QModelIndex &parent = QModelIndex()) const override;
+    QVariant data(const QModelIndex &index, int role = Qt::DisplayRole) const override;
+
+    bool canFetchMore(const QModelIndex &parent) const override;
+    void fetchMore(const QModelIndex &parent) override;
+
+    // Inserts new download to the top, download must already be accepted
+    QModelIndex addDownload(QWebEngineDownloadItem *download, bool openFile);
+    void cancelDownload(const QModelIndex &index);
+
+    void removeDownload(const QModelIndex &index);
+    // Removes all finished downloads, or only those started before olderThan
+    // and not before newerThan
+    void removeFinished(const QDateTime &olderThan = QDateTime(), const QDateTime &newerThan = QDateTime());
+
+    QString filter() const;
+    void setFilter(const QString &filter);
+
+    Statistics statistics() const;
+
+    // Number of downloads started in this session that are still listed
+    int sessionCount() const;
+    int activeCount() const;
+
+    // Aggregates over active downloads
+    int totalProgress() const;
+    double totalSpeed() const;
+    QTime remainingTime() const;
+
+    static QString remainingTimeToString(QTime time);
+    static QString currentSpeedToString(double speed);
+
+Q_SIGNALS:
+    void downloadFinished(const QModelIndex &index, bool success, bool openFile);
+    void countChanged();
+    // Emitted at most once per update interval while downloads are active
+    void progressChanged();
+
+private:
+    struct Entry {
+        qint64 id = 0;
+        QUrl url;
+        QString path;
+        State state = Downloading;
+        qint64 receivedBytes = 0;
+        qint64 totalBytes = 0;
+        double speed = 0;
+        QDateTime startDate;
+        QDateTime endDate;
+        bool openFile = false;
+        QElapsedTimer timer;
+        QPointer<QWebEngineDownloadItem> download;
+    };
+
+    int progress(const Entry *entry) const;
+    QString infoText(const Entry *entry) const;
+    int entryRow(const Entry *entry) const;
+
+    // Stores new entry in database and assigns its id
+    void storeEntry(Entry *entry);
+
+    void downloadProgress(Entry *entry, qint64 received, qint64 total);
+    void finished(Entry *entry);
+    void updateStats(const Entry *entry, int sign);
+    void removeRows(const QVector<int> &rows);
+
+    void timerEvent(QTimerEvent *event) override;
+
+    friend class DownloadsModelTest;
+
+    QVector<Entry*> m_entries;
+    QSet<Entry*> m_activeEntries;
+    QSet<Entry*> m_changedEntries;
+    QSet<qint64> m_loadedIds;
+    QSet<qint64> m_sessionIds;
+    QBasicTimer m_timer;
+
+    QString m_filter;
+    qint64 m_lastFetchedId;
+    qint64 m_lastMemoryId = 0;
+    bool m_canFetchMore = true;
+
+    // Running totals over active downloads
+    int m_progressSum = 0;
+    double m_speedSum = 0;
+    qint64 m_receivedSum = 0;
+    qint64 m_totalSum = 0;
+};
+
+#endif // DOWNLOADSMODEL_H
@@ -16,6 +16,7 @@
 * along with this program.  If not, see <http://www.gnu.org/licenses/>.
 * ============================================================ */
 #include "history.h"
+#include "historydeletejob.h"
 #include "historymodel.h"
 #include "browserwindow.h"
 #include "iconprovider.h"
@@ -23,8 +24,89 @@
 #include "mainapplication.h"
 #include "sqldatabase.h"
 #include "webview.h"
+#include "webpage.h"
 
+#include <QTimer>
+#include <QFutureWatcher>
 #include <QWebEngineProfile>
+#include <QtConcurrent/QtConcurrentRun>
+
+#include <algorithm>
+#include <cmath>
+
+// Frecency of all entries is multiplied by this factor for every day passed
+static const double frecencyDailyDecay = 0.975;
+
+// Visits are written to database in batches
+static const int visitsWriteDelay = 5 * 1000;
+
+static const int frecencyDecayInterval = 6 * 60 * 60 * 1000;
+
+// Space freed by deleted entries is reclaimed this long after the last deletion
+static const int compactDatabaseDelay = 30 * 1000;
+
+// Free pages released per incremental_vacuum step, each step locks the database only briefly
+static const int vacuumStepPages = 100;
+
+bool History::s_hasFrecency = false;
+
+static History::VisitTransition transitionFromNavigationType(QWebEnginePage::NavigationType type)
+{
+    switch (type) {
+    case QWebEnginePage::NavigationTypeLinkClicked:
+        return History::LinkTransition;
+    case QWebEnginePage::NavigationTypeTyped:
+        return History::TypedTransition;
+    case QWebEnginePage::NavigationTypeFormSubmitted:
+        return History::FormTransition;
+    case QWebEnginePage::NavigationTypeBackForward:
+        return History::BackForwardTransition;
+    case QWebEnginePage::NavigationTypeReload:
+        return History::ReloadTransition;
+    default:
+        return History::OtherTransition;
+    }
+}
+
+static void insertVisits(QSqlDatabase db, const QVector<QVariantList> &visits)
+{
+    db.transaction();
+
+    QSqlQuery query(db);
+    query.prepare(QSL("INSERT INTO history_visits (history_id, date, transition, referrer) VALUES (?, ?, ?, ?)"));
+
+    for (const QVariantList &visit : visits) {
+        for (int i = 0; i < visit.size(); ++i) {
+            query.bindValue(i, visit.at(i));
+        }
+        query.exec();
+    }
+
+    db.commit();
+}
+
+static bool releaseFreePages()
+{
+    QSqlQuery query(SqlDatabase::instance()->database());
+    int freePages = -1;
+
+    while (true) {
+        if (!query.exec(QSL("PRAGMA incremental_vacuum(%1)").arg(vacuumStepPages))) {
+            qWarning() << "Failed to compact database" << query.lastError().text();
+            return false;
+        }
+        // Pages are released while stepping the statement
+        while (query.next()) {
+        }
+
+        query.exec(QSL("PRAGMA freelist_count"));
+        const int remaining = query.next() ? query.value(0).toInt() : 0;
+        if (remaining == 0 || remaining == freePages) {
+            return true;
+        }
+        freePages = remaining;
+    }
+}
 
 History::History(QObject* parent)
     : QObject(parent)
@@ -32,6 +114,60 @@ History::History(QObject* parent)
     , m_model(0)
 {
     loadSettings();
+    init();
+
+    m_visitsTimer = new QTimer(this);
+    m_visitsTimer->setSingleShot(true);
+    m_visitsTimer->setInterval(visitsWriteDelay);
+    connect(m_visitsTimer, &QTimer::timeout, this, &History::writePendingVisits);
+
+    m_decayTimer = new QTimer(this);
+    m_decayTimer->setInterval(frecencyDecayInterval);
+    connect(m_decayTimer, &QTimer::timeout, this, &History::decayFrecency);
+    m_decayTimer->start();
+
+    m_compactTimer = new QTimer(this);
+    m_compactTimer->setSingleShot(true);
+    m_compactTimer->setInterval(compactDatabaseDelay);
+    connect(m_compactTimer, &QTimer::timeout, this, &History::compactDatabase);
+
+    m_compactWatcher = new QFutureWatcher<bool>(this);
+    connect(m_compactWatcher, &QFutureWatcherBase::finished, this, &History::databaseCompacted);
+
+    // Don't slow down startup
+    QTimer::singleShot(60 * 1000, this, &History::decayFrecency);
+
+    // Compaction interrupted by quitting the browser
+    if (Settings().value(QSL("Web-Browser-Settings/compactDatabase"), false).toBool()) {
+        m_compactTimer->start();
+    }
+}
+
+History::~History()
+{
+    if (!m_pendingVisits.isEmpty()) {
+        QVector<QVariantList> visits;
+        visits.reserve(m_pendingVisits.size());
+        for (const Visit &visit : qAsConst(m_pendingVisits)) {
+            visits.append({visit.historyId, visit.date, int(visit.transition), visit.referrer});
+        }
+        insertVisits(SqlDatabase::instance()->database(), visits);
+    }
+
+    if (m_vacuumOnExit) {
+        vacuumDatabase();
+    }
+}
+
+void History::init()
+{
+    QSqlDatabase db = SqlDatabase::instance()->database();
+    if (!db.isOpen()) {
+        return;
+    }
+
+    // Schema is migrated by ProfileManager, except for read-only databases in private mode
+    s_hasFrecency = db.record(QSL("history")).contains(QSL("frecency"));
 }
 
 HistoryModel* History::model()
@@ -60,11 +196,12 @@ void History::addHistoryEntry(WebView* view)
 
     const QUrl url = view->url();
     const QString title = view->title();
+    const WebPage* page = view->page();
 
-    addHistoryEntry(url, title);
+    addHistoryEntry(url, title, transitionFromNavigationType(page->lastNavigationType()), page->lastNavigationReferrer());
 }
 
-void History::addHistoryEntry(const QUrl &url, QString title)
+void History::addHistoryEntry(const QUrl &url, QString title, VisitTransition transition, const QUrl &referrer)
 {
     if (!m_isSaving) {
         return;
@@ -85,12 +222,17 @@ void History::addHistoryEntry(const QUrl &url, QString title)
     auto job = new SqlQueryJob(QSL("SELECT id, count, date, title FROM history WHERE url=?"), this);
     job->addBindValue(url);
     connect(job, &SqlQueryJob::finished, this, [=]() {
+        const qint64 visitDate = QDateTime::currentMSecsSinceEpoch();
+
         if (job->records().isEmpty()) {
-            auto job = new SqlQueryJob(QSL("INSERT INTO history (count, date, url, title) VALUES (1,?,?,?)"), this);
-            job->addBindValue(QDateTime::currentMSecsSinceEpoch());
+            auto job = new SqlQueryJob(QSL("INSERT INTO history (count, date, url, title, frecency) VALUES (1,?,?,?,?)"), this);
+            job->addBindValue(visitDate);
             job->addBindValue(url);
             job->addBindValue(title);
+            job->addBindValue(visitFrecency(transition));
             connect(job, &SqlQueryJob::finished, this, [=]() {
+                addVisit(job->lastInsertId().toInt(), visitDate, transition, referrer);
+
                 HistoryEntry entry;
                 entry.id = job->lastInsertId().toInt();
                 entry.count = 1;
@@ -108,11 +250,14 @@ void History::addHistoryEntry(const QUrl &url, QString title)
             const QDateTime date = QDateTime::fromMSecsSinceEpoch(record.value(2).toLongLong());
             const QString oldTitle = record.value(3).toString();
 
-            auto job = new SqlQueryJob(QSL("UPDATE history SET count = count + 1, date=?, title=? WHERE url=?"), this);
-            job->addBindValue(QDateTime::currentMSecsSinceEpoch());
+            auto job = new SqlQueryJob(QSL("UPDATE history SET count = count + 1, date=?, title=?, frecency = frecency + ? WHERE url=?"), this);
+            job->addBindValue(visitDate);
             job->addBindValue(title);
+            job->addBindValue(visitFrecency(transition));
             job->addBindValue(url);
             connect(job, &SqlQueryJob::finished, this, [=]() {
+                addVisit(id, visitDate, transition, referrer);
+
                 HistoryEntry before;
                 before.id = id;
                 before.count = count;
@@ -135,49 +280,41 @@ void History::addHistoryEntry(const QUrl &url, QString title)
 }
 
 // DeleteHistoryEntry
-void History::deleteHistoryEntry(int index)
+HistoryDeleteJob *History::deleteHistoryEntry(int index)
 {
     QList<int> list;
     list.append(index);
 
-    deleteHistoryEntry(list);
+    return deleteHistoryEntry(list);
 }
 
-void History::deleteHistoryEntry(const QList<int> &list)
+HistoryDeleteJob *History::deleteHistoryEntry(const QList<int> &list)
 {
-    QSqlDatabase db = SqlDatabase::instance()->database();
-    db.transaction();
+    // Visits of deleted entries must not be written after them
+    removePendingVisits(list.toSet());
 
-    foreach (int index, list) {
-        QSqlQuery query(SqlDatabase::instance()->database());
-        query.prepare("SELECT count, date, url, title FROM history WHERE id=?");
-        query.addBindValue(index);
-        query.exec();
+    HistoryDeleteJob *job = new HistoryDeleteJob(list, this);
 
-        if (!query.isActive() || !query.next()) {
-            continue;
+    connect(job, &HistoryDeleteJob::entriesDeleted, this, [this](const QVector<HistoryEntry> &entries) {
+        QSet<int> ids;
+        for (const HistoryEntry &entry : entries) {
+            ids.insert(entry.id);
         }
+        // Entries may have been visited again while the job was running
+        removePendingVisits(ids);
 
-        HistoryEntry entry;
-        entry.id = index;
-        entry.count = query.value(0).toInt();
-        entry.date = QDateTime::fromMSecsSinceEpoch(query.value(1).toLongLong());
-        entry.url = query.value(2).toUrl();
-        entry.urlString = entry.url.toEncoded();
-        entry.title = query.value(3).toString();
-
-        query.prepare("DELETE FROM history WHERE id=?");
-        query.addBindValue(index);
-        query.exec();
-
-        query.prepare("DELETE FROM icons WHERE url=?");
-        query.addBindValue(entry.url.toEncoded(QUrl::RemoveFragment));
-        query.exec();
+        emit historyEntriesDeleted(entries);
+        for (const HistoryEntry &entry : entries) {
+            emit historyEntryDeleted(entry);
+        }
+    });
 
-        emit historyEntryDeleted(entry);
-    }
+    // Remember compaction now, and postpone it until the job has finished
+    scheduleDatabaseCompaction();
+    connect(job, &HistoryDeleteJob::finished, this, &History::scheduleDatabaseCompaction);
 
-    db.commit();
+    job->start();
+    return job;
 }
 
 void History::deleteHistoryEntry(const QString &url)
@@ -230,12 +367,13 @@ QVector<HistoryEntry> History::mostVisited(int count)
 {
     QVector<HistoryEntry> list;
     QSqlQuery query(SqlDatabase::instance()->database());
-    query.prepare(QString("SELECT count, date, id, title, url FROM history ORDER BY count DESC LIMIT %1").arg(count));
+    query.prepare(QSL("SELECT count, date, id, title, url FROM history ORDER BY %1 DESC LIMIT ?").arg(hasFrecency() ? QSL("frecency") : QSL("count")));
+    query.addBindValue(count);
     query.exec();
     while (query.next()) {
         HistoryEntry entry;
         entry.count = query.value(0).toInt();
-        entry.date = query.value(1).toDateTime();
+        entry.date = QDateTime::fromMSecsSinceEpoch(query.value(1).toLongLong());
         entry.id = query.value(2).toInt();
         entry.title = query.value(3).toString();
         entry.url = query.value(4).toUrl();
@@ -244,15 +382,115 @@ QVector<HistoryEntry> History::mostVisited(int count)
     return list;
 }
 
-void History::clearHistory()
+HistoryDeleteJob *History::clearHistory()
 {
-    QSqlQuery query(SqlDatabase::instance()->database());
-    query.exec(QSL("DELETE FROM history"));
-    query.exec(QSL("VACUUM"));
+    m_pendingVisits.clear();
 
     mApp->webProfile()->clearAllVisitedLinks();
 
-    emit resetHistory();
+    HistoryDeleteJob *job = new HistoryDeleteJob(this);
+    connect(job, &HistoryDeleteJob::finished, this, &History::resetHistory);
+
+    scheduleDatabaseCompaction();
+    connect(job, &HistoryDeleteJob::finished, this, &History::scheduleDatabaseCompaction);
+
+    job->start();
+    return job;
+}
+
+// static
+int History::visitFrecency(VisitTransition transition)
+{
+    // Visit of today is worth 100 points, weighted by how the page was opened
+    switch (transition) {
+    case TypedTransition:
+        return 200;
+    case LinkTransition:
+    case FormTransition:
+        return 100;
+    case BackForwardTransition:
+        return 50;
+    case ReloadTransition:
+        return 0;
+    default:
+        return 75;
+    }
+}
+
+// static
+bool History::hasFrecency()
+{
+    return s_hasFrecency;
+}
+
+void History::addVisit(int historyId, qint64 date, VisitTransition transition, const QUrl &referrer)
+{
+    Visit visit;
+    visit.historyId = historyId;
+    visit.date = date;
+    visit.transition = transition;
+    visit.referrer = QString::fromUtf8(referrer.toEncoded());
+    m_pendingVisits.append(visit);
+
+    if (!m_visitsTimer->isActive()) {
+        m_visitsTimer->start();
+    }
+}
+
+void History::removePendingVisits(const QSet<int> &historyIds)
+{
+    auto it = std::remove_if(m_pendingVisits.begin(), m_pendingVisits.end(), [&historyIds](const Visit &visit) {
+        return historyIds.contains(visit.historyId);
+    });
+    m_pendingVisits.erase(it, m_pendingVisits.end());
+}
+
+void History::writePendingVisits()
+{
+    if (m_pendingVisits.isEmpty()) {
+        return;
+    }
+
+    QVector<QVariantList> visits;
+    visits.reserve(m_pendingVisits.size());
+    for (const Visit &visit : qAsConst(m_pendingVisits)) {
+        visits.append({visit.historyId, visit.date, int(visit.transition), visit.referrer});
+    }
+    m_pendingVisits.clear();
+
+    QtConcurrent::run([visits]() {
+        insertVisits(SqlDatabase::instance()->database(), visits);
+    });
+}
+
+void History::decayFrecency()
+{
+    if (mApp->isPrivate()) {
+        return;
+    }
+
+    const qint64 now = QDateTime::currentMSecsSinceEpoch();
+    const qint64 day = 24 * 60 * 60 * 1000;
+
+    Settings settings;
+    settings.beginGroup(QSL("Web-Browser-Settings"));
+    const qint64 lastDecay = settings.value(QSL("lastFrecencyDecay"), now).toLongLong();
+
+    const qint64 days = (now - lastDecay) / day;
+    if (days < 1) {
+        if (!settings.contains(QSL("lastFrecencyDecay"))) {
+            settings.setValue(QSL("lastFrecencyDecay"), now);
+        }
+        settings.endGroup();
+        return;
+    }
+
+    settings.setValue(QSL("lastFrecencyDecay"), lastDecay + days * day);
+    settings.endGroup();
+
+    auto job = new SqlQueryJob(QSL("UPDATE history SET frecency = CAST(frecency * ? AS INTEGER) WHERE frecency > 0"), this);
+    job->addBindValue(std::pow(frecencyDailyDecay, double(days)));
+    job->start();
 }
 
 void History::setSaving(bool state)
@@ -335,3 +573,54 @@ HistoryEntry History::getHistoryEntry(const QString &text)
     }
     return entry;
 }
+
+void History::scheduleDatabaseCompaction()
+{
+    if (mApp->isPrivate()) {
+        return;
+    }
+
+    // Remember it, so compaction is not lost when the browser quits before the timer fires
+    Settings().setValue(QSL("Web-Browser-Settings/compactDatabase"), true);
+    m_compactTimer->start();
+}
+
+void History::compactDatabase()
+{
+    if (mApp->isPrivate() || m_compactWatcher->isRunning()) {
+        return;
+    }
+
+    QSqlQuery query(SqlDatabase::instance()->database());
+    query.exec(QSL("PRAGMA auto_vacuum"));
+
+    // 2 = INCREMENTAL, free pages can be released in small steps
+    if (query.next() && query.value(0).toInt() == 2) {
+        m_compactWatcher->setFuture(QtConcurrent::run(&releaseFreePages));
+        return;
+    }
+
+    // Switching auto_vacuum mode of existing database requires full VACUUM. It locks
+    // the database for its whole duration, so it is done once on exit instead.
+    m_vacuumOnExit = true;
+}
+
+void History::databaseCompacted()
+{
+    if (m_compactWatcher->result()) {
+        Settings().setValue(QSL("Web-Browser-Settings/compactDatabase"), false);
+    }
+}
+
+void History::vacuumDatabase()
+{
+    QSqlQuery query(SqlDatabase::instance()->database());
+    query.exec(QSL("PRAGMA auto_vacuum = INCREMENTAL"));
+
+    if (!query.exec(QSL("VACUUM"))) {
+        qWarning() << "Failed to vacuum database" << query.lastError().text();
+        return;
+    }
+
+    Settings().setValue(QSL("Web-Browser-Settings/compactDatabase"), false);
+}
@@ -22,19 +22,37 @@
 #include <QList>
 #include <QDateTime>
 #include <QUrl>
+#include <QVector>
+#include <QSet>
 
 #include "qzcommon.h"
 
 class QIcon;
+class QTimer;
 
 class WebView;
 class HistoryModel;
+class HistoryDeleteJob;
+
+template <typename T>
+class QFutureWatcher;
 
 class FALKON_EXPORT History : public QObject
 {
     Q_OBJECT
 public:
     History(QObject* parent);
+    ~History();
+
+    // Stored in history_visits table, do not change the values
+    enum VisitTransition {
+        LinkTransition = 0,
+        TypedTransition = 1,
+        FormTransition = 2,
+        BackForwardTransition = 3,
+        ReloadTransition = 4,
+        OtherTransition = 5
+    };
 
     struct HistoryEntry {
         int id;
@@ -50,18 +68,27 @@ public:
     HistoryModel* model();
 
     void addHistoryEntry(WebView* view);
-    void addHistoryEntry(const QUrl &url, QString title);
+    void addHistoryEntry(const QUrl &url, QString title, VisitTransition transition = LinkTransition, const QUrl &referrer = QUrl());
 
-    void deleteHistoryEntry(int index);
-    void deleteHistoryEntry(const QList<int> &list);
+    // Entries are deleted asynchronously, the returned job deletes itself when finished
+    HistoryDeleteJob *deleteHistoryEntry(int index);
+    HistoryDeleteJob *deleteHistoryEntry(const QList<int> &list);
     void deleteHistoryEntry(const QString &url);
     void deleteHistoryEntry(const QString &url, const QString &title);
 
     QList<int> indexesFromTimeRange(qint64 start, qint64 end);
 
+    // Ordered by frecency
     QVector<HistoryEntry> mostVisited(int count);
 
-    void clearHistory();
+    // Frecency points a new visit adds to the history entry
+    static int visitFrecency(VisitTransition transition);
+
+    // Read-only databases that were never migrated have no frecency column
+    static bool hasFrecency();
+
+    // Entries are deleted asynchronously, the returned job deletes itself when finished
+    HistoryDeleteJob *clearHistory();
     bool isSaving();
     void setSaving(bool state);
 
@@ -73,13 +100,42 @@ public:
 Q_SIGNALS:
     void historyEntryAdded(const HistoryEntry &entry);
     void historyEntryDeleted(const HistoryEntry &entry);
+    void historyEntriesDeleted(const QVector<HistoryEntry> &entries);
     void historyEntryEdited(const HistoryEntry &before, const HistoryEntry &after);
 
     void resetHistory();
 
+private Q_SLOTS:
+    void writePendingVisits();
+    void decayFrecency();
+    void compactDatabase();
+
 private:
+    struct Visit {
+        int historyId;
+        qint64 date;
+        VisitTransition transition;
+        QString referrer;
+    };
+
+    void init();
+    void addVisit(int historyId, qint64 date, VisitTransition transition, const QUrl &referrer);
+    void removePendingVisits(const QSet<int> &historyIds);
+    void scheduleDatabaseCompaction();
+    void databaseCompacted();
+    void vacuumDatabase();
+
     bool m_isSaving;
     HistoryModel* m_model;
+
+    QVector<Visit> m_pendingVisits;
+    QTimer* m_visitsTimer;
+    QTimer* m_decayTimer;
+    QTimer* m_compactTimer;
+    QFutureWatcher<bool>* m_compactWatcher;
+    bool m_vacuumOnExit = false;
+
+    static bool s_hasFrecency;
 };
 
 typedef History::HistoryEntry HistoryEntry;
@@ -87,4 +143,6 @@ typedef History::HistoryEntry HistoryEntry;
 // Hint to QVector to use std::realloc on item moving
 Q_DECLARE_TYPEINFO(HistoryEntry, Q_MOVABLE_TYPE);
 
+Q_DECLARE_METATYPE(HistoryEntry)
+
 #endif // HISTORY_H
@@ -0,0 +1,195 @@
+/* ============================================================
+* Falkon - Qt web browser
+* Copyright (C) 2018 David Rosca <nowrep@gmail.com>
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program.  If not, see <http://www.gnu.org/licenses/>.
+* ============================================================ */
+#include "historydeletejob.h"
+#include "sqldatabase.h"
+
+#include <QDebug>
+#include <QFutureWatcher>
+#include <QtConcurrent/QtConcurrentRun>
+
+// SQLite allows at most 999 bound values in one statement
+static const int chunkSize = 500;
+
+static QString placeholders(int count)
+{
+    QString out;
+    out.reserve(count * 2);
+    for (int i = 0; i < count; ++i) {
+        out.append(i == 0 ? QL1S("?") : QL1S(",?"));
+    }
+    return out;
+}
+
+HistoryDeleteJob::HistoryDeleteJob(QObject *parent)
+    : HistoryDeleteJob(QList<int>(), parent)
+{
+    m_clearAll = true;
+}
+
+HistoryDeleteJob::HistoryDeleteJob(const QList<int> &ids, QObject *parent)
+    : QObject(parent)
+    , m_ids(ids)
+{
+    qRegisterMetaType<QVector<HistoryEntry>>();
+
+    connect(this, &HistoryDeleteJob::chunkDeleted, this, &HistoryDeleteJob::applyChunk, Qt::QueuedConnection);
+}
+
+HistoryDeleteJob::~HistoryDeleteJob()
+{
+    cancel();
+    m_future.waitForFinished();
+}
+
+int HistoryDeleteJob::total() const
+{
+    return m_ids.size();
+}
+
+int HistoryDeleteJob::processed() const
+{
+    return m_processed;
+}
+
+bool HistoryDeleteJob::isCanceled() const
+{
+    return m_canceled.load();
+}
+
+bool HistoryDeleteJob::isFinished() const
+{
+    return m_finished;
+}
+
+void HistoryDeleteJob::start()
+{
+    auto watcher = new QFutureWatcher<void>(this);
+    connect(watcher, &QFutureWatcher<void>::finished, this, [this]() {
+        m_finished = true;
+        emit finished();
+        deleteLater();
+    });
+
+    m_future = QtConcurrent::run(this, &HistoryDeleteJob::run);
+    watcher->setFuture(m_future);
+}
+
+void HistoryDeleteJob::waitForFinished()
+{
+    m_future.waitForFinished();
+}
+
+void HistoryDeleteJob::cancel()
+{
+    m_canceled.store(1);
+}
+
+void HistoryDeleteJob::run()
+{
+    if (m_clearAll) {
+        clearAll();
+        return;
+    }
+
+    QSqlDatabase db = SqlDatabase::instance()->database();
+
+    for (int i = 0; i < m_ids.size() && !m_canceled.load(); i += chunkSize) {
+        const QList<int> chunk = m_ids.mid(i, chunkSize);
+        const QString idPlaceholders = placeholders(chunk.size());
+
+        db.transaction();
+
+        QSqlQuery query(db);
+        query.prepare(QSL("SELECT id, count, date, url, title FROM history WHERE id IN (%1)").arg(idPlaceholders));
+        for (int id : chunk) {
+            query.addBindValue(id);
+        }
+        query.exec();
+
+        QVector<HistoryEntry> entries;
+        QVariantList iconUrls;
+        while (query.next()) {
+            HistoryEntry entry;
+            entry.id = query.value(0).toInt();
+            entry.count = query.value(1).toInt();
+            entry.date = QDateTime::fromMSecsSinceEpoch(query.value(2).toLongLong());
+            entry.url = query.value(3).toUrl();
+            entry.urlString = entry.url.toEncoded();
+            entry.title = query.value(4).toString();
+            entries.append(entry);
+            iconUrls.append(entry.url.toEncoded(QUrl::RemoveFragment));
+        }
+
+        query.prepare(QSL("DELETE FROM history WHERE id IN (%1)").arg(idPlaceholders));
+        for (int id : chunk) {
+            query.addBindValue(id);
+        }
+        query.exec();
+
+        query.prepare(QSL("DELETE FROM history_visits WHERE history_id IN (%1)").arg(idPlaceholders));
+        for (int id : chunk) {
+            query.addBindValue(id);
+        }
+        query.exec();
+
+        if (!iconUrls.isEmpty()) {
+            query.prepare(QSL("DELETE FROM icons WHERE url IN (%1)").arg(placeholders(iconUrls.size())));
+            for (const QVariant &url : qAsConst(iconUrls)) {
+                query.addBindValue(url);
+            }
+            query.exec();
+        }
+
+        if (!db.commit()) {
+            qWarning() << "Failed to delete history entries" << db.lastError().text();
+            db.rollback();
+            return;
+        }
+
+        emit chunkDeleted(entries, i + chunk.size());
+    }
+}
+
+void HistoryDeleteJob::clearAll()
+{
+    if (m_canceled.load()) {
+        return;
+    }
+
+    QSqlDatabase db = SqlDatabase::instance()->database();
+    db.transaction();
+
+    QSqlQuery query(db);
+    query.exec(QSL("DELETE FROM history"));
+    query.exec(QSL("DELETE FROM history_visits"));
+
+    if (!db.commit()) {
+        qWarning() << "Failed to clear history" << db.lastError().text();
+        db.rollback();
+    }
+}
+
+void HistoryDeleteJob::applyChunk(const QVector<HistoryEntry> &entries, int processed)
+{
+    m_processed = processed;
+
+    if (!entries.isEmpty()) {
+        emit entriesDeleted(entries);
+    }
+    emit progress(m_processed, total());
+}
@@ -0,0 +1,75 @@
+/* ============================================================
+* Falkon - Qt web browser
+* Copyright (C) 2018 David Rosca <nowrep@gmail.com>
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program.  If not, see <http://www.gnu.org/licenses/>.
+* ============================================================ */
+#ifndef HISTORYDELETEJOB_H
+#define HISTORYDELETEJOB_H
+
+#include <QObject>
+#include <QAtomicInt>
+#include <QFuture>
+#include <QVector>
+
+#include "qzcommon.h"
+#include "history.h"
+
+// Deletes history entries on a worker thread, in chunks of one transaction each
+class FALKON_EXPORT HistoryDeleteJob : public QObject
+{
+    Q_OBJECT
+
+public:
+    // Deletes whole history
+    explicit HistoryDeleteJob(QObject *parent = nullptr);
+    explicit HistoryDeleteJob(const QList<int> &ids, QObject *parent = nullptr);
+    ~HistoryDeleteJob();
+
+    int total() const;
+    int processed() const;
+
+    bool isCanceled() const;
+    bool isFinished() const;
+
+    void start();
+    // Blocks until the worker is done, for use when there is no event loop
+    void waitForFinished();
+
+public Q_SLOTS:
+    // Already deleted chunks stay deleted
+    void cancel();
+
+Q_SIGNALS:
+    void entriesDeleted(const QVector<HistoryEntry> &entries);
+    void progress(int processed, int total);
+    void finished();
+
+    // Emitted from worker thread
+    void chunkDeleted(const QVector<HistoryEntry> &entries, int processed);
+
+private:
+    void run();
+    void clearAll();
+    void applyChunk(const QVector<HistoryEntry> &entries, int processed);
+
+    QList<int> m_ids;
+    bool m_clearAll = false;
+    QAtomicInt m_canceled;
+    QFuture<void> m_future;
+    int m_processed = 0;
+    bool m_finished = false;
+};
+
+#endif // HISTORYDELETEJOB_H
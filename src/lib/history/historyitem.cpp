@@ -57,6 +57,16 @@ void HistoryItem::prependChild(HistoryItem* child)
     m_children.prepend(child);
 }
 
+void HistoryItem::prependChildren(const QList<HistoryItem*> &children)
+{
+    for (HistoryItem* child : children) {
+        Q_ASSERT(!m_children.contains(child));
+        child->m_parent = this;
+    }
+
+    m_children = children + m_children;
+}
+
 void HistoryItem::appendChild(HistoryItem* child)
 {
     if (m_children.contains(child)) {
@@ -36,6 +36,7 @@ public:
     int childCount() const;
 
     void prependChild(HistoryItem* child);
+    void prependChildren(const QList<HistoryItem*> &children);
     void appendChild(HistoryItem* child);
     void insertChild(int row, HistoryItem* child);
 
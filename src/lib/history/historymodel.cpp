@@ -24,6 +24,8 @@
 #include <QDateTime>
 #include <QTimer>
 
+#include <algorithm>
+
 static QString dateTimeToString(const QDateTime &dateTime)
 {
     const QDateTime current = QDateTime::currentDateTime();
@@ -44,7 +46,7 @@ HistoryModel::HistoryModel(History* history)
 
     connect(m_history, &History::resetHistory, this, &HistoryModel::resetHistory);
     connect(m_history, &History::historyEntryAdded, this, &HistoryModel::historyEntryAdded);
-    connect(m_history, &History::historyEntryDeleted, this, &HistoryModel::historyEntryDeleted);
+    connect(m_history, &History::historyEntriesDeleted, this, &HistoryModel::historyEntriesDeleted);
     connect(m_history, &History::historyEntryEdited, this, &HistoryModel::historyEntryEdited);
 }
 
@@ -260,6 +262,9 @@ void HistoryModel::removeTopLevelIndexes(const QList<QPersistentModelIndex> &ind
 
 void HistoryModel::resetHistory()
 {
+    m_pendingEntries.clear();
+    m_pendingRemovals.clear();
+
     beginResetModel();
 
     delete m_rootItem;
@@ -319,7 +324,9 @@ void HistoryModel::fetchMore(const QModelIndex &parent)
         return;
     }
 
-    beginInsertRows(parent, 0, list.size() - 1);
+    // Fetched entries are older than the ones already in bucket
+    const int first = parentItem->childCount();
+    beginInsertRows(parent, first, first + list.size() - 1);
 
     foreach (const HistoryEntry &entry, list) {
         HistoryItem* newItem = new HistoryItem(parentItem);
@@ -331,6 +338,77 @@ void HistoryModel::fetchMore(const QModelIndex &parent)
 
 void HistoryModel::historyEntryAdded(const HistoryEntry &entry)
 {
+    m_pendingEntries.append(entry);
+    scheduleFlush();
+}
+
+void HistoryModel::historyEntriesDeleted(const QVector<HistoryEntry> &entries)
+{
+    // Pending entries may refer to the deleted ones, apply them first
+    flushPendingEntries();
+
+    removeHistoryItems(entries);
+}
+
+void HistoryModel::historyEntryEdited(const HistoryEntry &before, const HistoryEntry &after)
+{
+    // Edited entry is moved to the top of Today, same as a new visit
+    m_pendingRemovals.append(before);
+    m_pendingEntries.append(after);
+    scheduleFlush();
+}
+
+void HistoryModel::scheduleFlush()
+{
+    if (m_flushScheduled) {
+        return;
+    }
+
+    m_flushScheduled = true;
+    QTimer::singleShot(0, this, &HistoryModel::flushPendingEntries);
+}
+
+void HistoryModel::flushPendingEntries()
+{
+    m_flushScheduled = false;
+
+    if (m_pendingEntries.isEmpty() && m_pendingRemovals.isEmpty()) {
+        return;
+    }
+
+    // Keep only the latest version of each entry
+    QHash<int, int> latest;
+    latest.reserve(m_pendingEntries.size());
+    for (int i = 0; i < m_pendingEntries.size(); ++i) {
+        latest.insert(m_pendingEntries.at(i).id, i);
+    }
+
+    QVector<HistoryEntry> entries;
+    entries.reserve(latest.size());
+    for (int i = 0; i < m_pendingEntries.size(); ++i) {
+        if (latest.value(m_pendingEntries.at(i).id) == i) {
+            entries.append(m_pendingEntries.at(i));
+        }
+    }
+
+    const QVector<HistoryEntry> removals = m_pendingRemovals;
+    m_pendingEntries.clear();
+    m_pendingRemovals.clear();
+
+    std::stable_sort(entries.begin(), entries.end(), [](const HistoryEntry &a, const HistoryEntry &b) {
+        return a.date > b.date;
+    });
+
+    removeHistoryItems(removals);
+    insertTodayItems(entries);
+}
+
+void HistoryModel::insertTodayItems(const QVector<HistoryEntry> &entries)
+{
+    if (entries.isEmpty()) {
+        return;
+    }
+
     if (!m_todayItem) {
         beginInsertRows(QModelIndex(), 0, 0);
 
@@ -344,58 +422,63 @@ void HistoryModel::historyEntryAdded(const HistoryEntry &entry)
         endInsertRows();
     }
 
-    beginInsertRows(createIndex(0, 0, m_todayItem), 0, 0);
-
-    HistoryItem* item = new HistoryItem();
-    item->historyEntry = entry;
-
-    m_todayItem->prependChild(item);
+    QList<HistoryItem*> items;
+    items.reserve(entries.size());
+    for (const HistoryEntry &entry : entries) {
+        HistoryItem* item = new HistoryItem();
+        item->historyEntry = entry;
+        items.append(item);
+    }
 
+    beginInsertRows(createIndex(m_todayItem->row(), 0, m_todayItem), 0, items.size() - 1);
+    m_todayItem->prependChildren(items);
     endInsertRows();
 }
 
-void HistoryModel::historyEntryDeleted(const HistoryEntry &entry)
+void HistoryModel::removeHistoryItems(const QVector<HistoryEntry> &entries)
 {
-    HistoryItem* item = findHistoryItem(entry);
-    if (!item) {
-        return;
+    QHash<HistoryItem*, QVector<int>> rows;
+
+    for (const HistoryEntry &entry : entries) {
+        HistoryItem* item = findHistoryItem(entry);
+        if (item) {
+            QVector<int> &parentRows = rows[item->parent()];
+            const int row = item->row();
+            if (!parentRows.contains(row)) {
+                parentRows.append(row);
+            }
+        }
     }
 
-    HistoryItem* parentItem = item->parent();
-    int row = item->row();
+    for (auto it = rows.begin(); it != rows.end(); ++it) {
+        HistoryItem* parentItem = it.key();
+        QVector<int> &parentRows = it.value();
+        std::sort(parentRows.begin(), parentRows.end());
 
-    beginRemoveRows(createIndex(parentItem->row(), 0, parentItem), row, row);
-    delete item;
-    endRemoveRows();
+        const QModelIndex parent = createIndex(parentItem->row(), 0, parentItem);
 
-    checkEmptyParentItem(parentItem);
-}
+        // Remove contiguous ranges, starting from the last one so rows stay valid
+        int end = parentRows.size() - 1;
+        while (end >= 0) {
+            int start = end;
+            while (start > 0 && parentRows.at(start - 1) == parentRows.at(start) - 1) {
+                --start;
+            }
 
-void HistoryModel::historyEntryEdited(const HistoryEntry &before, const HistoryEntry &after)
-{
-#if 0
-    HistoryItem* item = findHistoryItem(before);
+            const int first = parentRows.at(start);
+            const int last = parentRows.at(end);
 
-    if (item) {
-        HistoryItem* parentItem = item->parent();
-        const QModelIndex sourceParent = createIndex(parentItem->row(), 0, parentItem);
-        const QModelIndex destinationParent = createIndex(m_todayItem->row(), 0, m_todayItem);
-        int row = item->row();
+            beginRemoveRows(parent, first, last);
+            for (int row = last; row >= first; --row) {
+                delete parentItem->child(row);
+            }
+            endRemoveRows();
 
-        beginMoveRows(sourceParent, row, row, destinationParent, 0);
-        item->historyEntry = after;
-        item->refreshIcon();
-        item->changeParent(m_todayItem);
-        endMoveRows(); // This line sometimes throw "std::bad_alloc" ... I don't know why ?!
+            end = start - 1;
+        }
 
         checkEmptyParentItem(parentItem);
     }
-    else {
-        historyEntryAdded(after);
-    }
-#endif
-    historyEntryDeleted(before);
-    historyEntryAdded(after);
 }
 
 HistoryItem* HistoryModel::findHistoryItem(const HistoryEntry &entry)
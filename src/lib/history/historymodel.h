@@ -71,7 +71,7 @@ private Q_SLOTS:
     void resetHistory();
 
     void historyEntryAdded(const HistoryEntry &entry);
-    void historyEntryDeleted(const HistoryEntry &entry);
+    void historyEntriesDeleted(const QVector<HistoryEntry> &entries);
     void historyEntryEdited(const HistoryEntry &before, const HistoryEntry &after);
 
 private:
@@ -79,9 +79,19 @@ private:
     void checkEmptyParentItem(HistoryItem* item);
     void init();
 
+    void scheduleFlush();
+    void flushPendingEntries();
+    void insertTodayItems(const QVector<HistoryEntry> &entries);
+    void removeHistoryItems(const QVector<HistoryEntry> &entries);
+
     HistoryItem* m_rootItem;
     HistoryItem* m_todayItem;
     History* m_history;
+
+    // Visits are applied to the model in batches, once per event loop iteration
+    QVector<HistoryEntry> m_pendingEntries;
+    QVector<HistoryEntry> m_pendingRemovals;
+    bool m_flushScheduled = false;
 };
 
 class FALKON_EXPORT HistoryFilterModel : public QSortFilterProxyModel
@@ -24,6 +24,7 @@
 #include "browserwindow.h"
 #include "tabwidget.h"
 #include "sqldatabase.h"
+#include "history.h"
 
 LocationCompleterModel::LocationCompleterModel(QObject* parent)
     : QStandardItemModel(parent)
@@ -116,7 +117,12 @@ QSqlQuery LocationCompleterModel::createHistoryQuery(const QString &searchString
         }
     }
 
-    query.append(QLatin1String("ORDER BY date DESC LIMIT ?"));
+    if (History::hasFrecency()) {
+        query.append(QLatin1String("ORDER BY frecency DESC, date DESC LIMIT ?"));
+    }
+    else {
+        query.append(QLatin1String("ORDER BY date DESC LIMIT ?"));
+    }
 
     QSqlQuery sqlQuery(SqlDatabase::instance()->database());
     sqlQuery.prepare(query);
@@ -21,6 +21,7 @@
 #include "bookmarkitem.h"
 #include "iconprovider.h"
 #include "sqldatabase.h"
+#include "history.h"
 #include "qzsettings.h"
 #include "bookmarks.h"
 #include "qztools.h"
@@ -209,7 +210,7 @@ void LocationCompleterRefreshJob::completeFromHistory()
 void LocationCompleterRefreshJob::completeMostVisited()
 {
     QSqlQuery query(SqlDatabase::instance()->database());
-    query.exec(QSL("SELECT id, url, title FROM history ORDER BY count DESC LIMIT 15"));
+    query.exec(QSL("SELECT id, url, title FROM history ORDER BY %1 DESC LIMIT 15").arg(History::hasFrecency() ? QSL("frecency") : QSL("count")));
 
     while (query.next()) {
         QStandardItem* item = new QStandardItem();
@@ -27,22 +27,39 @@
 #include "iconprovider.h"
 #include "sessionmanager.h"
 #include "restoremanager.h"
+#include "htmltemplate.h"
 #include "../config.h"
 
+#include <QFile>
 #include <QTimer>
+#include <QLocale>
 #include <QSettings>
 #include <QUrlQuery>
 #include <QWebEngineProfile>
 #include <QWebEngineUrlRequestJob>
 
+// Rendered pages (and translated strings of pages with dynamic content) are cached
+// per locale and layout direction until settings are reloaded
+static QHash<QString, QString> s_pageCache;
+static QHash<QString, HtmlTemplate::Values> s_valuesCache;
+
 static QString authorString(const char* name, const QString &mail)
 {
     return QSL("%1 &lt;<a href=\"mailto:%2\">%2</a>&gt;").arg(QString::fromUtf8(name), mail);
 }
 
+static QString cacheKey(const QString &page)
+{
+    return QSL("%1/%2/%3").arg(page, QLocale().name(), QApplication::isRightToLeft() ? QSL("rtl") : QSL("ltr"));
+}
+
 FalkonSchemeHandler::FalkonSchemeHandler(QObject *parent)
     : QWebEngineUrlSchemeHandler(parent)
 {
+    connect(mApp, &MainApplication::settingsReloaded, this, []() {
+        s_pageCache.clear();
+        s_valuesCache.clear();
+    });
 }
 
 void FalkonSchemeHandler::requestStarted(QWebEngineUrlRequestJob *job)
@@ -77,11 +94,29 @@ bool FalkonSchemeHandler::handleRequest(QWebEngineUrlRequestJob *job)
     } else if (job->requestUrl().path() == QL1S("reportbug")) {
         job->redirect(QUrl(Qz::BUGSADDRESS));
         return true;
+    } else if (job->requestUrl().path().startsWith(QL1S("speeddial/thumb/"))) {
+        handleSpeedDialThumbnail(job);
+        return true;
     }
 
     return false;
 }
 
+void FalkonSchemeHandler::handleSpeedDialThumbnail(QWebEngineUrlRequestJob *job)
+{
+    const QString hash = job->requestUrl().path().mid(16);
+    const QString fileName = mApp->plugins()->speedDial()->thumbnailFileName(hash);
+
+    QFile *file = new QFile(fileName, job);
+    if (fileName.isEmpty() || !file->open(QFile::ReadOnly)) {
+        delete file;
+        job->fail(QWebEngineUrlRequestJob::UrlNotFound);
+        return;
+    }
+
+    job->reply(QByteArrayLiteral("image/png"), file);
+}
+
 FalkonSchemeReply::FalkonSchemeReply(QWebEngineUrlRequestJob *job, QObject *parent)
     : QIODevice(parent)
     , m_loaded(false)
@@ -142,158 +177,156 @@ qint64 FalkonSchemeReply::writeData(const char *data, qint64 len)
 
 QString FalkonSchemeReply::startPage()
 {
-    static QString sPage;
-
-    if (!sPage.isEmpty()) {
-        return sPage;
+    const QString key = cacheKey(QSL("start"));
+    if (s_pageCache.contains(key)) {
+        return s_pageCache.value(key);
     }
 
-    sPage.append(QzTools::readAllFileContents(":html/start.html"));
-    sPage.replace(QLatin1String("%ABOUT-IMG%"), QSL("qrc:icons/other/startpage.svg"));
-
-    sPage.replace(QLatin1String("%TITLE%"), tr("Start Page"));
-    sPage.replace(QLatin1String("%BUTTON-LABEL%"), tr("Search on Web"));
-    sPage.replace(QLatin1String("%SEARCH-BY%"), tr("Search results provided by DuckDuckGo"));
-    sPage.replace(QLatin1String("%WWW%"), Qz::WIKIADDRESS);
-    sPage.replace(QLatin1String("%ABOUT-FALKON%"), tr("About Falkon"));
-    sPage.replace(QLatin1String("%PRIVATE-BROWSING%"), mApp->isPrivate() ? tr("<h1>Private Browsing</h1>") : QString());
-    sPage = QzTools::applyDirectionToPage(sPage);
-
-    return sPage;
+    HtmlTemplate::Values values;
+    values[QSL("ABOUT-IMG")] = QSL("qrc:icons/other/startpage.svg");
+    values[QSL("TITLE")] = tr("Start Page");
+    values[QSL("BUTTON-LABEL")] = tr("Search on Web");
+    values[QSL("SEARCH-BY")] = tr("Search results provided by DuckDuckGo");
+    values[QSL("WWW")] = Qz::WIKIADDRESS;
+    values[QSL("ABOUT-FALKON")] = tr("About Falkon");
+    values[QSL("PRIVATE-BROWSING")] = mApp->isPrivate() ? tr("<h1>Private Browsing</h1>") : QString();
+
+    const QString page = HtmlTemplate::fromFile(QSL(":html/start.html")).render(values);
+    s_pageCache.insert(key, page);
+    return page;
 }
 
 QString FalkonSchemeReply::aboutPage()
 {
-    static QString aPage;
-
-    if (aPage.isEmpty()) {
-        aPage.append(QzTools::readAllFileContents(":html/about.html"));
-        aPage.replace(QLatin1String("%ABOUT-IMG%"), QSL("qrc:icons/other/about.svg"));
-        aPage.replace(QLatin1String("%COPYRIGHT-INCLUDE%"), QzTools::readAllFileContents(":html/copyright").toHtmlEscaped());
-
-        aPage.replace(QLatin1String("%TITLE%"), tr("About Falkon"));
-        aPage.replace(QLatin1String("%ABOUT-FALKON%"), tr("About Falkon"));
-        aPage.replace(QLatin1String("%INFORMATIONS-ABOUT-VERSION%"), tr("Information about version"));
-        aPage.replace(QLatin1String("%COPYRIGHT%"), tr("Copyright"));
+    const QString key = cacheKey(QSL("about"));
+    if (s_pageCache.contains(key)) {
+        return s_pageCache.value(key);
+    }
 
-        aPage.replace(QLatin1String("%VERSION-INFO%"),
-                      QString("<dt>%1</dt><dd>%2<dd>").arg(tr("Version"),
+    HtmlTemplate::Values values;
+    values[QSL("ABOUT-IMG")] = QSL("qrc:icons/other/about.svg");
+    values[QSL("COPYRIGHT-INCLUDE")] = QzTools::readAllFileContents(QSL(":html/copyright")).toHtmlEscaped();
+    values[QSL("TITLE")] = tr("About Falkon");
+    values[QSL("ABOUT-FALKON")] = tr("About Falkon");
+    values[QSL("INFORMATIONS-ABOUT-VERSION")] = tr("Information about version");
+    values[QSL("COPYRIGHT")] = tr("Copyright");
+    values[QSL("VERSION-INFO")] = QString("<dt>%1</dt><dd>%2<dd>").arg(tr("Version"),
 #ifdef FALKON_GIT_REVISION
-                              QString("%1 (%2)").arg(Qz::VERSION, FALKON_GIT_REVISION)));
+                                          QString("%1 (%2)").arg(Qz::VERSION, FALKON_GIT_REVISION));
 #else
-                              Qz::VERSION));
+                                          Qz::VERSION);
 #endif
+    values[QSL("MAIN-DEVELOPER")] = tr("Main developer");
+    values[QSL("MAIN-DEVELOPER-TEXT")] = authorString(Qz::AUTHOR, "nowrep@gmail.com");
 
-        aPage.replace(QLatin1String("%MAIN-DEVELOPER%"), tr("Main developer"));
-        aPage.replace(QLatin1String("%MAIN-DEVELOPER-TEXT%"), authorString(Qz::AUTHOR, "nowrep@gmail.com"));
-        aPage = QzTools::applyDirectionToPage(aPage);
-    }
-
-    return aPage;
+    const QString page = HtmlTemplate::fromFile(QSL(":html/about.html")).render(values);
+    s_pageCache.insert(key, page);
+    return page;
 }
 
 QString FalkonSchemeReply::speeddialPage()
 {
-    static QString dPage;
-
-    if (dPage.isEmpty()) {
-        dPage.append(QzTools::readAllFileContents(":html/speeddial.html"));
-        dPage.replace(QLatin1String("%IMG_PLUS%"), QLatin1String("qrc:html/plus.svg"));
-        dPage.replace(QLatin1String("%IMG_CLOSE%"), QLatin1String("qrc:html/close.svg"));
-        dPage.replace(QLatin1String("%IMG_EDIT%"), QLatin1String("qrc:html/edit.svg"));
-        dPage.replace(QLatin1String("%IMG_RELOAD%"), QLatin1String("qrc:html/reload.svg"));
-        dPage.replace(QLatin1String("%LOADING-IMG%"), QLatin1String("qrc:html/loading.gif"));
-        dPage.replace(QLatin1String("%IMG_SETTINGS%"), QLatin1String("qrc:html/configure.svg"));
-
-        dPage.replace(QLatin1String("%SITE-TITLE%"), tr("Speed Dial"));
-        dPage.replace(QLatin1String("%ADD-TITLE%"), tr("Add New Page"));
-        dPage.replace(QLatin1String("%TITLE-EDIT%"), tr("Edit"));
-        dPage.replace(QLatin1String("%TITLE-REMOVE%"), tr("Remove"));
-        dPage.replace(QLatin1String("%TITLE-RELOAD%"), tr("Reload"));
-        dPage.replace(QLatin1String("%TITLE-WARN%"), tr("Are you sure you want to remove this speed dial?"));
-        dPage.replace(QLatin1String("%TITLE-WARN-REL%"), tr("Are you sure you want to reload all speed dials?"));
-        dPage.replace(QLatin1String("%TITLE-FETCHTITLE%"), tr("Load title from page"));
-        dPage.replace(QLatin1String("%JAVASCRIPT-DISABLED%"), tr("SpeedDial requires enabled JavaScript."));
-        dPage.replace(QLatin1String("%URL%"), tr("Url"));
-        dPage.replace(QLatin1String("%TITLE%"), tr("Title"));
-        dPage.replace(QLatin1String("%APPLY%"), tr("Apply"));
-        dPage.replace(QLatin1String("%CANCEL%"), tr("Cancel"));
-        dPage.replace(QLatin1String("%NEW-PAGE%"), tr("New Page"));
-        dPage.replace(QLatin1String("%SETTINGS-TITLE%"), tr("Speed Dial settings"));
-        dPage.replace(QLatin1String("%TXT_PLACEMENT%"), tr("Placement: "));
-        dPage.replace(QLatin1String("%TXT_AUTO%"), tr("Auto"));
-        dPage.replace(QLatin1String("%TXT_COVER%"), tr("Cover"));
-        dPage.replace(QLatin1String("%TXT_FIT%"), tr("Fit"));
-        dPage.replace(QLatin1String("%TXT_FWIDTH%"), tr("Fit Width"));
-        dPage.replace(QLatin1String("%TXT_FHEIGHT%"), tr("Fit Height"));
-        dPage.replace(QLatin1String("%TXT_NOTE%"), tr("Use custom wallpaper"));
-        dPage.replace(QLatin1String("%TXT_SELECTIMAGE%"), tr("Click to select image"));
-        dPage.replace(QLatin1String("%TXT_NRROWS%"), tr("Maximum pages in a row:"));
-        dPage.replace(QLatin1String("%TXT_SDSIZE%"), tr("Change size of pages:"));
-        dPage.replace(QLatin1String("%TXT_CNTRDLS%"), tr("Center speed dials"));
-        dPage = QzTools::applyDirectionToPage(dPage);
+    const QString key = cacheKey(QSL("speeddial"));
+    HtmlTemplate::Values values = s_valuesCache.value(key);
+
+    if (values.isEmpty()) {
+        values[QSL("IMG_PLUS")] = QSL("qrc:html/plus.svg");
+        values[QSL("IMG_CLOSE")] = QSL("qrc:html/close.svg");
+        values[QSL("IMG_EDIT")] = QSL("qrc:html/edit.svg");
+        values[QSL("IMG_RELOAD")] = QSL("qrc:html/reload.svg");
+        values[QSL("LOADING-IMG")] = QSL("qrc:html/loading.gif");
+        values[QSL("IMG_SETTINGS")] = QSL("qrc:html/configure.svg");
+
+        values[QSL("SITE-TITLE")] = tr("Speed Dial");
+        values[QSL("ADD-TITLE")] = tr("Add New Page");
+        values[QSL("TITLE-EDIT")] = tr("Edit");
+        values[QSL("TITLE-REMOVE")] = tr("Remove");
+        values[QSL("TITLE-RELOAD")] = tr("Reload");
+        values[QSL("TITLE-WARN")] = tr("Are you sure you want to remove this speed dial?");
+        values[QSL("TITLE-WARN-REL")] = tr("Are you sure you want to reload all speed dials?");
+        values[QSL("TITLE-FETCHTITLE")] = tr("Load title from page");
+        values[QSL("JAVASCRIPT-DISABLED")] = tr("SpeedDial requires enabled JavaScript.");
+        values[QSL("URL")] = tr("Url");
+        values[QSL("TITLE")] = tr("Title");
+        values[QSL("APPLY")] = tr("Apply");
+        values[QSL("CANCEL")] = tr("Cancel");
+        values[QSL("NEW-PAGE")] = tr("New Page");
+        values[QSL("SETTINGS-TITLE")] = tr("Speed Dial settings");
+        values[QSL("TXT_PLACEMENT")] = tr("Placement: ");
+        values[QSL("TXT_AUTO")] = tr("Auto");
+        values[QSL("TXT_COVER")] = tr("Cover");
+        values[QSL("TXT_FIT")] = tr("Fit");
+        values[QSL("TXT_FWIDTH")] = tr("Fit Width");
+        values[QSL("TXT_FHEIGHT")] = tr("Fit Height");
+        values[QSL("TXT_NOTE")] = tr("Use custom wallpaper");
+        values[QSL("TXT_SELECTIMAGE")] = tr("Click to select image");
+        values[QSL("TXT_NRROWS")] = tr("Maximum pages in a row:");
+        values[QSL("TXT_SDSIZE")] = tr("Change size of pages:");
+        values[QSL("TXT_CNTRDLS")] = tr("Center speed dials");
+        s_valuesCache.insert(key, values);
     }
 
-    QString page = dPage;
     SpeedDial* dial = mApp->plugins()->speedDial();
 
-    page.replace(QLatin1String("%INITIAL-SCRIPT%"), dial->initialScript().toUtf8().toBase64());
-    page.replace(QLatin1String("%IMG_BACKGROUND%"), dial->backgroundImage());
-    page.replace(QLatin1String("%URL_BACKGROUND%"), dial->backgroundImageUrl());
-    page.replace(QLatin1String("%B_SIZE%"), dial->backgroundImageSize());
-    page.replace(QLatin1String("%ROW-PAGES%"), QString::number(dial->pagesInRow()));
-    page.replace(QLatin1String("%SD-SIZE%"), QString::number(dial->sdSize()));
-    page.replace(QLatin1String("%SD-CENTER%"), dial->sdCenter() ? QSL("true") : QSL("false"));
+    values[QSL("INITIAL-SCRIPT")] = QString::fromLatin1(dial->initialScript().toUtf8().toBase64());
+    values[QSL("IMG_BACKGROUND")] = dial->backgroundImage();
+    values[QSL("URL_BACKGROUND")] = dial->backgroundImageUrl();
+    values[QSL("B_SIZE")] = dial->backgroundImageSize();
+    values[QSL("ROW-PAGES")] = QString::number(dial->pagesInRow());
+    values[QSL("SD-SIZE")] = QString::number(dial->sdSize());
+    values[QSL("SD-CENTER")] = dial->sdCenter() ? QSL("true") : QSL("false");
 
-    return page;
+    return HtmlTemplate::fromFile(QSL(":html/speeddial.html")).render(values);
 }
 
 QString FalkonSchemeReply::restorePage()
 {
-    static QString rPage;
-
-    if (rPage.isEmpty()) {
-        rPage.append(QzTools::readAllFileContents(":html/restore.html"));
-        rPage.replace(QLatin1String("%IMAGE%"), QzTools::pixmapToDataUrl(IconProvider::standardIcon(QStyle::SP_MessageBoxWarning).pixmap(45)).toString());
-        rPage.replace(QLatin1String("%TITLE%"), tr("Restore Session"));
-        rPage.replace(QLatin1String("%OOPS%"), tr("Oops, Falkon crashed."));
-        rPage.replace(QLatin1String("%APOLOGIZE%"), tr("We apologize for this. Would you like to restore the last saved state?"));
-        rPage.replace(QLatin1String("%TRY-REMOVING%"), tr("Try removing one or more tabs that you think cause troubles"));
-        rPage.replace(QLatin1String("%START-NEW%"), tr("Or you can start completely new session"));
-        rPage.replace(QLatin1String("%WINDOW%"), tr("Window"));
-        rPage.replace(QLatin1String("%WINDOWS-AND-TABS%"), tr("Windows and Tabs"));
-        rPage.replace(QLatin1String("%BUTTON-START-NEW%"), tr("Start New Session"));
-        rPage.replace(QLatin1String("%BUTTON-RESTORE%"), tr("Restore"));
-        rPage.replace(QLatin1String("%JAVASCRIPT-DISABLED%"), tr("Requires enabled JavaScript."));
-        rPage = QzTools::applyDirectionToPage(rPage);
+    const QString key = cacheKey(QSL("restore"));
+    if (s_pageCache.contains(key)) {
+        return s_pageCache.value(key);
     }
 
-    return rPage;
+    HtmlTemplate::Values values;
+    values[QSL("IMAGE")] = QzTools::pixmapToDataUrl(IconProvider::standardIcon(QStyle::SP_MessageBoxWarning).pixmap(45)).toString();
+    values[QSL("TITLE")] = tr("Restore Session");
+    values[QSL("OOPS")] = tr("Oops, Falkon crashed.");
+    values[QSL("APOLOGIZE")] = tr("We apologize for this. Would you like to restore the last saved state?");
+    values[QSL("TRY-REMOVING")] = tr("Try removing one or more tabs that you think cause troubles");
+    values[QSL("START-NEW")] = tr("Or you can start completely new session");
+    values[QSL("WINDOW")] = tr("Window");
+    values[QSL("WINDOWS-AND-TABS")] = tr("Windows and Tabs");
+    values[QSL("BUTTON-START-NEW")] = tr("Start New Session");
+    values[QSL("BUTTON-RESTORE")] = tr("Restore");
+    values[QSL("JAVASCRIPT-DISABLED")] = tr("Requires enabled JavaScript.");
+
+    const QString page = HtmlTemplate::fromFile(QSL(":html/restore.html")).render(values);
+    s_pageCache.insert(key, page);
+    return page;
 }
 
 QString FalkonSchemeReply::configPage()
 {
-    static QString cPage;
-
-    if (cPage.isEmpty()) {
-        cPage.append(QzTools::readAllFileContents(":html/config.html"));
-        cPage.replace(QLatin1String("%ABOUT-IMG%"), QSL("qrc:icons/other/about.svg"));
-
-        cPage.replace(QLatin1String("%TITLE%"), tr("Configuration Information"));
-        cPage.replace(QLatin1String("%CONFIG%"), tr("Configuration Information"));
-        cPage.replace(QLatin1String("%INFORMATIONS-ABOUT-VERSION%"), tr("Information about version"));
-        cPage.replace(QLatin1String("%CONFIG-ABOUT%"), tr("This page contains information about Falkon's current configuration - relevant for troubleshooting. Please include this information when submitting bug reports."));
-        cPage.replace(QLatin1String("%BROWSER-IDENTIFICATION%"), tr("Browser Identification"));
-        cPage.replace(QLatin1String("%PATHS%"), tr("Paths"));
-        cPage.replace(QLatin1String("%BUILD-CONFIG%"), tr("Build Configuration"));
-        cPage.replace(QLatin1String("%PREFS%"), tr("Preferences"));
-        cPage.replace(QLatin1String("%OPTION%"), tr("Option"));
-        cPage.replace(QLatin1String("%VALUE%"), tr("Value"));
-        cPage.replace(QLatin1String("%PLUGINS%"), tr("Extensions"));
-        cPage.replace(QLatin1String("%PL-NAME%"), tr("Name"));
-        cPage.replace(QLatin1String("%PL-VER%"), tr("Version"));
-        cPage.replace(QLatin1String("%PL-AUTH%"), tr("Author"));
-        cPage.replace(QLatin1String("%PL-DESC%"), tr("Description"));
+    const QString key = cacheKey(QSL("config"));
+    HtmlTemplate::Values values = s_valuesCache.value(key);
+
+    if (values.isEmpty()) {
+        values[QSL("ABOUT-IMG")] = QSL("qrc:icons/other/about.svg");
+
+        values[QSL("TITLE")] = tr("Configuration Information");
+        values[QSL("CONFIG")] = tr("Configuration Information");
+        values[QSL("INFORMATIONS-ABOUT-VERSION")] = tr("Information about version");
+        values[QSL("CONFIG-ABOUT")] = tr("This page contains information about Falkon's current configuration - relevant for troubleshooting. Please include this information when submitting bug reports.");
+        values[QSL("BROWSER-IDENTIFICATION")] = tr("Browser Identification");
+        values[QSL("PATHS")] = tr("Paths");
+        values[QSL("BUILD-CONFIG")] = tr("Build Configuration");
+        values[QSL("PREFS")] = tr("Preferences");
+        values[QSL("OPTION")] = tr("Option");
+        values[QSL("VALUE")] = tr("Value");
+        values[QSL("PLUGINS")] = tr("Extensions");
+        values[QSL("PL-NAME")] = tr("Name");
+        values[QSL("PL-VER")] = tr("Version");
+        values[QSL("PL-AUTH")] = tr("Author");
+        values[QSL("PL-DESC")] = tr("Description");
 
         auto allPaths = [](DataPaths::Path type) {
             QString out;
@@ -307,7 +340,7 @@ QString FalkonSchemeReply::configPage()
             return out;
         };
 
-        cPage.replace(QLatin1String("%VERSION-INFO%"),
+        values[QSL("VERSION-INFO")] =
                       QString("<dt>%1</dt><dd>%2<dd>").arg(tr("Application version"),
 #ifdef FALKON_GIT_REVISION
                               QString("%1 (%2)").arg(Qz::VERSION, FALKON_GIT_REVISION)
@@ -316,15 +349,15 @@ QString FalkonSchemeReply::configPage()
 #endif
                                                           ) +
                       QString("<dt>%1</dt><dd>%2<dd>").arg(tr("Qt version"), qVersion()) +
-                      QString("<dt>%1</dt><dd>%2<dd>").arg(tr("Platform"), QzTools::operatingSystemLong()));
+                      QString("<dt>%1</dt><dd>%2<dd>").arg(tr("Platform"), QzTools::operatingSystemLong());
 
-        cPage.replace(QLatin1String("%PATHS-TEXT%"),
+        values[QSL("PATHS-TEXT")] =
                       QString("<dt>%1</dt><dd>%2<dd>").arg(tr("Profile"), DataPaths::currentProfilePath()) +
                       QString("<dt>%1</dt><dd>%2<dd>").arg(tr("Settings"), DataPaths::currentProfilePath() + "/settings.ini") +
                       QString("<dt>%1</dt><dd>%2<dd>").arg(tr("Saved session"), SessionManager::defaultSessionPath()) +
                       QString("<dt>%1</dt><dd>%2<dd>").arg(tr("Data"), allPaths(DataPaths::AppData)) +
                       QString("<dt>%1</dt><dd>%2<dd>").arg(tr("Themes"), allPaths(DataPaths::Themes)) +
-                      QString("<dt>%1</dt><dd>%2<dd>").arg(tr("Extensions"), allPaths(DataPaths::Plugins)));
+                      QString("<dt>%1</dt><dd>%2<dd>").arg(tr("Extensions"), allPaths(DataPaths::Plugins));
 
 #ifdef QT_DEBUG
         QString debugBuild = tr("<b>Enabled</b>");
@@ -342,18 +375,17 @@ QString FalkonSchemeReply::configPage()
 
         QString portableBuild = mApp->isPortable() ? tr("<b>Enabled</b>") : tr("Disabled");
 
-        cPage.replace(QLatin1String("%BUILD-CONFIG-TEXT%"),
+        values[QSL("BUILD-CONFIG-TEXT")] =
                       QString("<dt>%1</dt><dd>%2<dd>").arg(tr("Debug build"), debugBuild) +
 #ifdef Q_OS_WIN
                       QString("<dt>%1</dt><dd>%2<dd>").arg(tr("Windows 7 API"), w7APIEnabled) +
 #endif
-                      QString("<dt>%1</dt><dd>%2<dd>").arg(tr("Portable build"), portableBuild));
+                      QString("<dt>%1</dt><dd>%2<dd>").arg(tr("Portable build"), portableBuild);
 
-        cPage = QzTools::applyDirectionToPage(cPage);
+        s_valuesCache.insert(key, values);
     }
 
-    QString page = cPage;
-    page.replace(QLatin1String("%USER-AGENT%"), mApp->webProfile()->httpUserAgent());
+    values[QSL("USER-AGENT")] = mApp->webProfile()->httpUserAgent();
 
     QString pluginsString;
     const QList<Plugins::Plugin> &availablePlugins = mApp->plugins()->getAvailablePlugins();
@@ -368,7 +400,7 @@ QString FalkonSchemeReply::configPage()
         pluginsString = QString("<tr><td colspan=4 class=\"no-available-plugins\">%1</td></tr>").arg(tr("No available extensions."));
     }
 
-    page.replace(QLatin1String("%PLUGINS-INFO%"), pluginsString);
+    values[QSL("PLUGINS-INFO")] = pluginsString;
 
     QString allGroupsString;
     QSettings* settings = Settings::globalSettings();
@@ -410,7 +442,7 @@ QString FalkonSchemeReply::configPage()
         allGroupsString.append(groupString);
     }
 
-    page.replace(QLatin1String("%PREFS-INFO%"), allGroupsString);
+    values[QSL("PREFS-INFO")] = allGroupsString;
 
-    return page;
+    return HtmlTemplate::fromFile(QSL(":html/config.html")).render(values);
 }
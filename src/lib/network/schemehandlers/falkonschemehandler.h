@@ -34,6 +34,7 @@ public:
 
 private:
     bool handleRequest(QWebEngineUrlRequestJob *job);
+    void handleSpeedDialThumbnail(QWebEngineUrlRequestJob *job);
 };
 
 class FALKON_EXPORT FalkonSchemeReply : public QIODevice
@@ -20,6 +20,7 @@
 #include "tabwidget.h"
 #include "cookiejar.h"
 #include "history.h"
+#include "historydeletejob.h"
 #include "settings.h"
 #include "datapaths.h"
 #include "mainapplication.h"
@@ -29,6 +30,7 @@
 #include "qztools.h"
 #include "cookiemanager.h"
 #include "desktopnotificationsfactory.h"
+#include "downloadmanager.h"
 
 #include <QNetworkCookie>
 #include <QMessageBox>
@@ -94,9 +96,23 @@ void ClearPrivateData::closeEvent(QCloseEvent* e)
     settings.setValue("state", saveState());
     settings.endGroup();
 
+    // Already deleted entries stay deleted
+    if (m_historyJob) {
+        m_historyJob->cancel();
+    }
+
     e->accept();
 }
 
+void ClearPrivateData::reject()
+{
+    if (m_historyJob) {
+        m_historyJob->cancel();
+    }
+
+    QDialog::reject();
+}
+
 void ClearPrivateData::dialogAccepted()
 {
     QApplication::setOverrideCursor(Qt::WaitCursor);
@@ -124,11 +140,13 @@ void ClearPrivateData::dialogAccepted()
         }
 
         if (end == 0) {
-            mApp->history()->clearHistory();
+            m_historyJob = mApp->history()->clearHistory();
+            mApp->downloadManager()->clearHistory();
         }
         else {
             const QList<int> &indexes = mApp->history()->indexesFromTimeRange(start, end);
-            mApp->history()->deleteHistoryEntry(indexes);
+            m_historyJob = mApp->history()->deleteHistoryEntry(indexes);
+            mApp->downloadManager()->clearHistory(QDateTime::fromMSecsSinceEpoch(end));
         }
     }
 
@@ -151,6 +169,21 @@ void ClearPrivateData::dialogAccepted()
     QApplication::restoreOverrideCursor();
 
     ui->clear->setEnabled(false);
+
+    if (m_historyJob) {
+        ui->clear->setText(tr("Clearing history..."));
+        connect(m_historyJob.data(), &HistoryDeleteJob::progress, this, [this](int processed, int total) {
+            ui->clear->setText(tr("Clearing history... %1%").arg(processed * 100 / total));
+        });
+        connect(m_historyJob.data(), &HistoryDeleteJob::finished, this, &ClearPrivateData::clearingFinished);
+        return;
+    }
+
+    clearingFinished();
+}
+
+void ClearPrivateData::clearingFinished()
+{
     ui->clear->setText(tr("Done"));
 
     QTimer::singleShot(1000, this, &QWidget::close);
@@ -19,6 +19,7 @@
 #define CLEARPRIVATEDATA_H
 
 #include <QDialog>
+#include <QPointer>
 
 #include "qzcommon.h"
 
@@ -27,6 +28,8 @@ namespace Ui
 class ClearPrivateData;
 }
 
+class HistoryDeleteJob;
+
 class FALKON_EXPORT ClearPrivateData : public QDialog
 {
     Q_OBJECT
@@ -40,16 +43,19 @@ public:
 private Q_SLOTS:
     void historyClicked(bool state);
     void dialogAccepted();
+    void clearingFinished();
     void optimizeDb();
     void showCookieManager();
 
 private:
     void closeEvent(QCloseEvent* e) override;
+    void reject() override;
 
     void restoreState(const QByteArray &state);
     QByteArray saveState();
 
     Ui::ClearPrivateData* ui;
+    QPointer<HistoryDeleteJob> m_historyJob;
 
 };
 
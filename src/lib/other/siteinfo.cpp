@@ -21,7 +21,6 @@
 #include "webview.h"
 #include "webpage.h"
 #include "mainapplication.h"
-#include "downloaditem.h"
 #include "certificateinfowidget.h"
 #include "qztools.h"
 #include "iconprovider.h"
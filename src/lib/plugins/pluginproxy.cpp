@@ -21,73 +21,148 @@
 #include "settings.h"
 
 #include <QMenu>
+#include <QElapsedTimer>
 
 PluginProxy::PluginProxy(QObject *parent)
     : Plugins(parent)
+    , m_collectStatistics(Plugins::isDebugEnabled())
 {
     connect(this, SIGNAL(pluginUnloaded(PluginInterface*)), this, SLOT(pluginUnloaded(PluginInterface*)));
+
+    if (m_collectStatistics) {
+        connect(qApp, &QCoreApplication::aboutToQuit, this, &PluginProxy::printHandlerStatistics);
+    }
 }
 
 void PluginProxy::registerAppEventHandler(PluginProxy::EventHandlerType type, PluginInterface* obj)
 {
-    switch (type) {
-    case MouseDoubleClickHandler:
-        if (!m_mouseDoubleClickHandlers.contains(obj)) {
-            m_mouseDoubleClickHandlers.append(obj);
-        }
-        break;
+    registerAppEventHandler(type, obj, HandlerFilter());
+}
 
-    case MousePressHandler:
-        if (!m_mousePressHandlers.contains(obj)) {
-            m_mousePressHandlers.append(obj);
-        }
-        break;
+void PluginProxy::registerAppEventHandler(PluginProxy::EventHandlerType type, PluginInterface* obj, const HandlerFilter &filter)
+{
+    if (type < 0 || type >= HandlerTypesCount) {
+        qWarning("PluginProxy::registerAppEventHandler registering unknown event handler type");
+        return;
+    }
 
-    case MouseReleaseHandler:
-        if (!m_mouseReleaseHandlers.contains(obj)) {
-            m_mouseReleaseHandlers.append(obj);
-        }
-        break;
+    QVector<Handler> &handlers = m_handlers[type];
 
-    case MouseMoveHandler:
-        if (!m_mouseMoveHandlers.contains(obj)) {
-            m_mouseMoveHandlers.append(obj);
+    for (Handler &handler : handlers) {
+        if (handler.plugin == obj) {
+            handler.filter = filter;
+            rebuildDispatchTable(type);
+            return;
         }
-        break;
+    }
+
+    Handler handler;
+    handler.plugin = obj;
+    handler.filter = filter;
+    handlers.append(handler);
+
+    rebuildDispatchTable(type);
+}
+
+void PluginProxy::setNavigationRequestFilter(PluginInterface* obj, const HandlerFilter &filter)
+{
+    m_navigationFilters[obj] = filter;
+}
+
+QHash<PluginInterface*, PluginProxy::HandlerStatistics> PluginProxy::handlerStatistics() const
+{
+    return m_statistics;
+}
 
-    case KeyPressHandler:
-        if (!m_keyPressHandlers.contains(obj)) {
-            m_keyPressHandlers.append(obj);
+void PluginProxy::pluginUnloaded(PluginInterface* plugin)
+{
+    for (int type = 0; type < HandlerTypesCount; ++type) {
+        QVector<Handler> &handlers = m_handlers[type];
+        const int size = handlers.size();
+
+        for (int i = handlers.size() - 1; i >= 0; --i) {
+            if (handlers.at(i).plugin == plugin) {
+                handlers.remove(i);
+            }
         }
-        break;
 
-    case KeyReleaseHandler:
-        if (!m_keyReleaseHandlers.contains(obj)) {
-            m_keyReleaseHandlers.append(obj);
+        if (handlers.size() != size) {
+            rebuildDispatchTable(static_cast<EventHandlerType>(type));
         }
-        break;
+    }
+
+    m_navigationFilters.remove(plugin);
+}
+
+void PluginProxy::printHandlerStatistics()
+{
+    for (auto it = m_statistics.constBegin(); it != m_statistics.constEnd(); ++it) {
+        qDebug() << "Plugin" << pluginName(it.key()) << "handled" << it.value().calls << "events in" << it.value().time / 1000000.0 << "ms";
+    }
+}
 
-    case WheelEventHandler:
-        if (!m_wheelEventHandlers.contains(obj)) {
-            m_wheelEventHandlers.append(obj);
+void PluginProxy::rebuildDispatchTable(EventHandlerType type)
+{
+    for (int object = 0; object < ObjectNamesCount; ++object) {
+        QVector<Handler> &table = m_dispatchTable[type][object];
+        table.clear();
+
+        for (const Handler &handler : qAsConst(m_handlers[type])) {
+            if (handler.filter.objects.isEmpty() || handler.filter.objects.contains(static_cast<Qz::ObjectName>(object))) {
+                table.append(handler);
+            }
         }
-        break;
+    }
+}
 
-    default:
-        qWarning("PluginProxy::registerAppEventHandler registering unknown event handler type");
-        break;
+const QVector<PluginProxy::Handler> &PluginProxy::handlers(EventHandlerType type, Qz::ObjectName object) const
+{
+    Q_ASSERT(object >= 0 && object < ObjectNamesCount);
+
+    return m_dispatchTable[type][object];
+}
+
+template <typename Function>
+bool PluginProxy::callHandler(PluginInterface *plugin, Function function)
+{
+    if (!m_collectStatistics) {
+        return function();
     }
+
+    QElapsedTimer timer;
+    timer.start();
+
+    const bool result = function();
+
+    HandlerStatistics &statistics = m_statistics[plugin];
+    statistics.calls++;
+    statistics.time += timer.nsecsElapsed();
+
+    return result;
 }
 
-void PluginProxy::pluginUnloaded(PluginInterface* plugin)
+template <typename Function>
+bool PluginProxy::dispatchEvent(EventHandlerType type, Qz::ObjectName object, Qt::MouseButton button, Function function)
 {
-    m_mousePressHandlers.removeOne(plugin);
-    m_mouseReleaseHandlers.removeOne(plugin);
-    m_mouseMoveHandlers.removeOne(plugin);
-    m_wheelEventHandlers.removeOne(plugin);
+    const QVector<Handler> &list = handlers(type, object);
+    if (list.isEmpty()) {
+        return false;
+    }
+
+    bool accepted = false;
 
-    m_keyPressHandlers.removeOne(plugin);
-    m_keyReleaseHandlers.removeOne(plugin);
+    // Iterate over copy, handler may unregister itself
+    const QVector<Handler> copy = list;
+    for (const Handler &handler : copy) {
+        if (button != Qt::NoButton && !(handler.filter.buttons & button)) {
+            continue;
+        }
+        if (callHandler(handler.plugin, [&]() { return function(handler.plugin); })) {
+            accepted = true;
+        }
+    }
+
+    return accepted;
 }
 
 void PluginProxy::populateWebViewMenu(QMenu* menu, WebView* view, const WebHitTestResult &r)
@@ -114,93 +189,51 @@ void PluginProxy::populateExtensionsMenu(QMenu *menu)
 
 bool PluginProxy::processMouseDoubleClick(Qz::ObjectName type, QObject* obj, QMouseEvent* event)
 {
-    bool accepted = false;
-
-    foreach (PluginInterface* iPlugin, m_mouseDoubleClickHandlers) {
-        if (iPlugin->mouseDoubleClick(type, obj, event)) {
-            accepted = true;
-        }
-    }
-
-    return accepted;
+    return dispatchEvent(MouseDoubleClickHandler, type, event->button(), [&](PluginInterface *plugin) {
+        return plugin->mouseDoubleClick(type, obj, event);
+    });
 }
 
 bool PluginProxy::processMousePress(Qz::ObjectName type, QObject* obj, QMouseEvent* event)
 {
-    bool accepted = false;
-
-    foreach (PluginInterface* iPlugin, m_mousePressHandlers) {
-        if (iPlugin->mousePress(type, obj, event)) {
-            accepted = true;
-        }
-    }
-
-    return accepted;
+    return dispatchEvent(MousePressHandler, type, event->button(), [&](PluginInterface *plugin) {
+        return plugin->mousePress(type, obj, event);
+    });
 }
 
 bool PluginProxy::processMouseRelease(Qz::ObjectName type, QObject* obj, QMouseEvent* event)
 {
-    bool accepted = false;
-
-    foreach (PluginInterface* iPlugin, m_mouseReleaseHandlers) {
-        if (iPlugin->mouseRelease(type, obj, event)) {
-            accepted = true;
-        }
-    }
-
-    return accepted;
+    return dispatchEvent(MouseReleaseHandler, type, event->button(), [&](PluginInterface *plugin) {
+        return plugin->mouseRelease(type, obj, event);
+    });
 }
 
 bool PluginProxy::processMouseMove(Qz::ObjectName type, QObject* obj, QMouseEvent* event)
 {
-    bool accepted = false;
-
-    foreach (PluginInterface* iPlugin, m_mouseMoveHandlers) {
-        if (iPlugin->mouseMove(type, obj, event)) {
-            accepted = true;
-        }
-    }
-
-    return accepted;
+    return dispatchEvent(MouseMoveHandler, type, Qt::NoButton, [&](PluginInterface *plugin) {
+        return plugin->mouseMove(type, obj, event);
+    });
 }
 
 bool PluginProxy::processWheelEvent(Qz::ObjectName type, QObject* obj, QWheelEvent* event)
 {
-    bool accepted = false;
-
-    foreach (PluginInterface* iPlugin, m_wheelEventHandlers) {
-        if (iPlugin->wheelEvent(type, obj, event)) {
-            accepted = true;
-        }
-    }
-
-    return accepted;
+    return dispatchEvent(WheelEventHandler, type, Qt::NoButton, [&](PluginInterface *plugin) {
+        return plugin->wheelEvent(type, obj, event);
+    });
 }
 
 bool PluginProxy::processKeyPress(Qz::ObjectName type, QObject* obj, QKeyEvent* event)
 {
-    bool accepted = false;
-
-    foreach (PluginInterface* iPlugin, m_keyPressHandlers) {
-        if (iPlugin->keyPress(type, obj, event)) {
-            accepted = true;
-        }
-    }
-
-    return accepted;
+    return dispatchEvent(KeyPressHandler, type, Qt::NoButton, [&](PluginInterface *plugin) {
+        return plugin->keyPress(type, obj, event);
+    });
 }
 
 bool PluginProxy::processKeyRelease(Qz::ObjectName type, QObject* obj, QKeyEvent* event)
 {
-    bool accepted = false;
-
-    foreach (PluginInterface* iPlugin, m_keyReleaseHandlers) {
-        if (iPlugin->keyRelease(type, obj, event)) {
-            accepted = true;
-        }
-    }
-
-    return accepted;
+    return dispatchEvent(KeyReleaseHandler, type, Qt::NoButton, [&](PluginInterface *plugin) {
+        return plugin->keyRelease(type, obj, event);
+    });
 }
 
 bool PluginProxy::acceptNavigationRequest(WebPage *page, const QUrl &url, QWebEnginePage::NavigationType type, bool isMainFrame)
@@ -208,7 +241,17 @@ bool PluginProxy::acceptNavigationRequest(WebPage *page, const QUrl &url, QWebEn
     bool accepted = true;
 
     foreach (PluginInterface* iPlugin, m_loadedPlugins) {
-        if (!iPlugin->acceptNavigationRequest(page, url, type, isMainFrame)) {
+        const auto it = m_navigationFilters.constFind(iPlugin);
+        if (it != m_navigationFilters.constEnd()) {
+            const HandlerFilter &filter = it.value();
+            if ((filter.mainFrameOnly && !isMainFrame) ||
+                (!filter.schemes.isEmpty() && !filter.schemes.contains(url.scheme())) ||
+                (!filter.navigationTypes.isEmpty() && !filter.navigationTypes.contains(type))) {
+                continue;
+            }
+        }
+
+        if (!callHandler(iPlugin, [&]() { return iPlugin->acceptNavigationRequest(page, url, type, isMainFrame); })) {
             accepted = false;
         }
     }
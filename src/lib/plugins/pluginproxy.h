@@ -21,6 +21,7 @@
 #include "plugins.h"
 #include "qzcommon.h"
 
+#include <QVector>
 #include <QWebEnginePage>
 
 class WebPage;
@@ -35,9 +36,34 @@ public:
                             WheelEventHandler
                           };
 
+    // Limits when a handler is called, default constructed filter matches everything
+    struct HandlerFilter {
+        // Event handlers: objects for which handler is called, empty means all objects
+        QList<Qz::ObjectName> objects;
+        // Mouse press, release and double click handlers: buttons for which handler is called
+        Qt::MouseButtons buttons = Qt::AllButtons;
+
+        // Navigation request handler: url schemes and navigation types, empty means all
+        QStringList schemes;
+        QList<QWebEnginePage::NavigationType> navigationTypes;
+        bool mainFrameOnly = false;
+    };
+
+    struct HandlerStatistics {
+        int calls = 0;
+        qint64 time = 0; // nsecs
+    };
+
     explicit PluginProxy(QObject *parent = nullptr);
 
     void registerAppEventHandler(EventHandlerType type, PluginInterface* obj);
+    void registerAppEventHandler(EventHandlerType type, PluginInterface* obj, const HandlerFilter &filter);
+
+    // Plugins without filter receive all navigation requests
+    void setNavigationRequestFilter(PluginInterface* obj, const HandlerFilter &filter);
+
+    // Only collected when Plugins::isDebugEnabled()
+    QHash<PluginInterface*, HandlerStatistics> handlerStatistics() const;
 
     void populateWebViewMenu(QMenu* menu, WebView* view, const WebHitTestResult &r);
     void populateExtensionsMenu(QMenu *menu);
@@ -69,17 +95,35 @@ Q_SIGNALS:
 
 private Q_SLOTS:
     void pluginUnloaded(PluginInterface* plugin);
+    void printHandlerStatistics();
 
 private:
-    QList<PluginInterface*> m_mouseDoubleClickHandlers;
-    QList<PluginInterface*> m_mousePressHandlers;
-    QList<PluginInterface*> m_mouseReleaseHandlers;
-    QList<PluginInterface*> m_mouseMoveHandlers;
+    struct Handler {
+        PluginInterface *plugin;
+        HandlerFilter filter;
+    };
+
+    static const int HandlerTypesCount = WheelEventHandler + 1;
+    static const int ObjectNamesCount = Qz::ON_BrowserWindow + 1;
+
+    void rebuildDispatchTable(EventHandlerType type);
+    const QVector<Handler> &handlers(EventHandlerType type, Qz::ObjectName object) const;
+
+    template <typename Function>
+    bool callHandler(PluginInterface *plugin, Function function);
+
+    // Calls function for each handler matching object, Qt::NoButton skips the button filter
+    template <typename Function>
+    bool dispatchEvent(EventHandlerType type, Qz::ObjectName object, Qt::MouseButton button, Function function);
+
+    QVector<Handler> m_handlers[HandlerTypesCount];
+    // Handlers matching object filter, so events with no subscriber are not dispatched at all
+    QVector<Handler> m_dispatchTable[HandlerTypesCount][ObjectNamesCount];
 
-    QList<PluginInterface*> m_wheelEventHandlers;
+    QHash<PluginInterface*, HandlerFilter> m_navigationFilters;
 
-    QList<PluginInterface*> m_keyPressHandlers;
-    QList<PluginInterface*> m_keyReleaseHandlers;
+    bool m_collectStatistics;
+    QHash<PluginInterface*, HandlerStatistics> m_statistics;
 };
 
 #endif // PLUGINPROXY_H
@@ -24,15 +24,43 @@
 #include "adblock/adblockplugin.h"
 #include "../config.h"
 #include "desktopfile.h"
+#include "startupprofiler.h"
 #include "qml/qmlplugins.h"
 #include "qml/qmlplugin.h"
 
 #include <iostream>
 #include <QPluginLoader>
 #include <QDir>
+#include <QLocale>
+#include <QDateTime>
+#include <QDataStream>
+#include <QElapsedTimer>
+#include <QSaveFile>
 #include <QQmlEngine>
 #include <QQmlComponent>
 
+static QDataStream &operator<<(QDataStream &stream, const PluginSpec &spec)
+{
+    stream << spec.name;
+    stream << spec.description;
+    stream << spec.author;
+    stream << spec.version;
+    stream << spec.icon;
+    stream << spec.hasSettings;
+    return stream;
+}
+
+static QDataStream &operator>>(QDataStream &stream, PluginSpec &spec)
+{
+    stream >> spec.name;
+    stream >> spec.description;
+    stream >> spec.author;
+    stream >> spec.version;
+    stream >> spec.icon;
+    stream >> spec.hasSettings;
+    return stream;
+}
+
 Plugins::Plugins(QObject* parent)
     : QObject(parent)
     , m_pluginsLoaded(false)
@@ -158,6 +186,23 @@ PluginSpec Plugins::createSpec(const DesktopFile &metaData)
     return spec;
 }
 
+// static
+bool Plugins::isDebugEnabled()
+{
+    static const bool debug = qEnvironmentVariableIsSet("FALKON_PLUGINS_DEBUG");
+    return debug;
+}
+
+QString Plugins::pluginName(PluginInterface *instance) const
+{
+    for (const Plugin &plugin : qAsConst(m_availablePlugins)) {
+        if (plugin.instance == instance) {
+            return plugin.pluginSpec.name;
+        }
+    }
+    return QString();
+}
+
 void Plugins::loadPlugins()
 {
     QDir settingsDir(DataPaths::currentProfilePath() + "/extensions/");
@@ -165,7 +210,15 @@ void Plugins::loadPlugins()
         settingsDir.mkdir(settingsDir.absolutePath());
     }
 
+    QElapsedTimer totalTimer;
+    totalTimer.start();
+
     foreach (const QString &pluginId, m_allowedPlugins) {
+        StartupProfiler::Phase phase(pluginId);
+
+        QElapsedTimer timer;
+        timer.start();
+
         Plugin plugin = loadPlugin(pluginId);
         if (plugin.type == Plugin::Invalid) {
             continue;
@@ -174,15 +227,26 @@ void Plugins::loadPlugins()
             qWarning() << "Invalid plugin spec of" << pluginId << "plugin";
             continue;
         }
+
+        const qint64 loadTime = timer.restart();
+
         if (!initPlugin(PluginInterface::StartupInitState, &plugin)) {
             qWarning() << "Failed to init" << pluginId << "plugin";
             continue;
         }
         registerAvailablePlugin(plugin);
+
+        if (isDebugEnabled()) {
+            qDebug() << "Plugin" << pluginId << "loaded in" << loadTime << "ms, initialized in" << timer.elapsed() << "ms";
+        }
     }
 
     refreshLoadedPlugins();
 
+    if (isDebugEnabled()) {
+        qDebug() << "All plugins loaded in" << totalTimer.elapsed() << "ms";
+    }
+
     std::cout << "Falkon: " << m_loadedPlugins.count() << " extensions loaded"  << std::endl;
 }
 
@@ -200,13 +264,23 @@ void Plugins::loadAvailablePlugins()
     registerAvailablePlugin(loadInternalPlugin(QSL("adblock")));
 
     // SharedLibraryPlugin
+    loadSpecCache();
+
     for (const QString &dir : dirs) {
         const auto files = QDir(dir).entryInfoList(QDir::Files);
         for (const QFileInfo &info : files) {
             if (info.baseName() == QL1S("PyFalkon")) {
                 continue;
             }
-            Plugin plugin = loadSharedLibraryPlugin(info.absoluteFilePath());
+            // Already loaded on startup
+            if (isAvailablePluginRegistered(Plugin::SharedLibraryPlugin, QSL("lib:%1").arg(info.fileName()))) {
+                continue;
+            }
+            Plugin plugin = loadCachedSharedLibraryPlugin(info);
+            if (plugin.type == Plugin::Invalid && !m_specCache.contains(info.absoluteFilePath())) {
+                plugin = loadSharedLibraryPlugin(info.absoluteFilePath());
+                updateSpecCache(info, plugin.pluginSpec);
+            }
             if (plugin.type == Plugin::Invalid) {
                 continue;
             }
@@ -218,6 +292,8 @@ void Plugins::loadAvailablePlugins()
         }
     }
 
+    saveSpecCache();
+
     // PythonPlugin
     if (m_pythonPlugin) {
         auto f = (QVector<Plugin>(*)()) m_pythonPlugin->resolve("pyfalkon_load_available_plugins");
@@ -257,6 +333,127 @@ void Plugins::registerAvailablePlugin(const Plugin &plugin)
     }
 }
 
+bool Plugins::isAvailablePluginRegistered(Plugin::Type type, const QString &pluginId) const
+{
+    for (const Plugin &plugin : qAsConst(m_availablePlugins)) {
+        if (plugin.type == type && plugin.pluginId == pluginId) {
+            return true;
+        }
+    }
+    return false;
+}
+
+Plugins::Plugin Plugins::loadCachedSharedLibraryPlugin(const QFileInfo &info) const
+{
+    const auto it = m_specCache.constFind(info.absoluteFilePath());
+    if (it == m_specCache.constEnd()) {
+        return Plugin();
+    }
+
+    // Empty spec is cached for files that failed to load, those are skipped until changed
+    const CachedSpec &cached = it.value();
+    if (cached.spec.name.isEmpty()) {
+        return Plugin();
+    }
+
+    Plugin plugin;
+    plugin.type = Plugin::SharedLibraryPlugin;
+    plugin.pluginId = QSL("lib:%1").arg(info.fileName());
+    plugin.libraryPath = info.absoluteFilePath();
+    plugin.pluginSpec = cached.spec;
+    return plugin;
+}
+
+void Plugins::updateSpecCache(const QFileInfo &info, const PluginSpec &spec)
+{
+    CachedSpec cached;
+    cached.size = info.size();
+    cached.lastModified = info.lastModified().toMSecsSinceEpoch();
+    cached.spec = spec;
+    m_specCache[info.absoluteFilePath()] = cached;
+    m_specCacheChanged = true;
+}
+
+void Plugins::loadSpecCache()
+{
+    if (m_specCacheLoaded) {
+        return;
+    }
+
+    m_specCacheLoaded = true;
+
+    QFile file(DataPaths::path(DataPaths::Cache) + QL1S("/pluginspecs.dat"));
+    if (!file.open(QFile::ReadOnly)) {
+        return;
+    }
+
+    QDataStream stream(&file);
+
+    // Specs are translated and plugins must be rebuilt for each version
+    QString version;
+    QString locale;
+    stream >> version;
+    stream >> locale;
+    if (version != QString::fromLatin1(Qz::VERSION) || locale != QLocale().name()) {
+        m_specCacheChanged = true;
+        return;
+    }
+
+    int count;
+    stream >> count;
+
+    for (int i = 0; i < count && stream.status() == QDataStream::Ok; ++i) {
+        QString path;
+        CachedSpec cached;
+        stream >> path;
+        stream >> cached.size;
+        stream >> cached.lastModified;
+        stream >> cached.spec;
+
+        const QFileInfo info(path);
+        if (!info.exists() || info.size() != cached.size || info.lastModified().toMSecsSinceEpoch() != cached.lastModified) {
+            m_specCacheChanged = true;
+            continue;
+        }
+
+        m_specCache.insert(path, cached);
+    }
+
+    if (stream.status() != QDataStream::Ok) {
+        m_specCache.clear();
+        m_specCacheChanged = true;
+    }
+}
+
+void Plugins::saveSpecCache()
+{
+    if (!m_specCacheChanged) {
+        return;
+    }
+
+    m_specCacheChanged = false;
+
+    QSaveFile file(DataPaths::path(DataPaths::Cache) + QL1S("/pluginspecs.dat"));
+    if (!file.open(QFile::WriteOnly)) {
+        qWarning() << "Cannot save plugin specs cache" << file.fileName();
+        return;
+    }
+
+    QDataStream stream(&file);
+    stream << QString::fromLatin1(Qz::VERSION);
+    stream << QLocale().name();
+    stream << m_specCache.count();
+
+    for (auto it = m_specCache.constBegin(); it != m_specCache.constEnd(); ++it) {
+        stream << it.key();
+        stream << it.value().size;
+        stream << it.value().lastModified;
+        stream << it.value().spec;
+    }
+
+    file.commit();
+}
+
 void Plugins::refreshLoadedPlugins()
 {
     m_loadedPlugins.clear();
@@ -446,7 +643,16 @@ void Plugins::initSharedLibraryPlugin(Plugin *plugin)
 {
     Q_ASSERT(plugin->type == Plugin::SharedLibraryPlugin);
 
+    // Plugins with spec from cache don't have library loaded yet
+    if (!plugin->pluginLoader) {
+        plugin->pluginLoader = new QPluginLoader(plugin->libraryPath);
+    }
+
     plugin->instance = qobject_cast<PluginInterface*>(plugin->pluginLoader->instance());
+
+    if (!plugin->instance) {
+        qWarning() << "Loading" << plugin->libraryPath << "failed:" << plugin->pluginLoader->errorString();
+    }
 }
 
 void Plugins::initPythonPlugin(Plugin *plugin)
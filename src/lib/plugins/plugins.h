@@ -26,6 +26,7 @@
 #include "plugininterface.h"
 
 class QLibrary;
+class QFileInfo;
 class QPluginLoader;
 
 class SpeedDial;
@@ -98,12 +99,17 @@ public:
 
     static PluginSpec createSpec(const DesktopFile &metaData);
 
+    // Set FALKON_PLUGINS_DEBUG environment variable to print load times and time spent in handlers
+    static bool isDebugEnabled();
+
 public Q_SLOTS:
     void loadSettings();
 
     void loadPlugins();
 
 protected:
+    QString pluginName(PluginInterface *instance) const;
+
     QList<PluginInterface*> m_loadedPlugins;
 
 Q_SIGNALS:
@@ -122,6 +128,18 @@ private:
     void initPythonPlugin(Plugin *plugin);
 
     void registerAvailablePlugin(const Plugin &plugin);
+    bool isAvailablePluginRegistered(Plugin::Type type, const QString &pluginId) const;
+
+    // Specs of shared library plugins, so libraries don't need to be loaded only to read spec
+    struct CachedSpec {
+        qint64 size = 0;
+        qint64 lastModified = 0;
+        PluginSpec spec;
+    };
+    Plugin loadCachedSharedLibraryPlugin(const QFileInfo &info) const;
+    void updateSpecCache(const QFileInfo &info, const PluginSpec &spec);
+    void loadSpecCache();
+    void saveSpecCache();
 
     void refreshLoadedPlugins();
     void loadAvailablePlugins();
@@ -131,6 +149,10 @@ private:
 
     bool m_pluginsLoaded;
 
+    QHash<QString, CachedSpec> m_specCache;
+    bool m_specCacheLoaded = false;
+    bool m_specCacheChanged = false;
+
     SpeedDial* m_speedDial;
     QList<PluginInterface*> m_internalPlugins;
 
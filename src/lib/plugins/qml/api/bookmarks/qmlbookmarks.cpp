@@ -37,6 +37,7 @@ QmlBookmarks::QmlBookmarks(QObject *parent)
     connect(mApp->bookmarks(), &Bookmarks::bookmarkRemoved, this, [this](BookmarkItem *item){
         auto treeNode = QmlStaticData::instance().getBookmarkTreeNode(item);
         emit removed(treeNode);
+        QmlStaticData::instance().removeBookmarkTreeNode(item);
     });
 }
 
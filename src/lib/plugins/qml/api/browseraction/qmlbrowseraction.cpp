@@ -21,7 +21,7 @@
 #include "statusbar.h"
 #include "pluginproxy.h"
 #include "qml/api/fileutils/qmlfileutils.h"
-#include "qml/qmlengine.h"
+#include "qml/qmlplugincontext.h"
 #include "qml/qmlstaticdata.h"
 #include <QQuickWidget>
 #include <QQmlContext>
@@ -217,11 +217,11 @@ void QmlBrowserActionButton::setIcon(const QString &icon)
     if (!m_popup) {
         return;
     }
-    auto qmlEngine = qobject_cast<QmlEngine*>(m_popup->creationContext()->engine());
-    if (!qmlEngine) {
+    QmlPluginContext *context = QmlPluginContext::fromContext(m_popup->creationContext());
+    if (!context) {
         return;
     }
-    const QString pluginPath = qmlEngine->extensionPath();
+    const QString pluginPath = context->extensionPath();
     QIcon qicon = QmlStaticData::instance().getIcon(m_iconUrl, pluginPath);
     AbstractButtonInterface::setIcon(qicon);
 }
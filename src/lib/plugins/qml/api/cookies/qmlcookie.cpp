@@ -22,7 +22,12 @@ QmlCookie::QmlCookie(QNetworkCookie *cookie, QObject *parent)
     : QObject(parent)
     , m_cookie(cookie)
 {
-    QQmlEngine::setObjectOwnership(this, QQmlEngine::CppOwnership);
+    QQmlEngine::setObjectOwnership(this, QQmlEngine::JavaScriptOwnership);
+}
+
+QmlCookie::~QmlCookie()
+{
+    delete m_cookie;
 }
 
 QString QmlCookie::domain() const
@@ -64,6 +64,7 @@ class QmlCookie : public QObject
     Q_PROPERTY(QString value READ value CONSTANT)
 public:
     explicit QmlCookie(QNetworkCookie *cookie, QObject *parent = nullptr);
+    ~QmlCookie() override;
 
 private:
     QNetworkCookie *m_cookie = nullptr;
@@ -25,7 +25,11 @@
 QmlCookies::QmlCookies(QObject *parent)
     : QObject(parent)
 {
+    // Wrappers are owned by JavaScript, create them only when there is someone to receive them
     connect(mApp->cookieJar(), &CookieJar::cookieAdded, this, [this](const QNetworkCookie &network_cookie){
+        if (!isSignalConnected(QMetaMethod::fromSignal(&QmlCookies::changed))) {
+            return;
+        }
         QmlCookie *cookie = QmlStaticData::instance().getCookie(network_cookie);
         QVariantMap map;
         map.insert(QSL("cookie"), QVariant::fromValue(cookie));
@@ -34,6 +38,9 @@ QmlCookies::QmlCookies(QObject *parent)
     });
 
     connect(mApp->cookieJar(), &CookieJar::cookieRemoved, this, [this](const QNetworkCookie &network_cookie){
+        if (!isSignalConnected(QMetaMethod::fromSignal(&QmlCookies::changed))) {
+            return;
+        }
         QmlCookie *cookie = QmlStaticData::instance().getCookie(network_cookie);
         QVariantMap map;
         map.insert(QSL("cookie"), QVariant::fromValue(cookie));
@@ -25,12 +25,19 @@
 QmlHistory::QmlHistory(QObject *parent)
     : QObject(parent)
 {
+    // Wrappers are owned by JavaScript, create them only when there is someone to receive them
     connect(mApp->history(), &History::historyEntryAdded, this, [this](const HistoryEntry &entry){
+        if (!isSignalConnected(QMetaMethod::fromSignal(&QmlHistory::visited))) {
+            return;
+        }
         QmlHistoryItem *historyItem = QmlStaticData::instance().getHistoryItem(entry);
         emit visited(historyItem);
     });
 
     connect(mApp->history(), &History::historyEntryDeleted, this, [this](const HistoryEntry &entry){
+        if (!isSignalConnected(QMetaMethod::fromSignal(&QmlHistory::visitRemoved))) {
+            return;
+        }
         QmlHistoryItem *historyItem = QmlStaticData::instance().getHistoryItem(entry);
         emit visitRemoved(historyItem);
     });
@@ -83,9 +90,7 @@ void QmlHistory::deleteRange(const QVariantMap &map)
     const qlonglong endTime = map.value(QSL("endTime")).toLongLong();
 
     const QList<int> entries = mApp->history()->indexesFromTimeRange(startTime, endTime);
-    for (int index : entries) {
-        mApp->history()->deleteHistoryEntry(index);
-    }
+    mApp->history()->deleteHistoryEntry(entries);
 }
 
 void QmlHistory::deleteAll()
@@ -22,7 +22,7 @@ QmlHistoryItem::QmlHistoryItem(const HistoryEntry &entry, QObject *parent)
     : QObject(parent)
     , m_entry(entry)
 {
-    QQmlEngine::setObjectOwnership(this, QQmlEngine::CppOwnership);
+    QQmlEngine::setObjectOwnership(this, QQmlEngine::JavaScriptOwnership);
 }
 
 int QmlHistoryItem::id() const
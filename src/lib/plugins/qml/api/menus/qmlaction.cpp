@@ -18,16 +18,14 @@
 #include "qmlaction.h"
 #include "qztools.h"
 #include "qml/api/fileutils/qmlfileutils.h"
-#include "qml/qmlengine.h"
 #include "qml/qmlstaticdata.h"
 #include <QQmlEngine>
 
-QmlAction::QmlAction(QAction *action, QmlEngine *engine, QObject *parent)
+QmlAction::QmlAction(QAction *action, const QString &pluginPath, QObject *parent)
     : QObject(parent)
     , m_action(action)
+    , m_pluginPath(pluginPath)
 {
-    QmlEngine *qmlEngine = qobject_cast<QmlEngine*>(engine);
-    m_pluginPath = qmlEngine->extensionPath();
     connect(m_action, &QAction::triggered, this, &QmlAction::triggered);
 }
 
@@ -21,8 +21,6 @@
 #include <QAction>
 #include <QVariantMap>
 
-class QmlEngine;
-
 /**
  * @brief The class exposing Action API to QML
  */
@@ -30,7 +28,7 @@ class QmlAction : public QObject
 {
     Q_OBJECT
 public:
-    explicit QmlAction(QAction *action, QmlEngine *engine, QObject *parent = nullptr);
+    explicit QmlAction(QAction *action, const QString &pluginPath, QObject *parent = nullptr);
     void setProperties(const QVariantMap &map);
     /**
      * @brief Updates the properties of the action
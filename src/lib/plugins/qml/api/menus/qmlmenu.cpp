@@ -18,17 +18,16 @@
 #include "qmlmenu.h"
 #include "qztools.h"
 #include "qml/api/fileutils/qmlfileutils.h"
-#include "qml/qmlengine.h"
 #include "qml/qmlstaticdata.h"
 
-QmlMenu::QmlMenu(QMenu *menu, QQmlEngine *engine, QObject *parent)
+QmlMenu::QmlMenu(QMenu *menu, QQmlEngine *engine, const QString &pluginPath, QObject *parent)
     : QObject(parent)
     , m_menu(menu)
+    , m_pluginPath(pluginPath)
+    , m_engine(engine)
 {
     QQmlEngine::setObjectOwnership(this, QQmlEngine::JavaScriptOwnership);
 
-    m_engine = qobject_cast<QmlEngine*>(engine);
-    m_pluginPath = m_engine->extensionPath();
     connect(m_menu, &QMenu::triggered, this, &QmlMenu::triggered);
 }
 
@@ -39,7 +38,7 @@ QmlAction *QmlMenu::addAction(const QVariantMap &map)
     }
 
     QAction *action = new QAction();
-    QmlAction *qmlAction = new QmlAction(action, m_engine, this);
+    QmlAction *qmlAction = new QmlAction(action, m_pluginPath, this);
     qmlAction->setProperties(map);
     m_menu->addAction(action);
 
@@ -64,7 +63,7 @@ QmlMenu *QmlMenu::addMenu(const QVariantMap &map)
         newMenu->setProperty(key.toUtf8(), map.value(key));
     }
     m_menu->addMenu(newMenu);
-    QmlMenu *newQmlMenu = new QmlMenu(newMenu, m_engine, this);
+    QmlMenu *newQmlMenu = new QmlMenu(newMenu, m_engine, m_pluginPath, this);
     return newQmlMenu;
 }
 
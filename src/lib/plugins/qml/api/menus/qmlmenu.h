@@ -21,8 +21,6 @@
 #include <QMenu>
 #include <QQmlEngine>
 
-class QmlEngine;
-
 /**
  * @brief The class exposing WebView contextmenu to QML as Menu API
  */
@@ -30,7 +28,7 @@ class QmlMenu : public QObject
 {
     Q_OBJECT
 public:
-    explicit QmlMenu(QMenu *menu, QQmlEngine *engine, QObject *parent = nullptr);
+    explicit QmlMenu(QMenu *menu, QQmlEngine *engine, const QString &pluginPath, QObject *parent = nullptr);
     /**
      * @brief Adds action to menu
      * @param A JavaScript object containing properties for action.
@@ -60,5 +58,5 @@ Q_SIGNALS:
 private:
     QMenu *m_menu = nullptr;
     QString m_pluginPath;
-    QmlEngine *m_engine = nullptr;
+    QQmlEngine *m_engine = nullptr;
 };
@@ -20,7 +20,7 @@
 #include "qztools.h"
 #include "sidebar.h"
 #include "qml/api/fileutils/qmlfileutils.h"
-#include "qml/qmlengine.h"
+#include "qml/qmlplugincontext.h"
 #include "qml/qmlstaticdata.h"
 #include <QAction>
 #include <QQuickWidget>
@@ -137,11 +137,11 @@ QAction *QmlSideBarHelper::createMenuAction()
     if (!m_item) {
         return action;
     }
-    auto qmlEngine = qobject_cast<QmlEngine*>(m_item->creationContext()->engine());
-    if (qmlEngine) {
+    QmlPluginContext *context = QmlPluginContext::fromContext(m_item->creationContext());
+    if (!context) {
         return action;
     }
-    const QString pluginPath = qmlEngine->extensionPath();
+    const QString pluginPath = context->extensionPath();
     const QIcon icon = QmlStaticData::instance().getIcon(m_iconUrl, pluginPath);
     action->setIcon(icon);
     return action;
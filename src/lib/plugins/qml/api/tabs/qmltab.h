@@ -19,6 +19,7 @@
 
 #include <QObject>
 #include <QJSValue>
+#include <QPointer>
 #include <QWebEnginePage>
 
 #include "webtab.h"
@@ -258,7 +259,7 @@ Q_SIGNALS:
     void navigationRequestAccepted(const QUrl &url, QWebEnginePage::NavigationType type, bool isMainFrame);
 
 private:
-    WebTab *m_webTab = nullptr;
+    QPointer<WebTab> m_webTab;
     WebPage *m_webPage = nullptr;
     QList<QMetaObject::Connection> m_lambdaConnections;
 
@@ -23,7 +23,7 @@ QmlMostVisitedUrl::QmlMostVisitedUrl(const QString &title, const QString &url, Q
     , m_title(title)
     , m_url(url)
 {
-    QQmlEngine::setObjectOwnership(this, QQmlEngine::CppOwnership);
+    QQmlEngine::setObjectOwnership(this, QQmlEngine::JavaScriptOwnership);
 }
 
 QString QmlMostVisitedUrl::title() const
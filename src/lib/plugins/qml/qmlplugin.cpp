@@ -20,6 +20,7 @@
 #include "qmlpluginloader.h"
 #include "datapaths.h"
 #include "desktopfile.h"
+#include "settings.h"
 
 #include <QFileInfo>
 #include <QDir>
@@ -30,11 +31,7 @@ QmlPlugin::QmlPlugin()
 
 Plugins::Plugin QmlPlugin::loadPlugin(const QString &name)
 {
-    static bool qmlSupportLoaded = false;
-    if (!qmlSupportLoaded) {
-        QmlPlugins::registerQmlTypes();
-        qmlSupportLoaded = true;
-    }
+    QmlPlugins::registerQmlTypes();
 
     QString fullPath;
     if (QFileInfo(name).isAbsolute()) {
@@ -53,7 +50,10 @@ Plugins::Plugin QmlPlugin::loadPlugin(const QString &name)
     DesktopFile desktopFile(fullPath + QSL("/metadata.desktop"));
     plugin.pluginSpec = Plugins::createSpec(desktopFile);
     QString entryPoint = desktopFile.value(QSL("X-Falkon-EntryPoint")).toString();
-    plugin.data = QVariant::fromValue(new QmlPluginLoader(plugin.pluginSpec.name, fullPath, entryPoint));
+    static const bool sharedEngine = Settings().value(QSL("Plugin-Settings/SharedQmlEngine"), false).toBool();
+    // FileUtils and Notifications singletons are per engine, plugins must opt in to the shared engine
+    const bool useSharedEngine = sharedEngine && desktopFile.value(QSL("X-Falkon-SharedEngine")).toBool();
+    plugin.data = QVariant::fromValue(new QmlPluginLoader(plugin.pluginSpec.name, fullPath, entryPoint, useSharedEngine));
     return plugin;
 }
 
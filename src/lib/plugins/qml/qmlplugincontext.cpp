@@ -0,0 +1,53 @@
+/* ============================================================
+* Falkon - Qt web browser
+* Copyright (C) 2018 Anmol Gautam <tarptaeya@gmail.com>
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program.  If not, see <http://www.gnu.org/licenses/>.
+* ============================================================ */
+#include "qmlplugincontext.h"
+
+QmlPluginContext::QmlPluginContext(QQmlEngine *engine, const QString &name, const QString &path, QObject *parent)
+    : QQmlContext(engine, parent)
+    , m_extensionName(name)
+    , m_extensionPath(path)
+{
+}
+
+QString QmlPluginContext::extensionName() const
+{
+    return m_extensionName;
+}
+
+QString QmlPluginContext::extensionPath() const
+{
+    return m_extensionPath;
+}
+
+// static
+QmlPluginContext *QmlPluginContext::fromContext(QQmlContext *context)
+{
+    while (context) {
+        if (auto *pluginContext = qobject_cast<QmlPluginContext*>(context)) {
+            return pluginContext;
+        }
+        context = context->parentContext();
+    }
+    return nullptr;
+}
+
+// static
+QmlPluginContext *QmlPluginContext::fromObject(QObject *object)
+{
+    return fromContext(QQmlEngine::contextForObject(object));
+}
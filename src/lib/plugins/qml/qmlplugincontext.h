@@ -0,0 +1,44 @@
+/* ============================================================
+* Falkon - Qt web browser
+* Copyright (C) 2018 Anmol Gautam <tarptaeya@gmail.com>
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program.  If not, see <http://www.gnu.org/licenses/>.
+* ============================================================ */
+#pragma once
+
+#include <QQmlContext>
+
+/**
+ * @brief Root context of a QML plugin
+ *
+ * Every QML plugin is created in its own context, which holds
+ * the extension name and path even when the engine is shared
+ * with other plugins.
+ */
+class QmlPluginContext : public QQmlContext
+{
+    Q_OBJECT
+public:
+    explicit QmlPluginContext(QQmlEngine *engine, const QString &name, const QString &path, QObject *parent = nullptr);
+
+    QString extensionName() const;
+    QString extensionPath() const;
+
+    static QmlPluginContext *fromContext(QQmlContext *context);
+    static QmlPluginContext *fromObject(QObject *object);
+
+private:
+    QString m_extensionName;
+    QString m_extensionPath;
+};
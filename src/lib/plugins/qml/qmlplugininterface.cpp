@@ -32,6 +32,7 @@
 #include "webpage.h"
 #include "qztools.h"
 #include "qml/qmlengine.h"
+#include "qml/qmlplugincontext.h"
 #include <QDebug>
 #include <QQuickWidget>
 #include <QDialog>
@@ -100,7 +101,8 @@ void QmlPluginInterface::populateWebViewMenu(QMenu *menu, WebView *webview, cons
         return;
     }
 
-    QmlMenu *qmlMenu = new QmlMenu(menu, m_engine);
+    QmlPluginContext *context = QmlPluginContext::fromObject(this);
+    QmlMenu *qmlMenu = new QmlMenu(menu, m_engine, context ? context->extensionPath() : QString());
     QmlWebHitTestResult *qmlWebHitTestResult = new QmlWebHitTestResult(webHitTestResult);
     QJSValueList args;
     args.append(m_engine->newQObject(qmlMenu));
@@ -17,25 +17,74 @@
 * ============================================================ */
 #include "qmlpluginloader.h"
 #include "qmlengine.h"
+#include "qmlplugincontext.h"
+#include "qztools.h"
 #include <QQmlContext>
 #include <QDir>
+#include <QFile>
+#include <QElapsedTimer>
+#include <QCoreApplication>
+#include <QPointer>
 #include "../config.h"
 
 #if HAVE_LIBINTL
 #include "qml/api/i18n/qmli18n.h"
 #endif
 
-QmlPluginLoader::QmlPluginLoader(const QString &name, const QString &path, const QString &entryPoint)
+#ifdef Q_OS_LINUX
+#include <unistd.h>
+#endif
+
+static const bool kEnablePluginStats = qEnvironmentVariableIsSet("FALKON_QML_PLUGIN_STATS");
+
+static qint64 residentMemory()
+{
+    if (!kEnablePluginStats) {
+        return -1;
+    }
+
+#ifdef Q_OS_LINUX
+    QFile file(QSL("/proc/self/statm"));
+    if (file.open(QFile::ReadOnly)) {
+        const QList<QByteArray> fields = file.readAll().split(' ');
+        if (fields.size() > 1) {
+            return fields.at(1).toLongLong() * sysconf(_SC_PAGESIZE);
+        }
+    }
+#endif
+    return -1;
+}
+
+QmlPluginLoader::QmlPluginLoader(const QString &name, const QString &path, const QString &entryPoint, bool sharedEngine)
 {
     m_name = name;
     m_path = path;
     m_entryPoint = entryPoint;
-    initEngineAndComponent();
+    m_sharedEngine = sharedEngine;
 }
 
 void QmlPluginLoader::createComponent()
 {
-    m_interface = qobject_cast<QmlPluginInterface*>(m_component->create(m_component->creationContext()));
+    QElapsedTimer timer;
+    timer.start();
+    const qint64 memory = residentMemory();
+
+    // Engine and component are only created once plugin gets enabled,
+    // listing available plugins reads just metadata
+    if (!m_component) {
+        initEngineAndComponent();
+    }
+
+    m_interface = qobject_cast<QmlPluginInterface*>(m_component->create(m_context));
+
+    m_loadTime = timer.elapsed();
+    m_memoryUsage = memory < 0 ? -1 : residentMemory() - memory;
+
+    if (kEnablePluginStats) {
+        qDebug().noquote() << "QML plugin" << m_name << "loaded in" << m_loadTime << "ms,"
+                           << (m_memoryUsage < 0 ? QSL("unknown memory") : QzTools::fileSizeToString(m_memoryUsage))
+                           << (m_sharedEngine ? "(shared engine)" : "(own engine)");
+    }
 
     if (!m_interface) {
         return;
@@ -44,9 +93,11 @@ void QmlPluginLoader::createComponent()
     m_interface->setEngine(m_engine);
     m_interface->setName(m_name);
     connect(m_interface, &QmlPluginInterface::qmlPluginUnloaded, this, [this] {
-        delete m_component;
-        delete m_engine;
-        initEngineAndComponent();
+        // Interface is still used by Plugins after unload() returns
+        m_interface->deleteLater();
+        m_interface = nullptr;
+
+        destroyEngineAndComponent();
     });
 }
 
@@ -60,19 +111,81 @@ QmlPluginInterface *QmlPluginLoader::instance() const
     return m_interface;
 }
 
+bool QmlPluginLoader::isUsingSharedEngine() const
+{
+    return m_sharedEngine;
+}
+
+qint64 QmlPluginLoader::loadTime() const
+{
+    return m_loadTime;
+}
+
+qint64 QmlPluginLoader::memoryUsage() const
+{
+    return m_memoryUsage;
+}
+
 void QmlPluginLoader::initEngineAndComponent()
 {
-    m_engine = new QmlEngine();
+    if (m_sharedEngine) {
+        m_engine = sharedEngine();
+    } else {
+        m_engine = new QmlEngine();
+        m_engine->setExtensionPath(m_path);
+        m_engine->setExtensionName(m_name);
+    }
+
+    m_context = new QmlPluginContext(m_engine, m_name, m_path);
     m_component = new QQmlComponent(m_engine, QDir(m_path).filePath(m_entryPoint));
-    m_engine->setExtensionPath(m_path);
-    m_engine->setExtensionName(m_name);
+    setupI18n();
+}
+
+void QmlPluginLoader::destroyEngineAndComponent()
+{
+    delete m_component;
+    m_component = nullptr;
+
+    // Invalidates all bindings and objects created in plugin context
+    delete m_context;
+    m_context = nullptr;
+
+    if (m_sharedEngine) {
+        m_engine->collectGarbage();
+        m_engine->trimComponentCache();
+    } else {
+        delete m_engine;
+    }
+    m_engine = nullptr;
+}
+
+void QmlPluginLoader::setupI18n()
+{
 #if HAVE_LIBINTL
-    auto i18n = new QmlI18n(m_name);
-    m_engine->globalObject().setProperty(QSL("__falkon_i18n"), m_engine->newQObject(i18n));
-    m_engine->globalObject().setProperty(QSL("i18n"), m_engine->evaluate(QSL("function (s) { return __falkon_i18n.i18n(s) }")));
-    m_engine->globalObject().setProperty(QSL("i18np"), m_engine->evaluate(QSL("function (s1, s2) { return __falkon_i18n.i18np(s1, s2) }")));
+    const QJSValue i18n = m_engine->newQObject(new QmlI18n(m_name, m_context));
+    const QJSValue i18nFunction = m_engine->evaluate(QSL("(function (o) { return function (s) { return o.i18n(s) } })")).call({i18n});
+    const QJSValue i18npFunction = m_engine->evaluate(QSL("(function (o) { return function (s1, s2, n) { return o.i18np(s1, s2, n) } })")).call({i18n});
 #else
-    m_engine->globalObject().setProperty(QSL("i18n"), m_engine->evaluate(QSL("function (s) { return s }")));
-    m_engine->globalObject().setProperty(QSL("i18np"), m_engine->evaluate(QSL("function (s1, s2) { return s1 }")));
+    const QJSValue i18nFunction = m_engine->evaluate(QSL("(function (s) { return s })"));
+    const QJSValue i18npFunction = m_engine->evaluate(QSL("(function (s1, s2) { return s1 })"));
 #endif
+
+    if (m_sharedEngine) {
+        // Global object is shared by all plugins, each plugin has its own translation domain
+        m_context->setContextProperty(QSL("i18n"), QVariant::fromValue(i18nFunction));
+        m_context->setContextProperty(QSL("i18np"), QVariant::fromValue(i18npFunction));
+    } else {
+        m_engine->globalObject().setProperty(QSL("i18n"), i18nFunction);
+        m_engine->globalObject().setProperty(QSL("i18np"), i18npFunction);
+    }
+}
+
+// static
+QmlEngine *QmlPluginLoader::sharedEngine()
+{
+    static QPointer<QmlEngine> engine;
+    if (!engine) {
+        engine = new QmlEngine(QCoreApplication::instance());
+    }
+    return engine;
 }
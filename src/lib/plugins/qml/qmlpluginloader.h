@@ -24,24 +24,41 @@
 #include "plugins.h"
 
 class QmlEngine;
+class QmlPluginContext;
 
 class QmlPluginLoader : public QObject
 {
     Q_OBJECT
 public:
-    explicit QmlPluginLoader(const QString &name, const QString &path, const QString &entryPoint);
+    explicit QmlPluginLoader(const QString &name, const QString &path, const QString &entryPoint, bool sharedEngine = false);
     void createComponent();
     QQmlComponent *component() const;
     QmlPluginInterface *instance() const;
+
+    bool isUsingSharedEngine() const;
+
+    // Time spent loading the plugin in ms and resident memory it added in bytes,
+    // memory is only measured with FALKON_QML_PLUGIN_STATS set, -1 otherwise
+    qint64 loadTime() const;
+    qint64 memoryUsage() const;
+
 private:
     QString m_path;
     QString m_name;
     QString m_entryPoint;
+    bool m_sharedEngine = false;
     QmlEngine *m_engine = nullptr;
+    QmlPluginContext *m_context = nullptr;
     QQmlComponent *m_component = nullptr;
     QmlPluginInterface *m_interface = nullptr;
+    qint64 m_loadTime = 0;
+    qint64 m_memoryUsage = 0;
 
     void initEngineAndComponent();
+    void destroyEngineAndComponent();
+    void setupI18n();
+
+    static QmlEngine *sharedEngine();
 };
 
 Q_DECLARE_METATYPE(QmlPluginLoader *)
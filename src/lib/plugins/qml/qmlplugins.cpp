@@ -56,6 +56,12 @@
 // static
 void QmlPlugins::registerQmlTypes()
 {
+    static bool registered = false;
+    if (registered) {
+        return;
+    }
+    registered = true;
+
     const char *url = "org.kde.falkon";
     const int majorVersion = 1;
     const int minorVersion = 0;
@@ -85,11 +91,12 @@ void QmlPlugins::registerQmlTypes()
     // History
     qmlRegisterUncreatableType<QmlHistoryItem>(url, majorVersion, minorVersion, "HistoryItem", QSL("Unable to register type: HistoryItem"));
 
+    // History and Cookies emit JavaScript owned wrappers, each engine needs its own instance
     qmlRegisterSingletonType<QmlHistory>(url, majorVersion, minorVersion, "History", [](QQmlEngine *engine, QJSEngine *scriptEngine) -> QObject * {
         Q_UNUSED(engine)
         Q_UNUSED(scriptEngine)
 
-        return QmlStaticData::instance().getHistorySingleton();
+        return new QmlHistory();
     });
 
     // Cookies
@@ -99,7 +106,7 @@ void QmlPlugins::registerQmlTypes()
         Q_UNUSED(engine)
         Q_UNUSED(scriptEngine)
 
-        return QmlStaticData::instance().getCookiesSingleton();
+        return new QmlCookies();
     });
 
     // Tabs
@@ -45,10 +45,7 @@ QmlStaticData::QmlStaticData(QObject *parent)
 QmlStaticData::~QmlStaticData()
 {
     qDeleteAll(m_bookmarkTreeNodes);
-    qDeleteAll(m_cookies);
-    qDeleteAll(m_historyItems);
     qDeleteAll(m_tabs);
-    qDeleteAll(m_urls);
     qDeleteAll(m_windows);
 }
 
@@ -70,22 +67,12 @@ QmlBookmarkTreeNode *QmlStaticData::getBookmarkTreeNode(BookmarkItem *item)
 
 QmlCookie *QmlStaticData::getCookie(const QNetworkCookie &cookie)
 {
-    QmlCookie *qmlCookie = m_cookies.value(cookie);
-    if (!qmlCookie) {
-        qmlCookie = new QmlCookie(new QNetworkCookie(cookie));
-        m_cookies.insert(cookie, qmlCookie);
-    }
-    return qmlCookie;
+    return new QmlCookie(new QNetworkCookie(cookie));
 }
 
 QmlHistoryItem *QmlStaticData::getHistoryItem(const HistoryEntry &entry)
 {
-    QmlHistoryItem *item = m_historyItems.value(entry);
-    if (!item) {
-        item = new QmlHistoryItem(entry);
-        m_historyItems.insert(entry, item);
-    }
-    return item;
+    return new QmlHistoryItem(entry);
 }
 
 QmlTab *QmlStaticData::getTab(WebTab *webTab)
@@ -94,18 +81,21 @@ QmlTab *QmlStaticData::getTab(WebTab *webTab)
     if (!tab) {
         tab = new QmlTab(webTab);
         m_tabs.insert(webTab, tab);
+        if (webTab) {
+            connect(webTab, &QObject::destroyed, this, [this, webTab] {
+                QmlTab *tab = m_tabs.take(webTab);
+                if (tab) {
+                    tab->deleteLater();
+                }
+            });
+        }
     }
     return tab;
 }
 
 QmlMostVisitedUrl *QmlStaticData::getMostVisitedUrl(const QString &title, const QString &url)
 {
-    QmlMostVisitedUrl *visitedUrl = m_urls.value({title, url});
-    if (!visitedUrl) {
-        visitedUrl = new QmlMostVisitedUrl(title, url);
-        m_urls.insert({title, url}, visitedUrl);
-    }
-    return visitedUrl;
+    return new QmlMostVisitedUrl(title, url);
 }
 
 QmlWindow *QmlStaticData::getWindow(BrowserWindow *window)
@@ -114,10 +104,26 @@ QmlWindow *QmlStaticData::getWindow(BrowserWindow *window)
     if (!qmlWindow) {
         qmlWindow = new QmlWindow(window);
         m_windows.insert(window, qmlWindow);
+        if (window) {
+            connect(window, &QObject::destroyed, this, [this, window] {
+                QmlWindow *qmlWindow = m_windows.take(window);
+                if (qmlWindow) {
+                    qmlWindow->deleteLater();
+                }
+            });
+        }
     }
     return qmlWindow;
 }
 
+void QmlStaticData::removeBookmarkTreeNode(BookmarkItem *item)
+{
+    QmlBookmarkTreeNode *node = m_bookmarkTreeNodes.take(item);
+    if (node) {
+        node->deleteLater();
+    }
+}
+
 QHash<BrowserWindow*, int> QmlStaticData::windowIdHash()
 {
     return m_windowIdHash;
@@ -141,18 +147,6 @@ QmlBookmarks *QmlStaticData::getBookmarksSingleton()
     return bookmarks;
 }
 
-QmlHistory *QmlStaticData::getHistorySingleton()
-{
-    static QmlHistory *history = new QmlHistory(this);
-    return history;
-}
-
-QmlCookies *QmlStaticData::getCookiesSingleton()
-{
-    static QmlCookies *cookies = new QmlCookies(this);
-    return cookies;
-}
-
 QmlTopSites *QmlStaticData::getTopSitesSingleton()
 {
     static QmlTopSites *topSites = new QmlTopSites(this);
@@ -17,6 +17,7 @@
 * ============================================================ */
 #pragma once
 
+#include "qzcommon.h"
 #include "mainapplication.h"
 #include "browserwindow.h"
 #include "bookmarkitem.h"
@@ -41,7 +42,7 @@ class QmlTab;
 class QmlMostVisitedUrl;
 class QmlWindow;
 
-class QmlStaticData : public QObject
+class FALKON_EXPORT QmlStaticData : public QObject
 {
     Q_OBJECT
 
@@ -51,18 +52,19 @@ public:
 
     static QmlStaticData &instance();
     QmlBookmarkTreeNode *getBookmarkTreeNode(BookmarkItem *item);
+    // Value wrappers are owned by JavaScript, every call returns new wrapper
     QmlCookie *getCookie(const QNetworkCookie &cookie);
     QmlHistoryItem *getHistoryItem(const HistoryEntry &entry);
     QmlTab *getTab(WebTab *webTab);
     QmlMostVisitedUrl *getMostVisitedUrl(const QString &title = QString(), const QString &url = QString());
     QmlWindow *getWindow(BrowserWindow *window);
 
+    void removeBookmarkTreeNode(BookmarkItem *item);
+
     QHash<BrowserWindow*, int> windowIdHash();
     QIcon getIcon(const QString &iconPath, const QString &pluginPath);
 
     QmlBookmarks *getBookmarksSingleton();
-    QmlHistory *getHistorySingleton();
-    QmlCookies *getCookiesSingleton();
     QmlTopSites *getTopSitesSingleton();
     QmlTabs *getTabsSingleton();
     QmlClipboard *getClipboardSingleton();
@@ -71,10 +73,7 @@ public:
     QmlUserScripts *getUserScriptsSingleton();
 private:
     QHash<BookmarkItem*, QmlBookmarkTreeNode*> m_bookmarkTreeNodes;
-    QHash<QNetworkCookie, QmlCookie*> m_cookies;
-    QHash<HistoryEntry, QmlHistoryItem*> m_historyItems;
     QHash<WebTab*, QmlTab*> m_tabs;
-    QHash<QPair<QString, QString>, QmlMostVisitedUrl*> m_urls;
     QHash<BrowserWindow*, QmlWindow*> m_windows;
 
     int m_newWindowId = 0;
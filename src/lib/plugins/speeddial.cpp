@@ -23,10 +23,13 @@
 #include "autosaver.h"
 
 #include <QDir>
+#include <QDateTime>
+#include <QFileInfo>
 #include <QCryptographicHash>
 #include <QFileDialog>
 #include <QWebEnginePage>
 #include <QImage>
+#include <QApplication>
 #include <QJsonDocument>
 
 #define ENSURE_LOADED if (!m_loaded) loadSettings();
@@ -203,17 +206,10 @@ QString SpeedDial::initialScript()
     QVariantList pages;
 
     foreach (const Page &page, m_pages) {
-        QString imgSource = m_thumbnailsDir + QCryptographicHash::hash(page.url.toUtf8(), QCryptographicHash::Md4).toHex() + ".png";
+        QString imgSource = thumbnailUrl(page.url);
 
-        if (!QFile(imgSource).exists()) {
-            imgSource = "qrc:html/loading.gif";
-
-            if (!page.isValid()) {
-                imgSource.clear();
-            }
-        }
-        else {
-            imgSource = QzTools::pixmapToDataUrl(QPixmap(imgSource)).toString();
+        if (imgSource.isEmpty() && page.isValid()) {
+            imgSource = QSL("qrc:html/loading.gif");
         }
 
         QVariantMap map;
@@ -261,6 +257,7 @@ void SpeedDial::loadThumbnail(const QString &url, bool loadTitle)
     PageThumbnailer* thumbnailer = new PageThumbnailer(this);
     thumbnailer->setUrl(QUrl::fromEncoded(url.toUtf8()));
     thumbnailer->setLoadTitle(loadTitle);
+    thumbnailer->setSize(thumbnailSize());
     connect(thumbnailer, &PageThumbnailer::thumbnailCreated, this, &SpeedDial::thumbnailCreated);
 
     thumbnailer->start();
@@ -268,13 +265,31 @@ void SpeedDial::loadThumbnail(const QString &url, bool loadTitle)
 
 void SpeedDial::removeImageForUrl(const QString &url)
 {
-    QString fileName = m_thumbnailsDir + QCryptographicHash::hash(url.toUtf8(), QCryptographicHash::Md4).toHex() + ".png";
+    QString fileName = m_thumbnailsDir + thumbnailHash(url) + QL1S(".png");
 
     if (QFile(fileName).exists()) {
         QFile(fileName).remove();
     }
 }
 
+QString SpeedDial::thumbnailFileName(const QString &hash)
+{
+    ENSURE_LOADED;
+
+    // Only accept hex encoded MD4 hashes, nothing else is ever stored in thumbnails directory
+    if (hash.size() != 32) {
+        return QString();
+    }
+
+    for (const QChar &c : hash) {
+        if (!c.isDigit() && (c < QL1C('a') || c > QL1C('f'))) {
+            return QString();
+        }
+    }
+
+    return m_thumbnailsDir + hash + QL1S(".png");
+}
+
 QStringList SpeedDial::getOpenFileName()
 {
     const QString fileTypes = QString("%3(*.png *.jpg *.jpeg *.bmp *.gif *.svg *.tiff)").arg(tr("Image files"));
@@ -329,17 +344,18 @@ void SpeedDial::thumbnailCreated(const QPixmap &pixmap)
     bool loadTitle = thumbnailer->loadTitle();
     QString title = thumbnailer->title();
     QString url = thumbnailer->url().toString();
-    QString fileName = m_thumbnailsDir + QCryptographicHash::hash(url.toUtf8(), QCryptographicHash::Md4).toHex() + ".png";
+    QString fileName = m_thumbnailsDir + thumbnailHash(url) + QL1S(".png");
+    QString imgSource;
 
     if (pixmap.isNull()) {
-        fileName = ":/html/broken-page.svg";
+        imgSource = QSL("qrc:html/broken-page.svg");
         title = tr("Unable to load");
     }
     else {
         if (!pixmap.save(fileName, "PNG")) {
             qWarning() << "SpeedDial::thumbnailCreated Cannot save thumbnail to " << fileName;
         }
-        //fileName = QUrl::fromLocalFile(fileName).toString();
+        imgSource = thumbnailUrl(url);
     }
 
     m_regenerateScript = true;
@@ -348,7 +364,32 @@ void SpeedDial::thumbnailCreated(const QPixmap &pixmap)
     if (loadTitle)
         emit pageTitleLoaded(url, title);
 
-    emit thumbnailLoaded(url, QzTools::pixmapToDataUrl(QPixmap(fileName)).toString());
+    emit thumbnailLoaded(url, imgSource);
+}
+
+QString SpeedDial::thumbnailHash(const QString &url) const
+{
+    return QString::fromLatin1(QCryptographicHash::hash(url.toUtf8(), QCryptographicHash::Md4).toHex());
+}
+
+QString SpeedDial::thumbnailUrl(const QString &url) const
+{
+    const QString hash = thumbnailHash(url);
+    const QFileInfo info(m_thumbnailsDir + hash + QL1S(".png"));
+
+    if (!info.exists()) {
+        return QString();
+    }
+
+    // Modification time makes the url change together with thumbnail, so it can be cached
+    return QSL("falkon:speeddial/thumb/%1?v=%2").arg(hash, QString::number(info.lastModified().toMSecsSinceEpoch()));
+}
+
+QSize SpeedDial::thumbnailSize() const
+{
+    // Same aspect ratio as dials on the page, scaled for HiDPI screens
+    const int width = qRound(m_sizeOfSpeedDials * qApp->devicePixelRatio());
+    return QSize(width, qRound(width / 1.77));
 }
 
 QString SpeedDial::escapeTitle(QString title) const
@@ -25,6 +25,7 @@
 #include "qzcommon.h"
 
 class QUrl;
+class QSize;
 class QPixmap;
 
 class AutoSaver;
@@ -69,6 +70,8 @@ public:
     QString initialScript();
     QList<Page> pages();
 
+    QString thumbnailFileName(const QString &hash);
+
 Q_SIGNALS:
     void pagesChanged();
     void thumbnailLoaded(const QString &url, const QString &src);
@@ -97,6 +100,10 @@ private:
 
     QString generateAllPages();
 
+    QString thumbnailHash(const QString &url) const;
+    QString thumbnailUrl(const QString &url) const;
+    QSize thumbnailSize() const;
+
     QString m_initialScript;
     QString m_thumbnailsDir;
     QString m_backgroundImage;
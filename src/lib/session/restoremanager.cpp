@@ -21,6 +21,9 @@
 #include "datapaths.h"
 
 #include <QFile>
+#include <QFileInfo>
+#include <QThread>
+#include <QCoreApplication>
 
 static const int restoreDataVersion = 2;
 
@@ -81,6 +84,51 @@ QDataStream &operator>>(QDataStream &stream, RestoreData &data)
     return stream;
 }
 
+SessionHeader::SessionHeader(const RestoreData &data)
+    : windowCount(data.windows.count())
+    , timestamp(QDateTime::currentDateTime())
+{
+    for (const BrowserWindow::SavedWindow &window : qAsConst(data.windows)) {
+        tabCount += window.tabs.count();
+    }
+}
+
+bool SessionHeader::isValid() const
+{
+    return windowCount > 0;
+}
+
+QDataStream &operator<<(QDataStream &stream, const SessionHeader &header)
+{
+    stream << qint32(header.windowCount);
+    stream << qint32(header.tabCount);
+    stream << qint64(header.timestamp.toMSecsSinceEpoch());
+
+    return stream;
+}
+
+QDataStream &operator>>(QDataStream &stream, SessionHeader &header)
+{
+    qint32 windowCount;
+    qint32 tabCount;
+    qint64 timestamp;
+
+    stream >> windowCount;
+    stream >> tabCount;
+    stream >> timestamp;
+
+    if (stream.status() != QDataStream::Ok) {
+        header = SessionHeader();
+        return stream;
+    }
+
+    header.windowCount = windowCount;
+    header.tabCount = tabCount;
+    header.timestamp = QDateTime::fromMSecsSinceEpoch(timestamp);
+
+    return stream;
+}
+
 RestoreManager::RestoreManager(const QString &file)
     : m_recoveryObject(new RecoveryJsObject(this))
 {
@@ -162,9 +210,58 @@ static void loadVersion3(QDataStream &stream, RestoreData &data)
 // static
 bool RestoreManager::validateFile(const QString &file)
 {
+    SessionHeader header;
+    return readHeader(file, header);
+}
+
+// static
+bool RestoreManager::readHeader(const QString &file, SessionHeader &header, bool *legacy)
+{
+    header = SessionHeader();
+    *legacy = false;
+
+    QFile recoveryFile(file);
+    if (!recoveryFile.open(QIODevice::ReadOnly)) {
+        return false;
+    }
+
+    QDataStream stream(&recoveryFile);
+
+    int version;
+    stream >> version;
+
+    if (version == Qz::sessionVersion) {
+        stream >> header;
+        return header.isValid();
+    }
+
+    *legacy = version == 0x0004 || version == 0x0003 || version == (0x0003 | 0x050000);
+    return false;
+}
+
+// static
+bool RestoreManager::readHeader(const QString &file, SessionHeader &header)
+{
+    bool legacy;
+    if (readHeader(file, header, &legacy)) {
+        return true;
+    }
+    if (!legacy) {
+        return false;
+    }
+
+    // Tabs are deserialized together with their icons, QPixmap can only be used in main thread
+    Q_ASSERT(QThread::currentThread() == QCoreApplication::instance()->thread());
+
     RestoreData data;
     createFromFile(file, data);
-    return data.isValid();
+    if (!data.isValid()) {
+        return false;
+    }
+
+    header = SessionHeader(data);
+    header.timestamp = QFileInfo(file).lastModified();
+    return true;
 }
 
 // static
@@ -185,6 +282,10 @@ void RestoreManager::createFromFile(const QString &file, RestoreData &data)
     stream >> version;
 
     if (version == Qz::sessionVersion) {
+        SessionHeader header;
+        stream >> header;
+        loadCurrentVersion(stream, data);
+    } else if (version == 0x0004) {
         loadCurrentVersion(stream, data);
     } else if (version == 0x0003 || version == (0x0003 | 0x050000)) {
         loadVersion3(stream, data);
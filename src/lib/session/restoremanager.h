@@ -22,6 +22,8 @@
 #include "qzcommon.h"
 #include "browserwindow.h"
 
+#include <QDateTime>
+
 class WebPage;
 class RecoveryJsObject;
 
@@ -38,6 +40,23 @@ struct FALKON_EXPORT RestoreData
     friend FALKON_EXPORT QDataStream &operator>>(QDataStream &stream, RestoreData &data);
 };
 
+// Fixed size header stored in front of the session data, so the session can be
+// listed without deserializing all windows and tabs
+struct FALKON_EXPORT SessionHeader
+{
+    int windowCount = 0;
+    int tabCount = 0;
+    QDateTime timestamp;
+
+    SessionHeader() = default;
+    explicit SessionHeader(const RestoreData &data);
+
+    bool isValid() const;
+
+    friend FALKON_EXPORT QDataStream &operator<<(QDataStream &stream, const SessionHeader &header);
+    friend FALKON_EXPORT QDataStream &operator>>(QDataStream &stream, SessionHeader &header);
+};
+
 class FALKON_EXPORT RestoreManager
 {
 public:
@@ -51,6 +70,11 @@ public:
     QObject *recoveryObject(WebPage *page);
 
     static bool validateFile(const QString &file);
+    // Reads only the header, safe to call from any thread. Files written by
+    // older versions have no header, for those legacy is set and false returned.
+    static bool readHeader(const QString &file, SessionHeader &header, bool *legacy);
+    // Loads whole session for files without header, main thread only
+    static bool readHeader(const QString &file, SessionHeader &header);
     static void createFromFile(const QString &file, RestoreData &data);
 
 private:
@@ -30,12 +30,14 @@
 #include <QDialogButtonBox>
 #include <QDir>
 #include <QFileSystemWatcher>
+#include <QFutureWatcher>
 #include <QInputDialog>
 #include <QLabel>
 #include <QMenu>
 #include <QMessageBox>
 #include <QVBoxLayout>
 #include <QSaveFile>
+#include <QtConcurrent/QtConcurrentRun>
 
 SessionManager::SessionManager(QObject* parent)
     : QObject(parent)
@@ -46,12 +48,33 @@ SessionManager::SessionManager(QObject* parent)
     connect(sessionFilesWatcher, &QFileSystemWatcher::directoryChanged, this, &SessionManager::sessionsDirectoryChanged);
     connect(sessionFilesWatcher, &QFileSystemWatcher::directoryChanged, this, &SessionManager::sessionsMetaDataChanged);
 
+    m_metaDataWatcher = new QFutureWatcher<QList<SessionMetaData>>(this);
+    connect(m_metaDataWatcher, &QFutureWatcherBase::finished, this, &SessionManager::sessionsMetaDataLoaded);
+
     loadSettings();
 }
 
 void SessionManager::aboutToShowSessionsMenu()
 {
     QMenu* menu = qobject_cast<QMenu*>(sender());
+
+    if (m_sessionsMetaDataLoaded) {
+        fillSessionsMenu(menu);
+        return;
+    }
+
+    menu->clear();
+    menu->addAction(tr("Loading..."))->setEnabled(false);
+
+    if (!m_pendingSessionsMenus.contains(menu)) {
+        m_pendingSessionsMenus.append(menu);
+    }
+
+    loadSessionsMetaDataInBackground();
+}
+
+void SessionManager::fillSessionsMenu(QMenu *menu)
+{
     menu->clear();
 
     QActionGroup *group = new QActionGroup(menu);
@@ -71,6 +94,8 @@ void SessionManager::aboutToShowSessionsMenu()
 void SessionManager::sessionsDirectoryChanged()
 {
     m_sessionsMetaDataList.clear();
+    m_sessionsMetaDataLoaded = false;
+    m_metaDataOutdated = true;
 }
 
 void SessionManager::openSession(QString sessionFilePath, SessionFlags flags)
@@ -105,7 +130,7 @@ void SessionManager::openSession(QString sessionFilePath, SessionFlags flags)
 
         if (!flags.testFlag(ReplaceSession)) {
             m_lastActiveSessionPath = QFileInfo(sessionFilePath).canonicalFilePath();
-            m_sessionsMetaDataList.clear();
+            sessionsDirectoryChanged();
         }
     }
 
@@ -150,7 +175,7 @@ void SessionManager::renameSession(QString sessionFilePath, SessionFlags flags)
         }
         if (isActive(sessionFilePath)) {
             m_lastActiveSessionPath = newSessionPath;
-            m_sessionsMetaDataList.clear();
+            sessionsDirectoryChanged();
         }
     }
 }
@@ -238,18 +263,26 @@ QList<SessionManager::SessionMetaData> SessionManager::sessionMetaData(bool with
 
     auto out = m_sessionsMetaDataList;
 
-    if (withBackups && QFile::exists(m_firstBackupSession)) {
+    SessionHeader header;
+
+    if (withBackups && RestoreManager::readHeader(m_firstBackupSession, header)) {
         SessionMetaData data;
         data.name = tr("Backup 1");
         data.filePath = m_firstBackupSession;
         data.isBackup = true;
+        data.windowCount = header.windowCount;
+        data.tabCount = header.tabCount;
+        data.timestamp = header.timestamp;
         out.append(data);
     }
-    if (withBackups && QFile::exists(m_secondBackupSession)) {
+    if (withBackups && RestoreManager::readHeader(m_secondBackupSession, header)) {
         SessionMetaData data;
         data.name = tr("Backup 2");
         data.filePath = m_secondBackupSession;
         data.isBackup = true;
+        data.windowCount = header.windowCount;
+        data.tabCount = header.tabCount;
+        data.timestamp = header.timestamp;
         out.append(data);
     }
 
@@ -261,32 +294,76 @@ bool SessionManager::isActive(const QString &filePath) const
     return QFileInfo(filePath) == QFileInfo(m_lastActiveSessionPath);
 }
 
-bool SessionManager::isActive(const QFileInfo &fileInfo) const
+void SessionManager::fillSessionsMetaDataListIfNeeded()
 {
-    return fileInfo == QFileInfo(m_lastActiveSessionPath);
+    if (m_sessionsMetaDataLoaded)
+        return;
+
+    m_sessionsMetaDataList = readSessionsMetaData(m_lastActiveSessionPath);
+    readLegacyHeaders(m_sessionsMetaDataList);
+    m_sessionsMetaDataLoaded = true;
 }
 
-void SessionManager::fillSessionsMetaDataListIfNeeded()
+void SessionManager::loadSessionsMetaDataInBackground()
 {
-    if (!m_sessionsMetaDataList.isEmpty())
+    if (m_metaDataWatcher->isRunning()) {
         return;
+    }
+
+    m_metaDataOutdated = false;
+    m_metaDataWatcher->setFuture(QtConcurrent::run(&SessionManager::readSessionsMetaData, m_lastActiveSessionPath));
+}
+
+void SessionManager::sessionsMetaDataLoaded()
+{
+    // Sessions changed while loading, the result is stale
+    if (m_metaDataOutdated) {
+        loadSessionsMetaDataInBackground();
+        return;
+    }
+
+    if (!m_sessionsMetaDataLoaded) {
+        m_sessionsMetaDataList = m_metaDataWatcher->result();
+        readLegacyHeaders(m_sessionsMetaDataList);
+        m_sessionsMetaDataLoaded = true;
+    }
+
+    const QList<QPointer<QMenu>> menus = m_pendingSessionsMenus;
+    m_pendingSessionsMenus.clear();
+
+    for (const QPointer<QMenu> &menu : menus) {
+        if (menu && menu->isVisible()) {
+            fillSessionsMenu(menu);
+        }
+    }
+}
+
+// static
+QList<SessionManager::SessionMetaData> SessionManager::readSessionsMetaData(const QString &lastActiveSessionPath)
+{
+    QList<SessionMetaData> out;
 
     QDir dir(DataPaths::path(DataPaths::Sessions));
 
-    const QFileInfoList sessionFiles = QFileInfoList() << QFileInfo(defaultSessionPath()) << dir.entryInfoList({QSL("*.*")}, QDir::Files, QDir::Time);
+    const QFileInfo defaultSessionFileInfo(defaultSessionPath());
+    const QFileInfo lastActiveSessionFileInfo(lastActiveSessionPath);
+    const QFileInfoList sessionFiles = QFileInfoList() << defaultSessionFileInfo << dir.entryInfoList({QSL("*.*")}, QDir::Files, QDir::Time);
 
     QStringList fileNames;
 
     for (int i = 0; i < sessionFiles.size(); ++i) {
         const QFileInfo &fileInfo = sessionFiles.at(i);
 
-        if (!RestoreManager::validateFile(fileInfo.absoluteFilePath()))
+        // Only the header is read, the session itself is loaded when opened
+        SessionHeader header;
+        bool legacy;
+        if (!RestoreManager::readHeader(fileInfo.absoluteFilePath(), header, &legacy) && !legacy)
             continue;
 
         SessionMetaData metaData;
         metaData.name = fileInfo.completeBaseName();
 
-        if (fileInfo == QFileInfo(defaultSessionPath())) {
+        if (fileInfo == defaultSessionFileInfo) {
             metaData.name = tr("Default Session");
             metaData.isDefault = true;
         } else if (fileNames.contains(fileInfo.completeBaseName())) {
@@ -295,14 +372,43 @@ void SessionManager::fillSessionsMetaDataListIfNeeded()
             metaData.name = fileInfo.completeBaseName();
         }
 
-        if (isActive(fileInfo)) {
+        if (fileInfo == lastActiveSessionFileInfo) {
             metaData.isActive = true;
         }
 
         fileNames << metaData.name;
         metaData.filePath = fileInfo.canonicalFilePath();
+        metaData.windowCount = header.windowCount;
+        metaData.tabCount = header.tabCount;
+        metaData.timestamp = header.timestamp;
+        metaData.isLegacy = legacy;
+
+        out << metaData;
+    }
+
+    return out;
+}
+
+// static
+void SessionManager::readLegacyHeaders(QList<SessionMetaData> &list)
+{
+    // Sessions saved by older versions need to be fully loaded, which can't be done in worker thread
+    for (int i = list.size() - 1; i >= 0; --i) {
+        SessionMetaData &metaData = list[i];
+        if (!metaData.isLegacy) {
+            continue;
+        }
+
+        SessionHeader header;
+        if (!RestoreManager::readHeader(metaData.filePath, header)) {
+            list.removeAt(i);
+            continue;
+        }
 
-        m_sessionsMetaDataList << metaData;
+        metaData.windowCount = header.windowCount;
+        metaData.tabCount = header.tabCount;
+        metaData.timestamp = header.timestamp;
+        metaData.isLegacy = false;
     }
 }
 
@@ -20,10 +20,16 @@
 
 #include "qzcommon.h"
 
+#include <QDateTime>
+#include <QPointer>
+
 class QAction;
 class QMenu;
 class QFileInfo;
 
+template <typename T>
+class QFutureWatcher;
+
 class FALKON_EXPORT SessionManager : public QObject
 {
     Q_OBJECT
@@ -35,6 +41,11 @@ public:
         bool isActive = false;
         bool isDefault = false;
         bool isBackup = false;
+        int windowCount = 0;
+        int tabCount = 0;
+        QDateTime timestamp;
+        // Session without header, counts are filled by readLegacyHeaders()
+        bool isLegacy = false;
     };
 
     enum SessionFlag {
@@ -80,10 +91,19 @@ private Q_SLOTS:
 
 private:
     bool isActive(const QString &filePath) const;
-    bool isActive(const QFileInfo &fileInfo) const;
     void fillSessionsMetaDataListIfNeeded();
+    void loadSessionsMetaDataInBackground();
+    void sessionsMetaDataLoaded();
+    void fillSessionsMenu(QMenu *menu);
+
+    static QList<SessionMetaData> readSessionsMetaData(const QString &lastActiveSessionPath);
+    static void readLegacyHeaders(QList<SessionMetaData> &list);
 
     QList<SessionMetaData> m_sessionsMetaDataList;
+    bool m_sessionsMetaDataLoaded = false;
+    QFutureWatcher<QList<SessionMetaData>> *m_metaDataWatcher = nullptr;
+    QList<QPointer<QMenu>> m_pendingSessionsMenus;
+    bool m_metaDataOutdated = false;
 
     QString m_firstBackupSession;
     QString m_secondBackupSession;
@@ -114,7 +114,8 @@ void SessionManagerDialog::refresh()
     for (const auto &session : sessions) {
         QTreeWidgetItem *item = new QTreeWidgetItem;
         item->setText(0, session.name);
-        item->setText(1, QFileInfo(session.filePath).lastModified().toString(Qt::DefaultLocaleShortDate));
+        item->setText(1, session.timestamp.toString(Qt::DefaultLocaleShortDate));
+        item->setToolTip(0, tr("%n window(s)", "", session.windowCount) + QL1S(", ") + tr("%n tab(s)", "", session.tabCount));
         item->setData(0, SessionFileRole, session.filePath);
         item->setData(0, IsBackupSessionRole, session.isBackup);
         item->setData(0, IsActiveSessionRole, session.isActive);
@@ -90,8 +90,6 @@ TabBar::TabBar(BrowserWindow* window, TabWidget* tabWidget)
     , m_tabWidget(tabWidget)
     , m_hideTabBarWithOneTab(false)
     , m_showCloseOnInactive(0)
-    , m_normalTabWidth(0)
-    , m_activeTabWidth(0)
     , m_forceHidden(false)
 {
     setObjectName("tabbar");
@@ -193,99 +191,146 @@ QSize TabBar::tabSizeHint(int index, bool fast) const
         return size;
     }
 
+    const bool layoutValid = updateTabLayout();
+
     WebTab* webTab = qobject_cast<WebTab*>(m_tabWidget->widget(index));
-    TabBar* tabBar = const_cast <TabBar*>(this);
 
     if (webTab && webTab->isPinned()) {
         size.setWidth(pinnedTabWidth);
     }
     else {
-        int availableWidth = mainTabBarWidth() - comboTabBarPixelMetric(ExtraReservedWidth);
-
-        if (availableWidth < 0) {
+        if (!layoutValid) {
             return QSize(-1, -1);
         }
 
-        const int normalTabsCount = ComboTabBar::normalTabsCount();
-        const int maxTabWidth = comboTabBarPixelMetric(ComboTabBar::NormalTabMaximumWidth);
+        if (!m_tabLayout.useBaseSize) {
+            size.setWidth(index == m_tabLayout.currentIndex ? m_tabLayout.activeTabWidth : m_tabLayout.normalTabWidth);
+        }
+    }
 
-        if (availableWidth >= maxTabWidth * normalTabsCount) {
-            m_normalTabWidth = maxTabWidth;
-            size.setWidth(m_normalTabWidth);
+    if (index == count() - 1) {
+        int xForAddTabButton = cornerWidth(Qt::TopLeftCorner) + pinTabBarWidth() + normalTabsCount() * m_tabLayout.normalTabWidth;
+
+        if (m_tabLayout.currentIndex >= pinnedTabsCount() && m_tabLayout.activeTabWidth > m_tabLayout.normalTabWidth) {
+            xForAddTabButton += m_tabLayout.activeTabWidth - m_tabLayout.normalTabWidth;
         }
-        else if (normalTabsCount > 0) {
-            const int minActiveTabWidth = comboTabBarPixelMetric(ComboTabBar::ActiveTabMinimumWidth);
 
-            int maxWidthForTab = availableWidth / normalTabsCount;
-            int realTabWidth = maxWidthForTab;
-            bool adjustingActiveTab = false;
+        if (QApplication::layoutDirection() == Qt::RightToLeft) {
+            xForAddTabButton = width() - xForAddTabButton;
+        }
 
-            if (realTabWidth < minActiveTabWidth) {
-                maxWidthForTab = normalTabsCount > 1 ? (availableWidth - minActiveTabWidth) / (normalTabsCount - 1) : 0;
-                realTabWidth = minActiveTabWidth;
-                adjustingActiveTab = true;
-            }
+        emit const_cast<TabBar*>(this)->moveAddTabButton(xForAddTabButton);
+    }
 
-            bool tryAdjusting = availableWidth >= minTabWidth * normalTabsCount;
+    return size;
+}
 
-            if (m_showCloseOnInactive != 1 && tabsClosable() && availableWidth < (minTabWidth + 25) * normalTabsCount) {
-                // Hiding close buttons to save some space
-                tabBar->setTabsClosable(false);
-                tabBar->showCloseButton(currentIndex());
-            }
-            if (m_showCloseOnInactive == 1) {
-                // Always showing close buttons
-                tabBar->setTabsClosable(true);
-                tabBar->showCloseButton(currentIndex());
-            }
+bool TabBar::TabLayout::hasSameInputs(const TabLayout &other) const
+{
+    return count == other.count
+            && pinnedCount == other.pinnedCount
+            && currentIndex == other.currentIndex
+            && availableWidth == other.availableWidth
+            && showCloseOnInactive == other.showCloseOnInactive
+            && minTabWidth == other.minTabWidth
+            && minActiveTabWidth == other.minActiveTabWidth
+            && maxTabWidth == other.maxTabWidth;
+}
 
-            if (tryAdjusting) {
-                m_normalTabWidth = maxWidthForTab;
+bool TabBar::updateTabLayout() const
+{
+    TabLayout layout;
+    layout.count = count();
+    layout.pinnedCount = pinnedTabsCount();
+    layout.currentIndex = mainTabBarCurrentIndex();
+    layout.availableWidth = mainTabBarWidth() - comboTabBarPixelMetric(ExtraReservedWidth);
+    layout.showCloseOnInactive = m_showCloseOnInactive;
+    layout.minTabWidth = comboTabBarPixelMetric(ComboTabBar::NormalTabMinimumWidth);
+    layout.minActiveTabWidth = comboTabBarPixelMetric(ComboTabBar::ActiveTabMinimumWidth);
+    layout.maxTabWidth = comboTabBarPixelMetric(ComboTabBar::NormalTabMaximumWidth);
 
-                // Fill any empty space (we've got from rounding) with active tab
-                if (index == mainTabBarCurrentIndex()) {
-                    if (adjustingActiveTab) {
-                        m_activeTabWidth = (availableWidth - minActiveTabWidth
-                                            - maxWidthForTab * (normalTabsCount - 1)) + realTabWidth;
-                    }
-                    else {
-                        m_activeTabWidth = (availableWidth - maxWidthForTab * normalTabsCount) + maxWidthForTab;
-                    }
-                    size.setWidth(m_activeTabWidth);
-                }
-                else {
-                    size.setWidth(m_normalTabWidth);
-                }
-            }
+    if (layout.hasSameInputs(m_tabLayout)) {
+        return m_tabLayout.availableWidth >= 0;
+    }
+
+    if (layout.availableWidth < 0) {
+        m_tabLayout = layout;
+        return false;
+    }
+
+    const int availableWidth = layout.availableWidth;
+    const int normalTabsCount = layout.count - layout.pinnedCount;
+
+    layout.closeButtonsFit = availableWidth >= (layout.minTabWidth + 25) * normalTabsCount;
+
+    if (availableWidth >= layout.maxTabWidth * normalTabsCount) {
+        layout.fitsMaxWidth = true;
+        layout.useBaseSize = false;
+        layout.normalTabWidth = layout.maxTabWidth;
+        layout.activeTabWidth = layout.maxTabWidth;
+    }
+    else if (normalTabsCount > 0 && availableWidth >= layout.minTabWidth * normalTabsCount) {
+        int maxWidthForTab = availableWidth / normalTabsCount;
+        int realTabWidth = maxWidthForTab;
+        bool adjustingActiveTab = false;
+
+        if (realTabWidth < layout.minActiveTabWidth) {
+            maxWidthForTab = normalTabsCount > 1 ? (availableWidth - layout.minActiveTabWidth) / (normalTabsCount - 1) : 0;
+            realTabWidth = layout.minActiveTabWidth;
+            adjustingActiveTab = true;
         }
 
-        // Restore close buttons according to preferences
-        if (m_showCloseOnInactive != 2 && !tabsClosable() && availableWidth >= (minTabWidth + 25) * normalTabsCount) {
-            tabBar->setTabsClosable(true);
+        layout.useBaseSize = false;
+        layout.normalTabWidth = maxWidthForTab;
 
-            // Hide close buttons on pinned tabs
-            for (int i = 0; i < count(); ++i) {
-                tabBar->updatePinnedTabCloseButton(i);
-            }
+        // Fill any empty space (we've got from rounding) with active tab
+        if (adjustingActiveTab) {
+            layout.activeTabWidth = (availableWidth - layout.minActiveTabWidth
+                                     - maxWidthForTab * (normalTabsCount - 1)) + realTabWidth;
+        }
+        else {
+            layout.activeTabWidth = (availableWidth - maxWidthForTab * normalTabsCount) + maxWidthForTab;
         }
     }
+    else {
+        // Tabs don't fit, keep the widths from previous layout for add tab button
+        layout.normalTabWidth = m_tabLayout.normalTabWidth;
+        layout.activeTabWidth = m_tabLayout.activeTabWidth;
+    }
 
-    if (index == count() - 1) {
-        WebTab* lastMainActiveTab = qobject_cast<WebTab*>(m_tabWidget->widget(mainTabBarCurrentIndex()));
-        int xForAddTabButton = cornerWidth(Qt::TopLeftCorner) + pinTabBarWidth() + normalTabsCount() * m_normalTabWidth;
+    // Store the layout first, changing close buttons relayouts the tabbar
+    m_tabLayout = layout;
+    const_cast<TabBar*>(this)->updateCloseButtons();
 
-        if (lastMainActiveTab && m_activeTabWidth > m_normalTabWidth) {
-            xForAddTabButton += m_activeTabWidth - m_normalTabWidth;
-        }
+    return true;
+}
 
-        if (QApplication::layoutDirection() == Qt::RightToLeft) {
-            xForAddTabButton = width() - xForAddTabButton;
-        }
+void TabBar::updateCloseButtons()
+{
+    const int normalTabsCount = m_tabLayout.count - m_tabLayout.pinnedCount;
 
-        emit tabBar->moveAddTabButton(xForAddTabButton);
+    if (normalTabsCount > 0 && !m_tabLayout.fitsMaxWidth) {
+        if (m_showCloseOnInactive != 1 && tabsClosable() && !m_tabLayout.closeButtonsFit) {
+            // Hiding close buttons to save some space
+            setTabsClosable(false);
+            showCloseButton(currentIndex());
+        }
+        if (m_showCloseOnInactive == 1) {
+            // Always showing close buttons
+            setTabsClosable(true);
+            showCloseButton(currentIndex());
+        }
     }
 
-    return size;
+    // Restore close buttons according to preferences
+    if (m_showCloseOnInactive != 2 && !tabsClosable() && m_tabLayout.closeButtonsFit) {
+        setTabsClosable(true);
+
+        // Hide close buttons on pinned tabs, normal tabs got them from setTabsClosable
+        for (int i = 0; i < m_tabLayout.pinnedCount; ++i) {
+            updatePinnedTabCloseButton(i);
+        }
+    }
 }
 
 int TabBar::comboTabBarPixelMetric(ComboTabBar::SizeType sizeType) const
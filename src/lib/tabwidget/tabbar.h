@@ -73,6 +73,8 @@ private:
     void dropEvent(QDropEvent* event) override;
 
     QSize tabSizeHint(int index, bool fast) const override;
+    bool updateTabLayout() const;
+    void updateCloseButtons();
     int comboTabBarPixelMetric(ComboTabBar::SizeType sizeType) const override;
     WebTab* webTab(int index = -1) const;
 
@@ -83,8 +85,28 @@ private:
 
     int m_showCloseOnInactive;
 
-    mutable int m_normalTabWidth;
-    mutable int m_activeTabWidth;
+    // Widths of all normal tabs, computed once per layout pass and reused
+    // by tabSizeHint() until any of the inputs changes
+    struct TabLayout {
+        int count = -1;
+        int pinnedCount = -1;
+        int currentIndex = -1;
+        int availableWidth = -1;
+        int showCloseOnInactive = -1;
+        int minTabWidth = -1;
+        int minActiveTabWidth = -1;
+        int maxTabWidth = -1;
+
+        bool useBaseSize = true;
+        bool fitsMaxWidth = false;
+        bool closeButtonsFit = false;
+        int normalTabWidth = 0;
+        int activeTabWidth = 0;
+
+        bool hasSameInputs(const TabLayout &other) const;
+    };
+
+    mutable TabLayout m_tabLayout;
 
     QPoint m_dragStartPosition;
 
@@ -16,6 +16,7 @@
 * along with this program.  If not, see <http://www.gnu.org/licenses/>.
 * ============================================================ */
 #include "tabicon.h"
+#include "tabiconanimator.h"
 #include "webtab.h"
 #include "webpage.h"
 #include "iconprovider.h"
@@ -28,18 +29,15 @@
 TabIcon::TabIcon(QWidget* parent)
     : QWidget(parent)
     , m_tab(0)
-    , m_currentFrame(0)
     , m_animationRunning(false)
+    , m_paintedFrame(-1)
     , m_audioIconDisplayed(false)
 {
     setObjectName(QSL("tab-icon"));
 
-    m_updateTimer = new QTimer(this);
-    m_updateTimer->setInterval(data()->animationInterval);
-    connect(m_updateTimer, &QTimer::timeout, this, &TabIcon::updateAnimationFrame);
-
     m_hideTimer = new QTimer(this);
     m_hideTimer->setInterval(250);
+    m_hideTimer->setSingleShot(true);
     connect(m_hideTimer, &QTimer::timeout, this, &TabIcon::hide);
 
     resize(16, 16);
@@ -65,17 +63,27 @@ void TabIcon::setWebTab(WebTab* tab)
 
 void TabIcon::showLoadingAnimation()
 {
-    m_currentFrame = 0;
+    if (!m_animationRunning) {
+        m_animationRunning = true;
+
+        TabIconAnimator *animator = TabIconAnimator::instance();
+        connect(animator, &TabIconAnimator::frameChanged, this, &TabIcon::updateAnimationFrame, Qt::UniqueConnection);
+        animator->start(this);
+    }
 
-    updateAnimationFrame();
     show();
+    update();
 }
 
 void TabIcon::hideLoadingAnimation()
 {
     m_animationRunning = false;
+    m_paintedFrame = -1;
+
+    TabIconAnimator *animator = TabIconAnimator::instance();
+    disconnect(animator, &TabIconAnimator::frameChanged, this, &TabIcon::updateAnimationFrame);
+    animator->stop(this);
 
-    m_updateTimer->stop();
     updateIcon();
 }
 
@@ -111,13 +119,11 @@ TabIcon::Data *TabIcon::data()
 
 void TabIcon::updateAnimationFrame()
 {
-    if (!m_animationRunning) {
-        m_updateTimer->start();
-        m_animationRunning = true;
+    // Tabs scrolled out of view or in minimized windows pick up
+    // the current frame once they are painted again
+    if (isOnScreen()) {
+        update();
     }
-
-    update();
-    m_currentFrame = (m_currentFrame + 1) % data()->framesCount;
 }
 
 void TabIcon::show()
@@ -160,6 +166,11 @@ bool TabIcon::shouldBeVisible() const
     return !m_sitePixmap.isNull() || m_animationRunning || m_audioIconDisplayed || (m_tab && m_tab->isPinned());
 }
 
+bool TabIcon::isOnScreen() const
+{
+    return isVisible() && !window()->isMinimized() && !visibleRegion().isEmpty();
+}
+
 bool TabIcon::event(QEvent *event)
 {
     if (event->type() == QEvent::ToolTip) {
@@ -205,7 +216,15 @@ void TabIcon::paintEvent(QPaintEvent* event)
     r.setHeight(size);
 
     if (m_animationRunning) {
-        p.drawPixmap(r, data()->animationPixmap, QRect(m_currentFrame * pixmapSize, 0, pixmapSize, pixmapSize));
+        TabIconAnimator *animator = TabIconAnimator::instance();
+        const int frame = animator->currentFrame();
+        p.drawPixmap(r, data()->animationPixmap, QRect(frame * pixmapSize, 0, pixmapSize, pixmapSize));
+
+        // Repaints of the same frame (hover, resize) are not animation frames
+        if (frame != m_paintedFrame) {
+            m_paintedFrame = frame;
+            animator->frameRepainted();
+        }
     } else if (m_audioIconDisplayed && !m_tab->isPinned()) {
         m_audioIconRect = r;
         p.drawPixmap(r, m_tab->isMuted() ? data()->audioMutedPixmap : data()->audioPlayingPixmap);
@@ -60,17 +60,17 @@ private:
     void show();
     void hide();
     bool shouldBeVisible() const;
+    bool isOnScreen() const;
 
     bool event(QEvent *event) override;
     void paintEvent(QPaintEvent* event) override;
     void mousePressEvent(QMouseEvent* event) override;
 
     WebTab* m_tab;
-    QTimer* m_updateTimer;
     QTimer* m_hideTimer;
     QPixmap m_sitePixmap;
-    int m_currentFrame;
     bool m_animationRunning;
+    int m_paintedFrame;
     bool m_audioIconDisplayed;
     QRect m_audioIconRect;
 };
@@ -0,0 +1,109 @@
+/* ============================================================
+* Falkon - Qt web browser
+* Copyright (C) 2018 David Rosca <nowrep@gmail.com>
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program.  If not, see <http://www.gnu.org/licenses/>.
+* ============================================================ */
+#include "tabiconanimator.h"
+#include "tabicon.h"
+
+#include <QTimerEvent>
+#include <QCoreApplication>
+#include <QPointer>
+
+TabIconAnimator::TabIconAnimator(QObject *parent)
+    : QObject(parent)
+{
+    m_clock.start();
+}
+
+// static
+TabIconAnimator *TabIconAnimator::instance()
+{
+    static QPointer<TabIconAnimator> animator;
+    if (!animator) {
+        animator = new TabIconAnimator(QCoreApplication::instance());
+    }
+    return animator;
+}
+
+int TabIconAnimator::currentFrame() const
+{
+    return m_currentFrame;
+}
+
+void TabIconAnimator::start(QObject *client)
+{
+    if (m_clients.contains(client)) {
+        return;
+    }
+
+    m_clients.insert(client);
+    connect(client, &QObject::destroyed, this, &TabIconAnimator::stop, Qt::UniqueConnection);
+
+    if (!m_timer.isActive()) {
+        m_timer.start(TabIcon::data()->animationInterval, this);
+    }
+}
+
+void TabIconAnimator::stop(QObject *client)
+{
+    if (!m_clients.remove(client)) {
+        return;
+    }
+
+    if (m_clients.isEmpty()) {
+        m_timer.stop();
+    }
+}
+
+bool TabIconAnimator::isRunning() const
+{
+    return m_timer.isActive();
+}
+
+TabIconAnimator::Statistics TabIconAnimator::statistics() const
+{
+    return m_statistics;
+}
+
+void TabIconAnimator::resetStatistics()
+{
+    m_statistics = Statistics();
+}
+
+void TabIconAnimator::frameRepainted()
+{
+    ++m_statistics.repaints;
+}
+
+void TabIconAnimator::timerEvent(QTimerEvent *event)
+{
+    if (event->timerId() != m_timer.timerId()) {
+        QObject::timerEvent(event);
+        return;
+    }
+
+    ++m_statistics.ticks;
+
+    // Frame is derived from the clock, so animation speed doesn't depend on timer accuracy
+    const TabIcon::Data *data = TabIcon::data();
+    const int frame = (m_clock.elapsed() / data->animationInterval) % data->framesCount;
+    if (frame == m_currentFrame) {
+        return;
+    }
+
+    m_currentFrame = frame;
+    emit frameChanged(m_currentFrame);
+}
@@ -0,0 +1,68 @@
+/* ============================================================
+* Falkon - Qt web browser
+* Copyright (C) 2018 David Rosca <nowrep@gmail.com>
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program.  If not, see <http://www.gnu.org/licenses/>.
+* ============================================================ */
+#ifndef TABICONANIMATOR_H
+#define TABICONANIMATOR_H
+
+#include <QObject>
+#include <QSet>
+#include <QBasicTimer>
+#include <QElapsedTimer>
+
+#include "qzcommon.h"
+
+// Single clock for loading animations of all tabs. All clients get the same
+// frame at the same time and the timer only runs while some client is animating.
+class FALKON_EXPORT TabIconAnimator : public QObject
+{
+    Q_OBJECT
+
+public:
+    struct Statistics {
+        int ticks = 0;
+        int repaints = 0;
+    };
+
+    static TabIconAnimator *instance();
+
+    int currentFrame() const;
+
+    void start(QObject *client);
+    void stop(QObject *client);
+    bool isRunning() const;
+
+    // Number of timer wakeups and repainted frames since last reset
+    Statistics statistics() const;
+    void resetStatistics();
+    void frameRepainted();
+
+Q_SIGNALS:
+    void frameChanged(int frame);
+
+private:
+    explicit TabIconAnimator(QObject *parent = nullptr);
+
+    void timerEvent(QTimerEvent *event) override;
+
+    QSet<QObject*> m_clients;
+    QBasicTimer m_timer;
+    QElapsedTimer m_clock;
+    int m_currentFrame = 0;
+    Statistics m_statistics;
+};
+
+#endif // TABICONANIMATOR_H
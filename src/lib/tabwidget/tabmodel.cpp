@@ -20,6 +20,8 @@
 #include "tabwidget.h"
 #include "browserwindow.h"
 
+#include <QTimer>
+
 // TabModelMimeData
 TabModelMimeData::TabModelMimeData()
     : QMimeData()
@@ -218,6 +220,7 @@ void TabModel::init()
         beginResetModel();
         m_window = nullptr;
         m_tabs.clear();
+        m_dirtyTabs.clear();
         endResetModel();
     });
 }
@@ -230,26 +233,25 @@ void TabModel::tabInserted(int index)
     m_tabs.insert(index, tab);
     endInsertRows();
 
-    auto emitDataChanged = [this](WebTab *tab, int role) {
-        const QModelIndex idx = tabIndex(tab);
-        emit dataChanged(idx, idx, {role});
+    auto markDirty = [this](WebTab *tab, const QVector<int> &roles) {
+        tabDataChanged(tab, roles);
     };
 
-    connect(tab, &WebTab::titleChanged, this, std::bind(emitDataChanged, tab, Qt::DisplayRole));
-    connect(tab, &WebTab::titleChanged, this, std::bind(emitDataChanged, tab, TitleRole));
-    connect(tab, &WebTab::iconChanged, this, std::bind(emitDataChanged, tab, Qt::DecorationRole));
-    connect(tab, &WebTab::iconChanged, this, std::bind(emitDataChanged, tab, IconRole));
-    connect(tab, &WebTab::pinnedChanged, this, std::bind(emitDataChanged, tab, PinnedRole));
-    connect(tab, &WebTab::restoredChanged, this, std::bind(emitDataChanged, tab, RestoredRole));
-    connect(tab, &WebTab::currentTabChanged, this, std::bind(emitDataChanged, tab, CurrentTabRole));
-    connect(tab, &WebTab::loadingChanged, this, std::bind(emitDataChanged, tab, LoadingRole));
-    connect(tab, &WebTab::playingChanged, this, std::bind(emitDataChanged, tab, AudioPlayingRole));
-    connect(tab, &WebTab::mutedChanged, this, std::bind(emitDataChanged, tab, AudioMutedRole));
-    connect(tab, &WebTab::backgroundActivityChanged, this, std::bind(emitDataChanged, tab, BackgroundActivityRole));
+    connect(tab, &WebTab::titleChanged, this, std::bind(markDirty, tab, QVector<int>{Qt::DisplayRole, TitleRole}));
+    connect(tab, &WebTab::iconChanged, this, std::bind(markDirty, tab, QVector<int>{Qt::DecorationRole, IconRole}));
+    connect(tab, &WebTab::pinnedChanged, this, std::bind(markDirty, tab, QVector<int>{PinnedRole}));
+    connect(tab, &WebTab::restoredChanged, this, std::bind(markDirty, tab, QVector<int>{RestoredRole}));
+    connect(tab, &WebTab::currentTabChanged, this, std::bind(markDirty, tab, QVector<int>{CurrentTabRole}));
+    connect(tab, &WebTab::loadingChanged, this, std::bind(markDirty, tab, QVector<int>{LoadingRole}));
+    connect(tab, &WebTab::playingChanged, this, std::bind(markDirty, tab, QVector<int>{AudioPlayingRole}));
+    connect(tab, &WebTab::mutedChanged, this, std::bind(markDirty, tab, QVector<int>{AudioMutedRole}));
+    connect(tab, &WebTab::backgroundActivityChanged, this, std::bind(markDirty, tab, QVector<int>{BackgroundActivityRole}));
 }
 
 void TabModel::tabRemoved(int index)
 {
+    m_dirtyTabs.remove(m_tabs.at(index));
+
     beginRemoveRows(QModelIndex(), index, index);
     m_tabs.remove(index);
     endRemoveRows();
@@ -264,3 +266,57 @@ void TabModel::tabMoved(int from, int to)
     m_tabs.insert(to, m_tabs.takeAt(from));
     endMoveRows();
 }
+
+void TabModel::tabDataChanged(WebTab *tab, const QVector<int> &roles)
+{
+    QVector<int> &dirtyRoles = m_dirtyTabs[tab];
+    for (int role : roles) {
+        if (!dirtyRoles.contains(role)) {
+            dirtyRoles.append(role);
+        }
+    }
+
+    // Tabs may change several times per frame (eg. session restore or reload all),
+    // views are notified only once per event loop iteration
+    if (!m_flushScheduled) {
+        m_flushScheduled = true;
+        QTimer::singleShot(0, this, &TabModel::flushDataChanged);
+    }
+}
+
+void TabModel::flushDataChanged()
+{
+    m_flushScheduled = false;
+
+    if (m_dirtyTabs.isEmpty()) {
+        return;
+    }
+
+    int first = -1;
+    int last = -1;
+    QVector<int> roles;
+
+    for (int i = 0; i < m_tabs.count(); ++i) {
+        const auto it = m_dirtyTabs.constFind(m_tabs.at(i));
+        if (it == m_dirtyTabs.constEnd()) {
+            continue;
+        }
+        if (first < 0) {
+            first = i;
+        }
+        last = i;
+        for (int role : it.value()) {
+            if (!roles.contains(role)) {
+                roles.append(role);
+            }
+        }
+    }
+
+    m_dirtyTabs.clear();
+
+    if (first < 0) {
+        return;
+    }
+
+    emit dataChanged(index(first), index(last), roles);
+}
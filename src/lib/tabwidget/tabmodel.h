@@ -17,6 +17,7 @@
 * ============================================================ */
 #pragma once
 
+#include <QHash>
 #include <QPointer>
 #include <QMimeData>
 #include <QAbstractListModel>
@@ -83,7 +84,11 @@ private:
     void tabInserted(int index);
     void tabRemoved(int index);
     void tabMoved(int from, int to);
+    void tabDataChanged(WebTab *tab, const QVector<int> &roles);
+    void flushDataChanged();
 
     BrowserWindow *m_window;
     QVector<WebTab*> m_tabs;
+    QHash<WebTab*, QVector<int>> m_dirtyTabs;
+    bool m_flushScheduled = false;
 };
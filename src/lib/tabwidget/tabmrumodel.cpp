@@ -169,7 +169,24 @@ void TabMruModel::currentTabChanged(int index)
 
 void TabMruModel::sourceDataChanged(const QModelIndex &topLeft, const QModelIndex &bottomRight, const QVector<int> &roles)
 {
-    emit dataChanged(mapFromSource(topLeft), mapFromSource(bottomRight), roles);
+    // Source range is not contiguous in MRU order
+    int first = -1;
+    int last = -1;
+
+    for (int i = topLeft.row(); i <= bottomRight.row(); ++i) {
+        const int row = mapFromSource(sourceModel()->index(i, 0)).row();
+        if (row < 0) {
+            continue;
+        }
+        first = first < 0 ? row : qMin(first, row);
+        last = qMax(last, row);
+    }
+
+    if (first < 0) {
+        return;
+    }
+
+    emit dataChanged(index(first, 0), index(last, 0), roles);
 }
 
 void TabMruModel::sourceRowsInserted(const QModelIndex &parent, int start, int end)
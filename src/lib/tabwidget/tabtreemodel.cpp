@@ -307,7 +307,30 @@ TabTreeModelItem *TabTreeModel::createItems(TabTreeModelItem *root)
 
 void TabTreeModel::sourceDataChanged(const QModelIndex &topLeft, const QModelIndex &bottomRight, const QVector<int> &roles)
 {
-    emit dataChanged(mapFromSource(topLeft), mapFromSource(bottomRight), roles);
+    // Source model coalesces changes into one range per event loop iteration.
+    // Rows of that range can be spread over the tree, so emit one range per parent.
+    QHash<TabTreeModelItem*, QPair<int, int>> ranges;
+
+    for (int i = topLeft.row(); i <= bottomRight.row(); ++i) {
+        WebTab *tab = sourceModel()->index(i, 0).data(TabModel::WebTabRole).value<WebTab*>();
+        TabTreeModelItem *it = m_items.value(tab);
+        if (!it || !it->parent) {
+            continue;
+        }
+        const int row = it->parent->children.indexOf(it);
+        auto range = ranges.find(it->parent);
+        if (range == ranges.end()) {
+            ranges.insert(it->parent, qMakePair(row, row));
+        } else {
+            range->first = qMin(range->first, row);
+            range->second = qMax(range->second, row);
+        }
+    }
+
+    for (auto it = ranges.constBegin(); it != ranges.constEnd(); ++it) {
+        const QModelIndex parent = index(it.key());
+        emit dataChanged(index(it.value().first, 0, parent), index(it.value().second, 0, parent), roles);
+    }
 }
 
 void TabTreeModel::sourceRowsInserted(const QModelIndex &parent, int start, int end)
@@ -791,8 +791,8 @@ void TabWidget::restoreAllClosedTabs()
         return;
     }
 
-    const auto closedTabs = m_closedTabsManager->closedTabs();
-    for (const ClosedTabsManager::Tab &tab : closedTabs) {
+    while (m_closedTabsManager->isClosedTabAvailable()) {
+        const ClosedTabsManager::Tab tab = m_closedTabsManager->takeLastClosedTab();
         int index = addView(QUrl(), tab.tabState.title, Qz::NT_CleanSelectedTab);
         WebTab* webTab = weTab(index);
         webTab->setParentTab(tab.parentTab);
@@ -21,7 +21,12 @@
 
 #include <QWebEngineHistory>
 
+// Limits of closed tabs kept per window, oldest tabs are dropped first
+static const int maxClosedTabs = 50;
+static const int maxClosedTabsSize = 8 * 1024 * 1024;
+
 ClosedTabsManager::ClosedTabsManager()
+    : m_closedTabsSize(0)
 {
 }
 
@@ -40,7 +45,12 @@ void ClosedTabsManager::saveTab(WebTab *tab)
     closedTab.position = tab->tabIndex();
     closedTab.parentTab = tab->parentTab();
     closedTab.tabState = WebTab::SavedTab(tab);
+    closedTab.tabState.history = qCompress(closedTab.tabState.history);
+
+    m_closedTabsSize += tabSize(closedTab);
     m_closedTabs.prepend(closedTab);
+
+    removeExcessTabs();
 }
 
 bool ClosedTabsManager::isClosedTabAvailable() const
@@ -50,11 +60,7 @@ bool ClosedTabsManager::isClosedTabAvailable() const
 
 ClosedTabsManager::Tab ClosedTabsManager::takeLastClosedTab()
 {
-    Tab tab;
-    if (!m_closedTabs.isEmpty()) {
-        tab = m_closedTabs.takeFirst();
-    }
-    return tab;
+    return takeTabAt(0);
 }
 
 ClosedTabsManager::Tab ClosedTabsManager::takeTabAt(int index)
@@ -62,11 +68,13 @@ ClosedTabsManager::Tab ClosedTabsManager::takeTabAt(int index)
     Tab tab;
     if (QzTools::containsIndex(m_closedTabs, index)) {
         tab = m_closedTabs.takeAt(index);
+        m_closedTabsSize -= tabSize(tab);
+        tab.tabState.history = qUncompress(tab.tabState.history);
     }
     return tab;
 }
 
-QVector<ClosedTabsManager::Tab> ClosedTabsManager::closedTabs() const
+QList<ClosedTabsManager::Tab> ClosedTabsManager::closedTabs() const
 {
     return m_closedTabs;
 }
@@ -74,4 +82,23 @@ QVector<ClosedTabsManager::Tab> ClosedTabsManager::closedTabs() const
 void ClosedTabsManager::clearClosedTabs()
 {
     m_closedTabs.clear();
+    m_closedTabsSize = 0;
+}
+
+// static
+int ClosedTabsManager::tabSize(const Tab &tab)
+{
+    // Rough estimate, icon is always saved as 16x16 pixmap
+    return tab.tabState.history.size()
+            + tab.tabState.url.toEncoded().size()
+            + tab.tabState.title.size() * int(sizeof(QChar))
+            + 16 * 16 * 4;
+}
+
+void ClosedTabsManager::removeExcessTabs()
+{
+    // Always keep the most recently closed tab
+    while (m_closedTabs.count() > 1 && (m_closedTabs.count() > maxClosedTabs || m_closedTabsSize > maxClosedTabsSize)) {
+        m_closedTabsSize -= tabSize(m_closedTabs.takeLast());
+    }
 }
@@ -18,7 +18,7 @@
 #ifndef CLOSEDTABSMANAGER_H
 #define CLOSEDTABSMANAGER_H
 
-#include <QVector>
+#include <QList>
 #include <QPointer>
 
 #include "webtab.h"
@@ -49,11 +49,18 @@ public:
     // Takes tab at given index
     Tab takeTabAt(int index);
 
-    QVector<Tab> closedTabs() const;
+    // History of returned tabs is compressed, they are meant only for display.
+    // Use takeLastClosedTab() or takeTabAt() to get a tab that can be restored
+    QList<Tab> closedTabs() const;
     void clearClosedTabs();
 
 private:
-    QVector<Tab> m_closedTabs;
+    static int tabSize(const Tab &tab);
+    void removeExcessTabs();
+
+    // Most recently closed tab first
+    QList<Tab> m_closedTabs;
+    int m_closedTabsSize;
 };
 
 // Hint to Qt to use std::realloc on item moving
@@ -18,9 +18,16 @@
 #include "closedwindowsmanager.h"
 #include "mainapplication.h"
 #include "tabbedwebview.h"
+#include "datapaths.h"
 #include "qztools.h"
 
 #include <QAction>
+#include <QTemporaryFile>
+
+// Only the most recently closed windows are kept in memory (also the ones
+// saved in session), older windows are moved to temporary files
+static const int maxClosedWindowsInMemory = 3;
+static const int maxClosedWindows = 20;
 
 ClosedWindowsManager::ClosedWindowsManager(QObject *parent)
     : QObject(parent)
@@ -34,7 +41,17 @@ bool ClosedWindowsManager::isClosedWindowAvailable() const
 
 QVector<ClosedWindowsManager::Window> ClosedWindowsManager::closedWindows() const
 {
-    return m_closedWindows;
+    QVector<Window> windows;
+    windows.reserve(m_closedWindows.count());
+
+    for (const ClosedWindow &closedWindow : m_closedWindows) {
+        Window window;
+        window.icon = closedWindow.icon;
+        window.title = closedWindow.title;
+        windows.append(window);
+    }
+
+    return windows;
 }
 
 void ClosedWindowsManager::saveWindow(BrowserWindow *window)
@@ -43,31 +60,31 @@ void ClosedWindowsManager::saveWindow(BrowserWindow *window)
         return;
     }
 
-    Window closedWindow;
-    closedWindow.icon = window->weView()->icon();
-    closedWindow.title = window->weView()->title();
-    closedWindow.windowState = BrowserWindow::SavedWindow(window);
-    m_closedWindows.prepend(closedWindow);
+    addClosedWindow(window->weView()->icon(), window->weView()->title(), BrowserWindow::SavedWindow(window), false);
+    removeExcessWindows();
 }
 
 ClosedWindowsManager::Window ClosedWindowsManager::takeLastClosedWindow()
 {
-    Window window;
-    if (!m_closedWindows.isEmpty()) {
-        window = m_closedWindows.takeFirst();
-    }
-    return window;
+    return takeClosedWindowAt(0);
 }
 
 ClosedWindowsManager::Window ClosedWindowsManager::takeClosedWindowAt(int index)
 {
     Window window;
     if (QzTools::containsIndex(m_closedWindows, index)) {
-        window = m_closedWindows.takeAt(index);
+        ClosedWindow closedWindow = m_closedWindows.takeAt(index);
+        window.icon = closedWindow.icon;
+        window.title = closedWindow.title;
+
+        const QByteArray data = qUncompress(windowStateData(closedWindow));
+        QDataStream stream(data);
+        stream >> window.windowState;
+
+        deleteWindowFile(closedWindow);
     }
     return window;
 }
-
 void ClosedWindowsManager::restoreClosedWindow()
 {
     Window window;
@@ -95,6 +112,9 @@ void ClosedWindowsManager::restoreAllClosedWindows()
 
 void ClosedWindowsManager::clearClosedWindows()
 {
+    for (ClosedWindow &closedWindow : m_closedWindows) {
+        deleteWindowFile(closedWindow);
+    }
     m_closedWindows.clear();
 }
 
@@ -107,12 +127,19 @@ QByteArray ClosedWindowsManager::saveState() const
 
     stream << closedWindowsVersion;
 
-    // Only save last 3 windows
-    const int windowCount = qBound(0, m_closedWindows.count(), 3);
-    stream << windowCount;
+    // Only save last 3 windows, they are already stored serialized
+    QVector<QByteArray> windows;
+    for (int i = 0; i < m_closedWindows.count() && windows.count() < 3; ++i) {
+        const QByteArray windowData = qUncompress(windowStateData(m_closedWindows.at(i)));
+        if (!windowData.isEmpty()) {
+            windows.append(windowData);
+        }
+    }
 
-    for (int i = 0; i < windowCount; ++i) {
-        stream << m_closedWindows.at(i).windowState;
+    stream << windows.count();
+
+    for (const QByteArray &windowData : qAsConst(windows)) {
+        stream.writeRawData(windowData.constData(), windowData.size());
     }
 
     return data;
@@ -129,20 +156,85 @@ void ClosedWindowsManager::restoreState(const QByteArray &state)
         return;
     }
 
-    m_closedWindows.clear();
+    clearClosedWindows();
 
     int windowCount;
     stream >> windowCount;
-    m_closedWindows.reserve(windowCount);
 
     for (int i = 0; i < windowCount; ++i) {
-        Window window;
-        stream >> window.windowState;
-        if (!window.isValid()) {
+        BrowserWindow::SavedWindow windowState;
+        stream >> windowState;
+        if (!windowState.isValid()) {
             continue;
         }
-        window.icon = window.windowState.tabs.at(0).icon;
-        window.title = window.windowState.tabs.at(0).title;
-        m_closedWindows.append(window);
+        addClosedWindow(windowState.tabs.at(0).icon, windowState.tabs.at(0).title, windowState, true);
     }
+
+    removeExcessWindows();
+}
+
+void ClosedWindowsManager::addClosedWindow(const QIcon &icon, const QString &title, const BrowserWindow::SavedWindow &windowState, bool append)
+{
+    QByteArray data;
+    QDataStream stream(&data, QIODevice::WriteOnly);
+    stream << windowState;
+
+    ClosedWindow closedWindow;
+    closedWindow.icon = icon;
+    closedWindow.title = title;
+    closedWindow.state = qCompress(data);
+
+    if (append) {
+        m_closedWindows.append(closedWindow);
+    } else {
+        m_closedWindows.prepend(closedWindow);
+    }
+}
+
+void ClosedWindowsManager::removeExcessWindows()
+{
+    while (m_closedWindows.count() > maxClosedWindows) {
+        ClosedWindow closedWindow = m_closedWindows.takeLast();
+        deleteWindowFile(closedWindow);
+    }
+
+    for (int i = maxClosedWindowsInMemory; i < m_closedWindows.count(); ++i) {
+        ClosedWindow &closedWindow = m_closedWindows[i];
+        if (closedWindow.file) {
+            continue;
+        }
+
+        QTemporaryFile *file = new QTemporaryFile(DataPaths::path(DataPaths::Temp) + QL1S("/closedwindow-XXXXXX"), this);
+        if (!file->open() || file->write(closedWindow.state) != closedWindow.state.size()) {
+            qWarning() << "ClosedWindowsManager: Cannot write closed window to" << file->fileName();
+            delete file;
+            continue;
+        }
+        file->close();
+
+        closedWindow.file = file;
+        closedWindow.state.clear();
+    }
+}
+
+QByteArray ClosedWindowsManager::windowStateData(const ClosedWindow &window) const
+{
+    if (!window.file) {
+        return window.state;
+    }
+
+    if (!window.file->open()) {
+        qWarning() << "ClosedWindowsManager: Cannot read closed window from" << window.file->fileName();
+        return QByteArray();
+    }
+
+    const QByteArray data = window.file->readAll();
+    window.file->close();
+    return data;
+}
+
+void ClosedWindowsManager::deleteWindowFile(ClosedWindow &window)
+{
+    delete window.file;
+    window.file = nullptr;
 }
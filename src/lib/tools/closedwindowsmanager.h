@@ -19,10 +19,13 @@
 
 #include <QObject>
 #include <QVector>
+#include <QList>
 
 #include "qzcommon.h"
 #include "browserwindow.h"
 
+class QTemporaryFile;
+
 class FALKON_EXPORT ClosedWindowsManager : public QObject
 {
     Q_OBJECT
@@ -41,6 +44,8 @@ public:
     explicit ClosedWindowsManager(QObject *parent = nullptr);
 
     bool isClosedWindowAvailable() const;
+    // Returned windows only have icon and title set, windowState is not loaded.
+    // Use takeLastClosedWindow() or takeClosedWindowAt() to get a window that can be restored
     QVector<Window> closedWindows() const;
 
     void saveWindow(BrowserWindow *window);
@@ -59,7 +64,21 @@ public Q_SLOTS:
     void clearClosedWindows();
 
 private:
-    QVector<Window> m_closedWindows;
+    struct ClosedWindow {
+        QIcon icon;
+        QString title;
+        // Compressed serialized SavedWindow, empty when spilled to file
+        QByteArray state;
+        QTemporaryFile *file = nullptr;
+    };
+
+    void addClosedWindow(const QIcon &icon, const QString &title, const BrowserWindow::SavedWindow &windowState, bool append);
+    void removeExcessWindows();
+    QByteArray windowStateData(const ClosedWindow &window) const;
+    void deleteWindowFile(ClosedWindow &window);
+
+    // Most recently closed window first
+    QList<ClosedWindow> m_closedWindows;
 };
 
 // Hint to Qt to use std::realloc on item moving
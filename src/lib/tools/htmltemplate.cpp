@@ -0,0 +1,138 @@
+/* ============================================================
+* Falkon - Qt web browser
+* Copyright (C) 2018 David Rosca <nowrep@gmail.com>
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program.  If not, see <http://www.gnu.org/licenses/>.
+* ============================================================ */
+#include "htmltemplate.h"
+#include "qztools.h"
+
+#include <QMutex>
+#include <QApplication>
+
+static bool isPlaceholderChar(const QChar &c)
+{
+    const ushort u = c.unicode();
+    return (u >= 'A' && u <= 'Z') || (u >= '0' && u <= '9') || u == '_' || u == '-';
+}
+
+HtmlTemplate::HtmlTemplate()
+    : m_literalSize(0)
+{
+}
+
+HtmlTemplate::HtmlTemplate(const QString &contents)
+    : m_literalSize(0)
+{
+    parse(contents);
+}
+
+bool HtmlTemplate::isEmpty() const
+{
+    return m_segments.isEmpty();
+}
+
+QString HtmlTemplate::render(const Values &values) const
+{
+    const bool rtl = QApplication::isRightToLeft();
+
+    QString out;
+    out.reserve(m_literalSize * 11 / 10);
+
+    for (const Segment &segment : m_segments) {
+        if (!segment.placeholder) {
+            out.append(segment.text);
+            continue;
+        }
+
+        auto it = values.constFind(segment.text);
+        if (it != values.constEnd()) {
+            out.append(it.value());
+        } else if (segment.text == QL1S("DIRECTION")) {
+            out.append(rtl ? QL1S("rtl") : QL1S("ltr"));
+        } else if (segment.text == QL1S("RIGHT_STR")) {
+            out.append(rtl ? QL1S("left") : QL1S("right"));
+        } else if (segment.text == QL1S("LEFT_STR")) {
+            out.append(rtl ? QL1S("right") : QL1S("left"));
+        } else {
+            out.append(QL1C('%') + segment.text + QL1C('%'));
+        }
+    }
+
+    return out;
+}
+
+// static
+HtmlTemplate HtmlTemplate::fromFile(const QString &fileName)
+{
+    static QMutex mutex;
+    static QHash<QString, HtmlTemplate> templates;
+
+    QMutexLocker locker(&mutex);
+
+    auto it = templates.constFind(fileName);
+    if (it != templates.constEnd()) {
+        return it.value();
+    }
+
+    const HtmlTemplate t(QzTools::readAllFileContents(fileName));
+    templates.insert(fileName, t);
+    return t;
+}
+
+void HtmlTemplate::parse(const QString &contents)
+{
+    const int size = contents.size();
+    int literalStart = 0;
+    int pos = 0;
+
+    auto addSegment = [this](const QString &text, bool placeholder) {
+        if (text.isEmpty()) {
+            return;
+        }
+        Segment segment;
+        segment.text = text;
+        segment.placeholder = placeholder;
+        m_segments.append(segment);
+        if (!placeholder) {
+            m_literalSize += text.size();
+        }
+    };
+
+    while (pos < size) {
+        if (contents.at(pos) != QL1C('%')) {
+            ++pos;
+            continue;
+        }
+
+        // Placeholder name must start with letter, so that eg. "100%;" in CSS is not matched
+        int end = pos + 1;
+        if (end < size && contents.at(end).unicode() >= 'A' && contents.at(end).unicode() <= 'Z') {
+            while (end < size && isPlaceholderChar(contents.at(end))) {
+                ++end;
+            }
+        }
+
+        if (end > pos + 1 && end < size && contents.at(end) == QL1C('%')) {
+            addSegment(contents.mid(literalStart, pos - literalStart), false);
+            addSegment(contents.mid(pos + 1, end - pos - 1), true);
+            pos = end + 1;
+            literalStart = pos;
+        } else {
+            ++pos;
+        }
+    }
+
+    addSegment(contents.mid(literalStart), false);
+}
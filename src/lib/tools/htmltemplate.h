@@ -0,0 +1,56 @@
+/* ============================================================
+* Falkon - Qt web browser
+* Copyright (C) 2018 David Rosca <nowrep@gmail.com>
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program.  If not, see <http://www.gnu.org/licenses/>.
+* ============================================================ */
+#ifndef HTMLTEMPLATE_H
+#define HTMLTEMPLATE_H
+
+#include <QHash>
+#include <QString>
+#include <QVector>
+
+#include "qzcommon.h"
+
+// Template with %PLACEHOLDER% markers, parsed only once into literal and placeholder segments.
+// Rendering is a single pass over the segments, unknown placeholders are kept as-is.
+// %DIRECTION%, %RIGHT_STR% and %LEFT_STR% are filled automatically from application layout direction.
+class FALKON_EXPORT HtmlTemplate
+{
+public:
+    typedef QHash<QString, QString> Values;
+
+    HtmlTemplate();
+    explicit HtmlTemplate(const QString &contents);
+
+    bool isEmpty() const;
+    QString render(const Values &values = Values()) const;
+
+    // Thread-safe, file is read and parsed only on first use
+    static HtmlTemplate fromFile(const QString &fileName);
+
+private:
+    struct Segment {
+        QString text;
+        bool placeholder;
+    };
+
+    void parse(const QString &contents);
+
+    QVector<Segment> m_segments;
+    int m_literalSize;
+};
+
+#endif // HTMLTEMPLATE_H
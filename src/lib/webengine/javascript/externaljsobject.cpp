@@ -21,6 +21,7 @@
 #include "speeddial.h"
 #include "webpage.h"
 #include "autofilljsobject.h"
+#include "scrollbarjsobject.h"
 #include "restoremanager.h"
 
 #include <QWebChannel>
@@ -31,6 +32,7 @@ ExternalJsObject::ExternalJsObject(WebPage *page)
     : QObject(page)
     , m_page(page)
     , m_autoFill(new AutoFillJsObject(this))
+    , m_scrollBars(new ScrollBarJsObject(this))
 {
 }
 
@@ -81,3 +83,8 @@ QObject *ExternalJsObject::recovery() const
 
     return mApp->restoreManager()->recoveryObject(m_page);
 }
+
+QObject *ExternalJsObject::scrollBars() const
+{
+    return m_scrollBars;
+}
@@ -42,6 +42,7 @@
 #include "ui_jsprompt.h"
 #include "passwordmanager.h"
 #include "scripts.h"
+#include "htmltemplate.h"
 
 #include <iostream>
 
@@ -217,6 +218,16 @@ bool WebPage::isLoading() const
     return m_loadProgress < 100;
 }
 
+QWebEnginePage::NavigationType WebPage::lastNavigationType() const
+{
+    return m_lastNavigationType;
+}
+
+QUrl WebPage::lastNavigationReferrer() const
+{
+    return m_lastNavigationReferrer;
+}
+
 // static
 QStringList WebPage::internalSchemes()
 {
@@ -419,14 +430,14 @@ void WebPage::renderProcessTerminated(QWebEnginePage::RenderProcessTerminationSt
         return;
 
     QTimer::singleShot(0, this, [this]() {
-        QString page = QzTools::readAllFileContents(":html/tabcrash.html");
-        page.replace(QL1S("%IMAGE%"), QzTools::pixmapToDataUrl(IconProvider::standardIcon(QStyle::SP_MessageBoxWarning).pixmap(45)).toString());
-        page.replace(QL1S("%TITLE%"), tr("Failed loading page"));
-        page.replace(QL1S("%HEADING%"), tr("Failed loading page"));
-        page.replace(QL1S("%LI-1%"), tr("Something went wrong while loading this page."));
-        page.replace(QL1S("%LI-2%"), tr("Try reloading the page or closing some tabs to make more memory available."));
-        page.replace(QL1S("%RELOAD-PAGE%"), tr("Reload page"));
-        page = QzTools::applyDirectionToPage(page);
+        HtmlTemplate::Values values;
+        values[QSL("IMAGE")] = QzTools::pixmapToDataUrl(IconProvider::standardIcon(QStyle::SP_MessageBoxWarning).pixmap(45)).toString();
+        values[QSL("TITLE")] = tr("Failed loading page");
+        values[QSL("HEADING")] = tr("Failed loading page");
+        values[QSL("LI-1")] = tr("Something went wrong while loading this page.");
+        values[QSL("LI-2")] = tr("Try reloading the page or closing some tabs to make more memory available.");
+        values[QSL("RELOAD-PAGE")] = tr("Reload page");
+        const QString page = HtmlTemplate::fromFile(QSL(":html/tabcrash.html")).render(values);
         setHtml(page.toUtf8(), url());
     });
 }
@@ -460,6 +471,9 @@ bool WebPage::acceptNavigationRequest(const QUrl &url, QWebEnginePage::Navigatio
             const bool isWeb = url.scheme() == QL1S("http") || url.scheme() == QL1S("https") || url.scheme() == QL1S("file");
             const bool globalJsEnabled = mApp->webSettings()->testAttribute(QWebEngineSettings::JavascriptEnabled);
             settings()->setAttribute(QWebEngineSettings::JavascriptEnabled, isWeb ? globalJsEnabled : true);
+
+            m_lastNavigationType = type;
+            m_lastNavigationReferrer = type == NavigationTypeTyped ? QUrl() : this->url();
         }
         emit navigationRequestAccepted(url, type, isMainFrame);
     }
@@ -71,6 +71,10 @@ public:
 
     bool isLoading() const;
 
+    // Type and referrer of the last accepted main frame navigation
+    NavigationType lastNavigationType() const;
+    QUrl lastNavigationReferrer() const;
+
     static QStringList internalSchemes();
     static QStringList supportedSchemes();
     static void addSupportedScheme(const QString &scheme);
@@ -113,6 +117,8 @@ private:
     QWebEngineRegisterProtocolHandlerRequest *m_registerProtocolHandlerRequest = nullptr;
 
     int m_loadProgress;
+    NavigationType m_lastNavigationType = NavigationTypeOther;
+    QUrl m_lastNavigationReferrer;
     bool m_blockAlerts;
     bool m_secureStatus;
 
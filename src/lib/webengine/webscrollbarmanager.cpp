@@ -24,7 +24,7 @@
 #include "scripts.h"
 #include "settings.h"
 
-#include <QPointer>
+#include <QTimer>
 #include <QPaintEvent>
 #include <QWebEngineProfile>
 #include <QWebEngineScriptCollection>
@@ -86,6 +86,7 @@ struct ScrollBarData {
     WebScrollBar *hscrollbar;
     bool vscrollbarVisible = false;
     bool hscrollbarVisible = false;
+    bool updateScheduled = false;
     WebScrollBarCornerWidget *corner;
 };
 
@@ -104,6 +105,44 @@ WebScrollBarManager::WebScrollBarManager(QObject *parent)
                          "head.appendChild(css);"
                          "})()");
 
+    // Reports overflow changes through web channel, checked at most once per frame
+    m_overflowJs = QL1S("(function() {"
+                        "var vertical = null;"
+                        "var horizontal = null;"
+                        "var scheduled = false;"
+                        "function report() {"
+                        "    external.scrollBars.overflowChanged(vertical, horizontal);"
+                        "}"
+                        "function check() {"
+                        "    scheduled = false;"
+                        "    var e = document.documentElement;"
+                        "    if (!e) return;"
+                        "    var v = window.innerWidth > e.clientWidth;"
+                        "    var h = window.innerHeight > e.clientHeight;"
+                        "    if (v === vertical && h === horizontal) return;"
+                        "    vertical = v;"
+                        "    horizontal = h;"
+                        "    if (window._falkon_external)"
+                        "        report();"
+                        "    else"
+                        "        document.addEventListener('_falkon_external_created', report, {once: true});"
+                        "}"
+                        "function schedule() {"
+                        "    if (scheduled) return;"
+                        "    scheduled = true;"
+                        "    window.requestAnimationFrame(check);"
+                        "}"
+                        "window.addEventListener('resize', schedule);"
+                        "if (window.ResizeObserver) {"
+                        "    var observer = new ResizeObserver(schedule);"
+                        "    observer.observe(document.documentElement);"
+                        "    if (document.body) observer.observe(document.body);"
+                        "} else {"
+                        "    new MutationObserver(schedule).observe(document.documentElement, {childList: true, subtree: true, attributes: true});"
+                        "}"
+                        "schedule();"
+                        "})()");
+
     loadSettings();
 }
 
@@ -135,34 +174,12 @@ void WebScrollBarManager::addWebView(WebView *view)
     const int thickness = data->vscrollbar->thickness();
 
     auto updateValues = [=]() {
-        const QSize viewport = viewportSize(view, thickness);
-        data->vscrollbar->updateValues(viewport);
-        data->vscrollbar->setVisible(data->vscrollbarVisible);
-        data->hscrollbar->updateValues(viewport);
-        data->hscrollbar->setVisible(data->hscrollbarVisible);
-        data->corner->updateVisibility(data->vscrollbarVisible && data->hscrollbarVisible, thickness);
+        updateScrollBars(view);
     };
 
     connect(view, &WebView::viewportResized, data->vscrollbar, updateValues);
     connect(view->page(), &WebPage::scrollPositionChanged, data->vscrollbar, updateValues);
-
-    connect(view->page(), &WebPage::contentsSizeChanged, data->vscrollbar, [=]() {
-        const QString source = QL1S("var out = {"
-                                    "vertical: document.documentElement && window.innerWidth > document.documentElement.clientWidth,"
-                                    "horizontal: document.documentElement && window.innerHeight > document.documentElement.clientHeight"
-                                    "};out;");
-
-        QPointer<WebView> p(view);
-        view->page()->runJavaScript(source, WebPage::SafeJsWorld, [=](const QVariant &res) {
-            if (!p || !m_scrollbars.contains(view)) {
-                return;
-            }
-            const QVariantMap map = res.toMap();
-            data->vscrollbarVisible = map.value(QSL("vertical")).toBool();
-            data->hscrollbarVisible = map.value(QSL("horizontal")).toBool();
-            updateValues();
-        });
-    });
+    connect(view->page(), &WebPage::contentsSizeChanged, data->vscrollbar, updateValues);
 
     connect(view, &WebView::zoomLevelChanged, data->vscrollbar, [=]() {
         view->page()->runJavaScript(m_scrollbarJs.arg(thickness));
@@ -195,6 +212,33 @@ QScrollBar *WebScrollBarManager::scrollBar(Qt::Orientation orientation, WebView
     return orientation == Qt::Vertical ? d->vscrollbar : d->hscrollbar;
 }
 
+void WebScrollBarManager::setOverflow(WebPage *page, bool vertical, bool horizontal)
+{
+    WebView *view = qobject_cast<WebView*>(page->view());
+    ScrollBarData *data = m_scrollbars.value(view);
+    if (!data) {
+        return;
+    }
+
+    if (data->vscrollbarVisible == vertical && data->hscrollbarVisible == horizontal) {
+        return;
+    }
+
+    data->vscrollbarVisible = vertical;
+    data->hscrollbarVisible = horizontal;
+
+    // Coalesce changes from multiple frames into one update
+    if (data->updateScheduled) {
+        return;
+    }
+    data->updateScheduled = true;
+
+    QTimer::singleShot(0, data->vscrollbar, [=]() {
+        data->updateScheduled = false;
+        updateScrollBars(view);
+    });
+}
+
 WebScrollBarManager *WebScrollBarManager::instance()
 {
     return qz_web_scrollbar_manager();
@@ -208,12 +252,36 @@ void WebScrollBarManager::createUserScript(int thickness)
     script.setWorldId(WebPage::SafeJsWorld);
     script.setSourceCode(m_scrollbarJs.arg(thickness));
     mApp->webProfile()->scripts()->insert(script);
+
+    QWebEngineScript overflowScript;
+    overflowScript.setName(QSL("_falkon_scrollbar_overflow"));
+    overflowScript.setInjectionPoint(QWebEngineScript::DocumentReady);
+    overflowScript.setWorldId(WebPage::SafeJsWorld);
+    overflowScript.setSourceCode(m_overflowJs);
+    mApp->webProfile()->scripts()->insert(overflowScript);
 }
 
 void WebScrollBarManager::removeUserScript()
 {
     QWebEngineScript script = mApp->webProfile()->scripts()->findScript(QSL("_falkon_scrollbar"));
     mApp->webProfile()->scripts()->remove(script);
+
+    QWebEngineScript overflowScript = mApp->webProfile()->scripts()->findScript(QSL("_falkon_scrollbar_overflow"));
+    mApp->webProfile()->scripts()->remove(overflowScript);
+}
+
+void WebScrollBarManager::updateScrollBars(WebView *view) const
+{
+    ScrollBarData *data = m_scrollbars.value(view);
+    Q_ASSERT(data);
+
+    const int thickness = data->vscrollbar->thickness();
+    const QSize viewport = viewportSize(view, thickness);
+    data->vscrollbar->updateValues(viewport);
+    data->vscrollbar->setVisible(data->vscrollbarVisible);
+    data->hscrollbar->updateValues(viewport);
+    data->hscrollbar->setVisible(data->hscrollbarVisible);
+    data->corner->updateVisibility(data->vscrollbarVisible && data->hscrollbarVisible, thickness);
 }
 
 QSize WebScrollBarManager::viewportSize(WebView *view, int thickness) const
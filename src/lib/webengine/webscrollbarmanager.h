@@ -25,6 +25,7 @@
 class QScrollBar;
 
 class WebView;
+class WebPage;
 
 class WebScrollBarManager : public QObject
 {
@@ -40,15 +41,20 @@ public:
 
     QScrollBar *scrollBar(Qt::Orientation orientation, WebView *view) const;
 
+    // Called from page script when overflow of document changes
+    void setOverflow(WebPage *page, bool vertical, bool horizontal);
+
     static WebScrollBarManager *instance();
 
 private:
     void createUserScript(int thickness);
     void removeUserScript();
+    void updateScrollBars(WebView *view) const;
     QSize viewportSize(WebView *view, int thickness) const;
 
     bool m_enabled = true;
     QString m_scrollbarJs;
+    QString m_overflowJs;
     QHash<WebView*, struct ScrollBarData*> m_scrollbars;
 };
 
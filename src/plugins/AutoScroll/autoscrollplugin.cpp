@@ -41,10 +41,12 @@ void AutoScrollPlugin::init(InitState state, const QString &settingsPath)
 
     m_scroller = new AutoScroller(settingsPath + QL1S("/extensions.ini"), this);
 
-    mApp->plugins()->registerAppEventHandler(PluginProxy::MouseMoveHandler, this);
-    mApp->plugins()->registerAppEventHandler(PluginProxy::MousePressHandler, this);
-    mApp->plugins()->registerAppEventHandler(PluginProxy::MouseReleaseHandler, this);
-    mApp->plugins()->registerAppEventHandler(PluginProxy::WheelEventHandler, this);
+    PluginProxy::HandlerFilter filter;
+    filter.objects = {Qz::ON_WebView};
+    mApp->plugins()->registerAppEventHandler(PluginProxy::MouseMoveHandler, this, filter);
+    mApp->plugins()->registerAppEventHandler(PluginProxy::MousePressHandler, this, filter);
+    mApp->plugins()->registerAppEventHandler(PluginProxy::MouseReleaseHandler, this, filter);
+    mApp->plugins()->registerAppEventHandler(PluginProxy::WheelEventHandler, this, filter);
 }
 
 void AutoScrollPlugin::unload()
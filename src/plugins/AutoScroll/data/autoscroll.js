@@ -0,0 +1,60 @@
+// Persistent autoscroll driven by requestAnimationFrame,
+// Falkon only pushes new velocity when mouse offset changes
+//
+// %1 - horizontal velocity (pixels per 10 ms)
+// %2 - vertical velocity (pixels per 10 ms)
+
+(function() {
+    if (!window._falkon_autoScroll) {
+        var vx = 0;
+        var vy = 0;
+        var remainderX = 0;
+        var remainderY = 0;
+        var lastTime = 0;
+        var frameId = 0;
+
+        function step(time) {
+            // Clamp long frames, eg. when page was hidden
+            var elapsed = lastTime ? Math.min(time - lastTime, 100) : 16;
+            lastTime = time;
+
+            remainderX += vx * elapsed / 10;
+            remainderY += vy * elapsed / 10;
+
+            var x = Math.trunc(remainderX);
+            var y = Math.trunc(remainderY);
+            remainderX -= x;
+            remainderY -= y;
+
+            if (x || y) {
+                window.scrollBy(x, y);
+            }
+
+            frameId = window.requestAnimationFrame(step);
+        }
+
+        window._falkon_autoScroll = {
+            setVelocity: function(x, y) {
+                vx = x;
+                vy = y;
+
+                if (!vx && !vy) {
+                    if (frameId) {
+                        window.cancelAnimationFrame(frameId);
+                        frameId = 0;
+                    }
+                    remainderX = 0;
+                    remainderY = 0;
+                    return;
+                }
+
+                if (!frameId) {
+                    lastTime = 0;
+                    frameId = window.requestAnimationFrame(step);
+                }
+            }
+        };
+    }
+
+    window._falkon_autoScroll.setVelocity(%1, %2);
+})();
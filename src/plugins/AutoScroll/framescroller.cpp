@@ -17,24 +17,26 @@
 * ============================================================ */
 #include "framescroller.h"
 #include "webpage.h"
+#include "qztools.h"
 
-#include <QTimer>
 #include <QtMath>
 
 FrameScroller::FrameScroller(QObject* parent)
     : QObject(parent)
-    , m_page(0)
-    , m_lengthX(0)
-    , m_lengthY(0)
+    , m_velocityX(0)
+    , m_velocityY(0)
     , m_divider(8.0)
 {
-    m_timer = new QTimer(this);
-    m_timer->setInterval(10);
-    connect(m_timer, &QTimer::timeout, this, &FrameScroller::scrollStep);
+    m_scrollScript = QzTools::readAllFileContents(QSL(":/autoscroll/data/autoscroll.js"));
 }
 
 void FrameScroller::setPage(WebPage *page)
 {
+    if (m_page == page) {
+        return;
+    }
+
+    stopScrolling();
     m_page = page;
 }
 
@@ -50,23 +52,48 @@ void FrameScroller::setScrollDivider(double divider)
 
 void FrameScroller::startScrolling(int lengthX, int lengthY)
 {
-    m_lengthX = lengthX;
-    m_lengthY = lengthY;
-
-    if (m_lengthX == 0 && m_lengthY == 0) {
-        m_timer->stop();
-    }
-    else if (!m_timer->isActive()) {
-        m_timer->start();
-    }
+    setVelocity(qCeil(lengthX / m_divider), qCeil(lengthY / m_divider));
 }
 
 void FrameScroller::stopScrolling()
 {
-    m_timer->stop();
+    setVelocity(0, 0);
+}
+
+void FrameScroller::setVelocity(int x, int y)
+{
+    // Only push changes, the script keeps scrolling on its own
+    if (m_velocityX == x && m_velocityY == y) {
+        return;
+    }
+
+    m_velocityX = x;
+    m_velocityY = y;
+
+    if (!m_page) {
+        return;
+    }
+
+    const QString source = QSL("(function(){"
+                               "if (!window._falkon_autoScroll) return false;"
+                               "window._falkon_autoScroll.setVelocity(%1, %2);"
+                               "return true;"
+                               "})()").arg(x).arg(y);
+
+    QPointer<WebPage> page = m_page;
+    m_page->runJavaScript(source, WebPage::SafeJsWorld, [=](const QVariant &res) {
+        // Script is gone after navigation, install it with current velocity
+        if (!res.toBool() && page && page == m_page) {
+            installScript();
+        }
+    });
 }
 
-void FrameScroller::scrollStep()
+void FrameScroller::installScript()
 {
-    m_page->scroll(qCeil(m_lengthX / m_divider), qCeil(m_lengthY / m_divider));
+    if (m_velocityX == 0 && m_velocityY == 0) {
+        return;
+    }
+
+    m_page->runJavaScript(m_scrollScript.arg(m_velocityX).arg(m_velocityY), WebPage::SafeJsWorld);
 }
@@ -19,8 +19,7 @@
 #define FRAMESCROLLER_H
 
 #include <QObject>
-
-class QTimer;
+#include <QPointer>
 
 class WebPage;
 
@@ -39,15 +38,16 @@ public:
     void startScrolling(int lengthX, int lengthY);
     void stopScrolling();
 
-private Q_SLOTS:
-    void scrollStep();
-
 private:
-    WebPage *m_page;
-    QTimer* m_timer;
+    void setVelocity(int x, int y);
+    void installScript();
+
+    QPointer<WebPage> m_page;
+    QString m_scrollScript;
 
-    int m_lengthX;
-    int m_lengthY;
+    // Pixels scrolled per 10 ms
+    int m_velocityX;
+    int m_velocityY;
     double m_divider;
 };
 
@@ -0,0 +1,156 @@
+/* ============================================================
+* Falkon - Qt web browser
+* Copyright (C) 2018 David Rosca <nowrep@gmail.com>
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program.  If not, see <http://www.gnu.org/licenses/>.
+* ============================================================ */
+#include "../gm_urlmatcher.h"
+
+#include <QtTest/QtTest>
+
+class GM_UrlMatcherTest : public QObject
+{
+    Q_OBJECT
+
+private Q_SLOTS:
+    void includeTest_data();
+    void includeTest();
+    void excludeTest_data();
+    void excludeTest();
+    void matchTest_data();
+    void matchTest();
+};
+
+static void addColumns()
+{
+    QTest::addColumn<QString>("pattern");
+    QTest::addColumn<QString>("url");
+    QTest::addColumn<bool>("result");
+}
+
+static bool matches(const QString &pattern, GM_UrlMatcher::PatternType type, const QString &urlString)
+{
+    const QUrl url(urlString);
+    return GM_UrlMatcher(pattern, type).match(url, url.toString());
+}
+
+void GM_UrlMatcherTest::includeTest_data()
+{
+    addColumns();
+
+    // Exact
+    QTest::newRow("exact") << "http://example.com/" << "http://example.com/" << true;
+    QTest::newRow("exact-case") << "http://example.com/Page" << "http://example.com/page" << true;
+    QTest::newRow("exact-other") << "http://example.com/" << "http://example.com/page" << false;
+
+    // Prefix
+    QTest::newRow("prefix") << "http://example.com/*" << "http://example.com/path?q=1" << true;
+    QTest::newRow("prefix-scheme") << "http://example.com/*" << "https://example.com/" << false;
+
+    // Glob
+    QTest::newRow("all") << "*" << "ftp://example.org/file" << true;
+    QTest::newRow("glob-subdomain") << "http://*.example.com/*" << "http://www.example.com/x" << true;
+    QTest::newRow("glob-other-host") << "http://*.example.com/*" << "http://example.org/" << false;
+    QTest::newRow("glob-middle") << "*://example.com/*/edit" << "https://example.com/wiki/Page/edit" << true;
+    QTest::newRow("glob-middle-suffix") << "*://example.com/*/edit" << "https://example.com/wiki/Page/view" << false;
+    QTest::newRow("glob-special-chars") << "http://example.com/*(c)+" << "http://example.com/ab(c)+" << true;
+
+    // .tld
+    QTest::newRow("tld-com") << "http://www.google.tld/*" << "http://www.google.com/search" << true;
+    QTest::newRow("tld-co-uk") << "http://www.google.tld/*" << "http://www.google.co.uk/search" << true;
+    QTest::newRow("tld-other-host") << "http://www.google.tld/*" << "http://www.example.com/search" << false;
+
+    // Regular expression
+    QTest::newRow("regexp") << "/^https?:\\/\\/example\\.(com|org)\\//" << "https://example.org/x" << true;
+    QTest::newRow("regexp-case") << "/^https?:\\/\\/example\\.(com|org)\\//" << "HTTP://EXAMPLE.COM/" << true;
+    QTest::newRow("regexp-scheme") << "/^https?:\\/\\/example\\.(com|org)\\//" << "ftp://example.com/" << false;
+    QTest::newRow("regexp-invalid") << "/([/" << "http://example.com/([" << false;
+
+    QTest::newRow("empty") << "" << "http://example.com/" << false;
+}
+
+void GM_UrlMatcherTest::includeTest()
+{
+    QFETCH(QString, pattern);
+    QFETCH(QString, url);
+    QFETCH(bool, result);
+
+    QCOMPARE(matches(pattern, GM_UrlMatcher::IncludePattern, url), result);
+}
+
+void GM_UrlMatcherTest::excludeTest_data()
+{
+    addColumns();
+
+    QTest::newRow("logout") << "*/logout*" << "https://example.com/logout?next=/" << true;
+    QTest::newRow("logout-other") << "*/logout*" << "https://example.com/login" << false;
+    QTest::newRow("host") << "https://mail.example.com/*" << "https://mail.example.com/inbox" << true;
+    QTest::newRow("host-other") << "https://mail.example.com/*" << "https://www.example.com/inbox" << false;
+    QTest::newRow("regexp") << "/\\.pdf$/" << "http://example.com/doc.PDF" << true;
+}
+
+void GM_UrlMatcherTest::excludeTest()
+{
+    QFETCH(QString, pattern);
+    QFETCH(QString, url);
+    QFETCH(bool, result);
+
+    // @exclude patterns use the same syntax as @include
+    QCOMPARE(matches(pattern, GM_UrlMatcher::IncludePattern, url), result);
+}
+
+void GM_UrlMatcherTest::matchTest_data()
+{
+    addColumns();
+
+    QTest::newRow("all-urls") << "<all_urls>" << "ftp://example.com/file" << true;
+
+    // Scheme
+    QTest::newRow("any-scheme-http") << "*://example.com/*" << "http://example.com/" << true;
+    QTest::newRow("any-scheme-https") << "*://example.com/*" << "https://example.com/a" << true;
+    QTest::newRow("any-scheme-ftp") << "*://example.com/*" << "ftp://example.com/" << false;
+    QTest::newRow("scheme") << "https://example.com/*" << "http://example.com/" << false;
+
+    // Host
+    QTest::newRow("subdomains-base") << "*://*.example.com/*" << "http://example.com/" << true;
+    QTest::newRow("subdomains-nested") << "*://*.example.com/*" << "https://a.b.example.com/x" << true;
+    QTest::newRow("subdomains-suffix") << "*://*.example.com/*" << "http://badexample.com/" << false;
+    QTest::newRow("any-host") << "https://*/*" << "https://anything.org/x" << true;
+    QTest::newRow("host-case") << "https://EXAMPLE.com/*" << "https://example.com/" << true;
+    QTest::newRow("host-other") << "https://example.com/*" << "https://www.example.com/" << false;
+
+    // Path
+    QTest::newRow("path-prefix") << "https://example.com/foo*" << "https://example.com/foobar?x=1" << true;
+    QTest::newRow("path-other") << "https://example.com/foo*" << "https://example.com/bar" << false;
+    QTest::newRow("path-query") << "*://example.com/search?q=*" << "https://example.com/search?q=test" << true;
+    QTest::newRow("path-exact") << "https://example.com/" << "https://example.com/page" << false;
+    QTest::newRow("file") << "file:///*" << "file:///home/user/page.html" << true;
+
+    // Invalid
+    QTest::newRow("no-scheme") << "example.com/*" << "http://example.com/" << false;
+    QTest::newRow("no-path") << "http://example.com" << "http://example.com/" << false;
+}
+
+void GM_UrlMatcherTest::matchTest()
+{
+    QFETCH(QString, pattern);
+    QFETCH(QString, url);
+    QFETCH(bool, result);
+
+    QCOMPARE(matches(pattern, GM_UrlMatcher::MatchPattern, url), result);
+}
+
+QTEST_GUILESS_MAIN(GM_UrlMatcherTest)
+
+#include "gm_urlmatchertest.moc"
@@ -25,6 +25,9 @@
 
 #include "browserwindow.h"
 #include "webpage.h"
+#include "webtab.h"
+#include "tabwidget.h"
+#include "tabbedwebview.h"
 #include "qztools.h"
 #include "mainapplication.h"
 #include "networkmanager.h"
@@ -35,14 +38,16 @@
 
 #include <QTimer>
 #include <QDir>
+#include <QCryptographicHash>
 #include <QSettings>
-#include <QWebEngineProfile>
+#include <QWebEngineScript>
 #include <QWebEngineScriptCollection>
 
 GM_Manager::GM_Manager(const QString &sPath, QObject* parent)
     : QObject(parent)
     , m_settingsPath(sPath)
     , m_jsObject(new GM_JSObject(this))
+    , m_scriptsRevision(0)
 {
     load();
 }
@@ -95,32 +100,96 @@ QString GM_Manager::scriptsDirectory() const
     return m_settingsPath + QL1S("/greasemonkey");
 }
 
-QString GM_Manager::requireScripts(const QStringList &urlList) const
+QString GM_Manager::requireScripts(const QStringList &urlList)
 {
-    QDir requiresDir(m_settingsPath + QL1S("/greasemonkey/requires"));
-    if (!requiresDir.exists() || urlList.isEmpty()) {
+    QString script;
+
+    foreach (const QString &url, urlList) {
+        const QString data = requireScript(url);
+        if (!data.isEmpty()) {
+            script.append(data + QL1C('\n'));
+        }
+    }
+
+    return script;
+}
+
+bool GM_Manager::containsRequireScript(const QString &url)
+{
+    return !requireScript(url).isEmpty();
+}
+
+GM_Downloader* GM_Manager::downloadRequireScript(const QString &url)
+{
+    GM_Downloader *downloader = m_requireDownloads.value(url);
+    if (downloader) {
+        return downloader;
+    }
+
+    downloader = new GM_Downloader(QUrl(url), this, GM_Downloader::DownloadRequireScript);
+    m_requireDownloads.insert(url, downloader);
+
+    // Connected before scripts, so the cache is updated when they get notified
+    connect(downloader, &GM_Downloader::finished, this, [=](const QString &fileName) {
+        requireScriptDownloaded(url, fileName);
+    });
+    connect(downloader, &GM_Downloader::error, this, [=]() {
+        m_requireDownloads.remove(url);
+    });
+
+    return downloader;
+}
+
+QString GM_Manager::requireScript(const QString &url)
+{
+    const QString fileName = requireFileName(url);
+    if (fileName.isEmpty()) {
         return QString();
     }
 
+    auto it = m_requireHashes.constFind(fileName);
+    if (it != m_requireHashes.constEnd()) {
+        return m_requireContents.value(it.value());
+    }
+
+    const QByteArray data = QzTools::readAllFileByteContents(fileName);
+    const QByteArray hash = QCryptographicHash::hash(data, QCryptographicHash::Sha1);
+    m_requireHashes.insert(fileName, hash);
+
+    if (!m_requireContents.contains(hash)) {
+        m_requireContents.insert(hash, QString::fromUtf8(data).trimmed());
+    }
+
+    return m_requireContents.value(hash);
+}
+
+QString GM_Manager::requireFileName(const QString &url)
+{
+    auto it = m_requireFiles.constFind(url);
+    if (it != m_requireFiles.constEnd()) {
+        return it.value();
+    }
+
     QSettings settings(m_settingsPath + QL1S("/greasemonkey/requires/requires.ini"), QSettings::IniFormat);
     settings.beginGroup("Files");
 
-    QString script;
-
-    foreach (const QString &url, urlList) {
-        if (settings.contains(url)) {
-            QString fileName = settings.value(url).toString();
-            if (!QFileInfo(fileName).isAbsolute()) {
-                fileName = m_settingsPath + QL1S("/greasemonkey/requires/") + fileName;
-            }
-            const QString data = QzTools::readAllFileContents(fileName).trimmed();
-            if (!data.isEmpty()) {
-                script.append(data + QL1C('\n'));
-            }
-        }
+    QString fileName = settings.value(url).toString();
+    if (!fileName.isEmpty() && !QFileInfo(fileName).isAbsolute()) {
+        fileName = m_settingsPath + QL1S("/greasemonkey/requires/") + fileName;
     }
 
-    return script;
+    // Also remember missing requires
+    m_requireFiles.insert(url, fileName);
+    return fileName;
+}
+
+void GM_Manager::requireScriptDownloaded(const QString &url, const QString &fileName)
+{
+    m_requireDownloads.remove(url);
+    m_requireFiles.insert(url, fileName);
+
+    // Reload contents on next use
+    m_requireHashes.remove(fileName);
 }
 
 QString GM_Manager::bootstrapScript() const
@@ -143,6 +212,13 @@ void GM_Manager::unloadPlugin()
 
     delete m_settings.data();
 
+    // Includes pages of popup windows
+    foreach (WebPage* page, m_pages) {
+        page->disconnect(this);
+        removePageScripts(page);
+    }
+    m_pages.clear();
+
     // Remove icons from all windows
     QHashIterator<BrowserWindow*, GM_Icon*> it(m_windows);
     while (it.hasNext()) {
@@ -172,8 +248,7 @@ void GM_Manager::enableScript(GM_Script* script)
     script->setEnabled(true);
     m_disabledScripts.removeOne(script->fullName());
 
-    QWebEngineScriptCollection *collection = mApp->webProfile()->scripts();
-    collection->insert(script->webScript());
+    scriptsUpdated();
 }
 
 void GM_Manager::disableScript(GM_Script* script)
@@ -181,8 +256,7 @@ void GM_Manager::disableScript(GM_Script* script)
     script->setEnabled(false);
     m_disabledScripts.append(script->fullName());
 
-    QWebEngineScriptCollection *collection = mApp->webProfile()->scripts();
-    collection->remove(collection->findScript(script->fullName()));
+    scriptsUpdated();
 }
 
 bool GM_Manager::addScript(GM_Script* script)
@@ -194,8 +268,7 @@ bool GM_Manager::addScript(GM_Script* script)
     m_scripts.append(script);
     connect(script, &GM_Script::scriptChanged, this, &GM_Manager::scriptChanged);
 
-    QWebEngineScriptCollection *collection = mApp->webProfile()->scripts();
-    collection->insert(script->webScript());
+    scriptsUpdated();
 
     emit scriptsChanged();
     return true;
@@ -209,8 +282,7 @@ bool GM_Manager::removeScript(GM_Script* script, bool removeFile)
 
     m_scripts.removeOne(script);
 
-    QWebEngineScriptCollection *collection = mApp->webProfile()->scripts();
-    collection->remove(collection->findScript(script->fullName()));
+    scriptsUpdated();
 
     m_disabledScripts.removeOne(script->fullName());
 
@@ -262,9 +334,6 @@ void GM_Manager::load()
         if (m_disabledScripts.contains(script->fullName())) {
             script->setEnabled(false);
         }
-        else {
-            mApp->webProfile()->scripts()->insert(script->webScript());
-        }
     }
 
     m_jsObject->setSettingsFile(m_settingsPath + QSL("/greasemonkey/values.ini"));
@@ -277,9 +346,118 @@ void GM_Manager::scriptChanged()
     if (!script)
         return;
 
-    QWebEngineScriptCollection *collection = mApp->webProfile()->scripts();
-    collection->remove(collection->findScript(script->fullName()));
-    collection->insert(script->webScript());
+    scriptsUpdated();
+}
+
+void GM_Manager::webPageCreated(WebPage* page)
+{
+    if (m_pages.contains(page)) {
+        return;
+    }
+    m_pages.insert(page);
+
+    connect(page, &QObject::destroyed, this, [=]() {
+        m_pages.remove(page);
+    });
+
+    // Scripts are updated only once all plugins accepted the navigation
+    connect(page, &WebPage::navigationRequestAccepted, this, [=](const QUrl &url, QWebEnginePage::NavigationType type, bool isMainFrame) {
+        Q_UNUSED(type)
+        updatePageScripts(page, url, isMainFrame);
+    });
+
+    // Server redirects don't go through acceptNavigationRequest with QtWebEngine < 5.14
+    connect(page, &QWebEnginePage::urlChanged, this, [=](const QUrl &url) {
+        if (page->property("_gm_url").toUrl() != url) {
+            updatePageScripts(page, url, true);
+        }
+    });
+}
+
+void GM_Manager::updatePageScripts(WebPage* page, const QUrl &url, bool isMainFrame)
+{
+    if (isMainFrame) {
+        page->setProperty("_gm_url", url);
+    }
+
+    const QStringList oldNames = page->property("_gm_scripts").toStringList();
+    const bool upToDate = page->property("_gm_revision").toInt() == m_scriptsRevision;
+
+    QStringList names;
+    if (!isMainFrame && upToDate) {
+        names = oldNames;
+    }
+
+    const QString urlString = url.toString();
+
+    foreach (GM_Script* script, m_scripts) {
+        if (!script->isEnabled() || (!isMainFrame && script->noFrames()) || names.contains(script->fullName())) {
+            continue;
+        }
+        if (script->match(url, urlString)) {
+            names.append(script->fullName());
+        }
+    }
+
+    if (upToDate && names == oldNames) {
+        return;
+    }
+
+    QWebEngineScriptCollection *collection = page->scripts();
+    removeWebScripts(collection);
+
+    if (!names.isEmpty()) {
+        QWebEngineScript bootstrap;
+        bootstrap.setName(webScriptName(QSL("bootstrap")));
+        bootstrap.setSourceCode(m_bootstrapScript);
+        bootstrap.setWorldId(WebPage::SafeJsWorld);
+        bootstrap.setInjectionPoint(QWebEngineScript::DocumentCreation);
+        bootstrap.setRunsOnSubFrames(false);
+
+        QList<QWebEngineScript> scripts;
+        foreach (GM_Script* script, m_scripts) {
+            if (names.contains(script->fullName())) {
+                scripts.append(script->webScript());
+                if (!script->noFrames()) {
+                    bootstrap.setRunsOnSubFrames(true);
+                }
+            }
+        }
+
+        // Shared bootstrap is injected once before all scripts
+        collection->insert(bootstrap);
+        collection->insert(scripts);
+    }
+
+    page->setProperty("_gm_scripts", names);
+    page->setProperty("_gm_revision", m_scriptsRevision);
+}
+
+void GM_Manager::scriptsUpdated()
+{
+    // Pages will be updated on next navigation
+    ++m_scriptsRevision;
+}
+
+void GM_Manager::removePageScripts(WebPage* page)
+{
+    removeWebScripts(page->scripts());
+    page->setProperty("_gm_scripts", QVariant());
+    page->setProperty("_gm_revision", QVariant());
+    page->setProperty("_gm_url", QVariant());
+}
+
+// static
+void GM_Manager::removeWebScripts(QWebEngineScriptCollection* collection)
+{
+    const QString prefix = webScriptName(QString());
+    const QList<QWebEngineScript> scripts = collection->toList();
+
+    for (const QWebEngineScript &script : scripts) {
+        if (script.name().startsWith(prefix)) {
+            collection->remove(script);
+        }
+    }
 }
 
 bool GM_Manager::canRunOnScheme(const QString &scheme)
@@ -288,6 +466,11 @@ bool GM_Manager::canRunOnScheme(const QString &scheme)
             || scheme == QLatin1String("data") || scheme == QLatin1String("ftp"));
 }
 
+QString GM_Manager::webScriptName(const QString &name)
+{
+    return QSL("_falkon_gm_") + name;
+}
+
 void GM_Manager::mainWindowCreated(BrowserWindow* window)
 {
     GM_Icon *icon = new GM_Icon(this);
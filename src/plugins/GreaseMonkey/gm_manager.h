@@ -22,12 +22,17 @@
 #include <QStringList>
 #include <QPointer>
 #include <QHash>
+#include <QSet>
 
 class QUrl;
 class QWebFrame;
 
+class QWebEngineScriptCollection;
+
 class BrowserWindow;
+class WebPage;
 class GM_Script;
+class GM_Downloader;
 class GM_JSObject;
 class GM_Settings;
 class GM_Icon;
@@ -44,7 +49,10 @@ public:
 
     QString settingsPath() const;
     QString scriptsDirectory() const;
-    QString requireScripts(const QStringList &urlList) const;
+    QString requireScripts(const QStringList &urlList);
+    bool containsRequireScript(const QString &url);
+    // Returns downloader already in progress for url or starts a new one
+    GM_Downloader* downloadRequireScript(const QString &url);
     QString bootstrapScript() const;
     QString valuesScript() const;
 
@@ -61,7 +69,11 @@ public:
 
     void showNotification(const QString &message, const QString &title = QString());
 
+    // Injects scripts matching url into page, subframe scripts are added to the main frame ones
+    void updatePageScripts(WebPage* page, const QUrl &url, bool isMainFrame);
+
     static bool canRunOnScheme(const QString &scheme);
+    static QString webScriptName(const QString &name);
 
 Q_SIGNALS:
     void scriptsChanged();
@@ -69,12 +81,21 @@ Q_SIGNALS:
 public Q_SLOTS:
     void mainWindowCreated(BrowserWindow* window);
     void mainWindowDeleted(BrowserWindow* window);
+    void webPageCreated(WebPage* page);
 
 private Q_SLOTS:
     void load();
     void scriptChanged();
 
 private:
+    QString requireScript(const QString &url);
+    QString requireFileName(const QString &url);
+    void requireScriptDownloaded(const QString &url, const QString &fileName);
+
+    void scriptsUpdated();
+    void removePageScripts(WebPage* page);
+    static void removeWebScripts(QWebEngineScriptCollection* collection);
+
     QString m_settingsPath;
     QString m_bootstrapScript;
     QString m_valuesScript;
@@ -83,8 +104,18 @@ private:
     QStringList m_disabledScripts;
     GM_JSObject *m_jsObject;
     QList<GM_Script*> m_scripts;
+    // @require cache: url -> file, file -> content hash, content hash -> script
+    // Same library downloaded from different urls is kept only once
+    QHash<QString, QString> m_requireFiles;
+    QHash<QString, QByteArray> m_requireHashes;
+    QHash<QByteArray, QString> m_requireContents;
+    QHash<QString, GM_Downloader*> m_requireDownloads;
+
+    // Increased on every change, pages with older revision get their scripts reinjected
+    int m_scriptsRevision;
 
     QHash<BrowserWindow*, GM_Icon*> m_windows;
+    QSet<WebPage*> m_pages;
 };
 
 #endif // GM_MANAGER_H
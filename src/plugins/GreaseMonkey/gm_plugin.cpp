@@ -19,6 +19,7 @@
 #include "gm_manager.h"
 #include "browserwindow.h"
 #include "webpage.h"
+#include "webview.h"
 #include "pluginproxy.h"
 #include "mainapplication.h"
 #include "tabwidget.h"
@@ -26,6 +27,8 @@
 #include "../config.h"
 #include "desktopfile.h"
 
+#include <QApplication>
+
 GM_Plugin::GM_Plugin()
     : QObject()
     , m_manager(0)
@@ -43,12 +46,19 @@ void GM_Plugin::init(InitState state, const QString &settingsPath)
 
     connect(mApp->plugins(), &PluginProxy::mainWindowCreated, m_manager, &GM_Manager::mainWindowCreated);
     connect(mApp->plugins(), &PluginProxy::mainWindowDeleted, m_manager, &GM_Manager::mainWindowDeleted);
+    connect(mApp->plugins(), &PluginProxy::webPageCreated, m_manager, &GM_Manager::webPageCreated);
 
     // Make sure userscripts works also with already created WebPages
     if (state == LateInitState) {
         foreach (BrowserWindow *window, mApp->windows()) {
             m_manager->mainWindowCreated(window);
         }
+        // Pages of tabs and popup windows
+        foreach (QWidget *widget, QApplication::topLevelWidgets()) {
+            foreach (WebView *view, widget->findChildren<WebView*>()) {
+                m_manager->webPageCreated(view->page());
+            }
+        }
     }
 }
 
@@ -71,12 +81,10 @@ void GM_Plugin::showSettings(QWidget* parent)
 
 bool GM_Plugin::acceptNavigationRequest(WebPage *page, const QUrl &url, QWebEnginePage::NavigationType type, bool isMainFrame)
 {
-    Q_UNUSED(page)
-    Q_UNUSED(isMainFrame)
-
     if (type == QWebEnginePage::NavigationTypeLinkClicked && url.toString().endsWith(QLatin1String(".user.js"))) {
         m_manager->downloadScript(url);
         return false;
     }
+
     return true;
 }
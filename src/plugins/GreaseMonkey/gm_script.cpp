@@ -43,6 +43,7 @@ GM_Script::GM_Script(GM_Manager* manager, const QString &filePath)
     , m_enabled(true)
     , m_valid(false)
     , m_updating(false)
+    , m_requiresChanged(false)
 {
     parseScript();
 
@@ -139,13 +140,47 @@ QString GM_Script::fileName() const
     return m_fileName;
 }
 
+bool GM_Script::match(const QUrl &url, const QString &urlString) const
+{
+    if (!GM_Manager::canRunOnScheme(url.scheme())) {
+        return false;
+    }
+
+    for (const GM_UrlMatcher &matcher : m_excludeMatchers) {
+        if (matcher.match(url, urlString)) {
+            return false;
+        }
+    }
+
+    for (const GM_UrlMatcher &matcher : m_includeMatchers) {
+        if (matcher.match(url, urlString)) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
 QWebEngineScript GM_Script::webScript() const
 {
     QWebEngineScript script;
-    script.setSourceCode(QSL("%1\n%2").arg(m_manager->bootstrapScript(), m_script));
-    script.setName(fullName());
+    script.setSourceCode(m_script);
+    script.setName(GM_Manager::webScriptName(fullName()));
     script.setWorldId(WebPage::SafeJsWorld);
     script.setRunsOnSubFrames(!m_noframes);
+
+    switch (m_startAt) {
+    case DocumentStart:
+        script.setInjectionPoint(QWebEngineScript::DocumentCreation);
+        break;
+    case DocumentIdle:
+        script.setInjectionPoint(QWebEngineScript::Deferred);
+        break;
+    default:
+        script.setInjectionPoint(QWebEngineScript::DocumentReady);
+        break;
+    }
+
     return script;
 }
 
@@ -191,6 +226,8 @@ void GM_Script::parseScript()
     m_include.clear();
     m_exclude.clear();
     m_require.clear();
+    m_includeMatchers.clear();
+    m_excludeMatchers.clear();
     m_icon = QIcon();
     m_iconUrl.clear();
     m_downloadUrl.clear();
@@ -260,11 +297,21 @@ void GM_Script::parseScript()
         else if (key == QLatin1String("@downloadURL")) {
             m_downloadUrl = QUrl(value);
         }
-        else if (key == QLatin1String("@include") || key == QLatin1String("@match")) {
+        else if (key == QLatin1String("@include")) {
             m_include.append(value);
+            m_includeMatchers.append(GM_UrlMatcher(value));
         }
-        else if (key == QLatin1String("@exclude") || key == QLatin1String("@exclude_match")) {
+        else if (key == QLatin1String("@match")) {
+            m_include.append(value);
+            m_includeMatchers.append(GM_UrlMatcher(value, GM_UrlMatcher::MatchPattern));
+        }
+        else if (key == QLatin1String("@exclude")) {
+            m_exclude.append(value);
+            m_excludeMatchers.append(GM_UrlMatcher(value));
+        }
+        else if (key == QLatin1String("@exclude_match")) {
             m_exclude.append(value);
+            m_excludeMatchers.append(GM_UrlMatcher(value, GM_UrlMatcher::MatchPattern));
         }
         else if (key == QLatin1String("@require")) {
             m_require.append(value);
@@ -297,6 +344,7 @@ void GM_Script::parseScript()
 
     if (m_include.isEmpty()) {
         m_include.append(QSL("*"));
+        m_includeMatchers.append(GM_UrlMatcher(QSL("*")));
     }
 
     const QString nspace = QCryptographicHash::hash(fullName().toUtf8(), QCryptographicHash::Md4).toHex();
@@ -334,9 +382,29 @@ void GM_Script::downloadIcon()
 void GM_Script::downloadRequires()
 {
     for (const QString &url : qAsConst(m_require)) {
-        if (m_manager->requireScripts({url}).isEmpty()) {
-            GM_Downloader *downloader = new GM_Downloader(QUrl(url), m_manager, GM_Downloader::DownloadRequireScript);
-            connect(downloader, &GM_Downloader::finished, this, &GM_Script::reloadScript);
+        if (m_pendingRequires.contains(url) || m_manager->containsRequireScript(url)) {
+            continue;
         }
+
+        GM_Downloader *downloader = m_manager->downloadRequireScript(url);
+        m_pendingRequires.insert(url);
+
+        connect(downloader, &GM_Downloader::finished, this, [=]() {
+            requireDownloaded(url, true);
+        });
+        connect(downloader, &GM_Downloader::error, this, [=]() {
+            requireDownloaded(url, false);
+        });
+    }
+}
+
+void GM_Script::requireDownloaded(const QString &url, bool success)
+{
+    m_pendingRequires.remove(url);
+    m_requiresChanged |= success;
+
+    if (m_pendingRequires.isEmpty() && m_requiresChanged) {
+        m_requiresChanged = false;
+        reloadScript();
     }
 }
@@ -21,6 +21,10 @@
 #include <QObject>
 #include <QIcon>
 #include <QUrl>
+#include <QVector>
+#include <QSet>
+
+#include "gm_urlmatcher.h"
 
 class QWebEngineScript;
 
@@ -63,6 +67,9 @@ public:
     QString metaData() const;
     QString fileName() const;
 
+    // Whether script should be injected into page with url, urlString is url.toString()
+    bool match(const QUrl &url, const QString &urlString) const;
+
     QWebEngineScript webScript() const;
 
     bool isUpdating();
@@ -80,6 +87,7 @@ private:
     void reloadScript();
     void downloadIcon();
     void downloadRequires();
+    void requireDownloaded(const QString &url, bool success);
 
     GM_Manager* m_manager;
     DelayedFileWatcher* m_fileWatcher;
@@ -92,6 +100,8 @@ private:
     QStringList m_include;
     QStringList m_exclude;
     QStringList m_require;
+    QVector<GM_UrlMatcher> m_includeMatchers;
+    QVector<GM_UrlMatcher> m_excludeMatchers;
 
     QIcon m_icon;
     QUrl m_iconUrl;
@@ -105,6 +115,10 @@ private:
     bool m_enabled;
     bool m_valid;
     bool m_updating;
+
+    // Script is reloaded only once after all pending requires are downloaded
+    QSet<QString> m_pendingRequires;
+    bool m_requiresChanged;
 };
 
 #endif // GM_SCRIPT_H
@@ -0,0 +1,192 @@
+/* ============================================================
+* GreaseMonkey plugin for Falkon
+* Copyright (C) 2013-2018 David Rosca <nowrep@gmail.com>
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program.  If not, see <http://www.gnu.org/licenses/>.
+* ============================================================ */
+#include "gm_urlmatcher.h"
+
+#include <QUrl>
+#include <QDebug>
+
+GM_UrlMatcher::GM_UrlMatcher()
+    : m_type(IncludePattern)
+    , m_matchSubdomains(false)
+    , m_allUrls(false)
+{
+}
+
+GM_UrlMatcher::GM_UrlMatcher(const QString &pattern, PatternType type)
+    : m_pattern(pattern)
+    , m_type(type)
+    , m_matchSubdomains(false)
+    , m_allUrls(false)
+{
+    if (m_type == MatchPattern) {
+        parseMatchPattern(pattern);
+    }
+    else {
+        m_glob = compileGlob(pattern, true);
+    }
+}
+
+QString GM_UrlMatcher::pattern() const
+{
+    return m_pattern;
+}
+
+bool GM_UrlMatcher::match(const QUrl &url, const QString &urlString) const
+{
+    if (m_type == IncludePattern) {
+        return m_glob.match(urlString);
+    }
+
+    if (m_allUrls) {
+        return true;
+    }
+
+    if (m_glob.type == MatchNothing) {
+        return false;
+    }
+
+    const QString scheme = url.scheme();
+
+    if (m_scheme.isEmpty()) {
+        // *:// matches only http and https
+        if (scheme != QLatin1String("http") && scheme != QLatin1String("https")) {
+            return false;
+        }
+    }
+    else if (scheme != m_scheme) {
+        return false;
+    }
+
+    if (!m_host.isEmpty()) {
+        const QString host = url.host();
+        if (host != m_host && !(m_matchSubdomains && host.endsWith(m_host) && host.at(host.size() - m_host.size() - 1) == QLatin1Char('.'))) {
+            return false;
+        }
+    }
+
+    QString path = url.path(QUrl::FullyEncoded);
+    if (url.hasQuery()) {
+        path += QLatin1Char('?') + url.query(QUrl::FullyEncoded);
+    }
+
+    return m_glob.match(path);
+}
+
+bool GM_UrlMatcher::Glob::match(const QString &str) const
+{
+    switch (type) {
+    case MatchAll:
+        return true;
+
+    case MatchExact:
+        return str.compare(string, Qt::CaseInsensitive) == 0;
+
+    case MatchPrefix:
+        return str.startsWith(string, Qt::CaseInsensitive);
+
+    case MatchRegExp:
+        return regExp.match(str).hasMatch();
+
+    default:
+        return false;
+    }
+}
+
+// static
+GM_UrlMatcher::Glob GM_UrlMatcher::compileGlob(const QString &pattern, bool allowRegExp)
+{
+    Glob glob;
+
+    if (pattern.isEmpty()) {
+        return glob;
+    }
+
+    if (pattern == QLatin1String("*")) {
+        glob.type = MatchAll;
+        return glob;
+    }
+
+    if (allowRegExp && pattern.size() > 2 && pattern.startsWith(QLatin1Char('/')) && pattern.endsWith(QLatin1Char('/'))) {
+        glob.type = MatchRegExp;
+        glob.regExp = QRegularExpression(pattern.mid(1, pattern.size() - 2), QRegularExpression::CaseInsensitiveOption);
+    }
+    else {
+        const int wildcards = pattern.count(QLatin1Char('*'));
+        const bool hasTld = pattern.contains(QLatin1String(".tld/"));
+
+        if (wildcards == 0 && !hasTld) {
+            glob.type = MatchExact;
+            glob.string = pattern;
+            return glob;
+        }
+
+        if (wildcards == 1 && pattern.endsWith(QLatin1Char('*')) && !hasTld) {
+            glob.type = MatchPrefix;
+            glob.string = pattern.left(pattern.size() - 1);
+            return glob;
+        }
+
+        QString regExp = QRegularExpression::escape(pattern);
+        regExp.replace(QLatin1String("\\*"), QLatin1String(".*"));
+        regExp.replace(QLatin1String("\\.tld\\/"), QLatin1String("\\.[a-z.]{2,6}\\/"));
+
+        glob.type = MatchRegExp;
+        glob.regExp = QRegularExpression(QLatin1Char('^') + regExp + QLatin1Char('$'), QRegularExpression::CaseInsensitiveOption);
+    }
+
+    if (!glob.regExp.isValid()) {
+        qWarning() << "GreaseMonkey: Invalid pattern" << pattern << glob.regExp.errorString();
+        glob.type = MatchNothing;
+        return glob;
+    }
+
+    glob.regExp.optimize();
+    return glob;
+}
+
+void GM_UrlMatcher::parseMatchPattern(const QString &pattern)
+{
+    if (pattern == QLatin1String("<all_urls>")) {
+        m_allUrls = true;
+        return;
+    }
+
+    static const QRegularExpression rx(QStringLiteral("^(\\*|[a-z][a-z0-9+.-]*)://(\\*|\\*\\.[^/*]+|[^/*]*)(/.*)$"));
+    const QRegularExpressionMatch match = rx.match(pattern);
+    if (!match.hasMatch()) {
+        qWarning() << "GreaseMonkey: Invalid @match pattern" << pattern;
+        return;
+    }
+
+    const QString scheme = match.captured(1);
+    const QString host = match.captured(2).toLower();
+
+    if (scheme != QLatin1String("*")) {
+        m_scheme = scheme;
+    }
+
+    if (host.startsWith(QLatin1String("*."))) {
+        m_host = host.mid(2);
+        m_matchSubdomains = true;
+    }
+    else if (host != QLatin1String("*")) {
+        m_host = host;
+    }
+
+    m_glob = compileGlob(match.captured(3), false);
+}
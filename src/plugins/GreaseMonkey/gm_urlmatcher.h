@@ -0,0 +1,77 @@
+/* ============================================================
+* GreaseMonkey plugin for Falkon
+* Copyright (C) 2013-2018 David Rosca <nowrep@gmail.com>
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program.  If not, see <http://www.gnu.org/licenses/>.
+* ============================================================ */
+#ifndef GM_URLMATCHER_H
+#define GM_URLMATCHER_H
+
+#include <QString>
+#include <QRegularExpression>
+
+class QUrl;
+
+// Compiled @include, @exclude or @match pattern
+class GM_UrlMatcher
+{
+public:
+    enum PatternType {
+        IncludePattern, // @include and @exclude: glob, /regexp/ or .tld
+        MatchPattern    // @match: <scheme>://<host><path>
+    };
+
+    explicit GM_UrlMatcher();
+    explicit GM_UrlMatcher(const QString &pattern, PatternType type = IncludePattern);
+
+    QString pattern() const;
+
+    // urlString is url.toString(), passed in so it is only created once for all scripts
+    bool match(const QUrl &url, const QString &urlString) const;
+
+private:
+    enum MatchType {
+        MatchNothing,
+        MatchAll,
+        MatchExact,
+        MatchPrefix,
+        MatchRegExp
+    };
+
+    struct Glob {
+        MatchType type = MatchNothing;
+        QString string;
+        QRegularExpression regExp;
+
+        bool match(const QString &string) const;
+    };
+
+    static Glob compileGlob(const QString &pattern, bool allowRegExp);
+
+    void parseMatchPattern(const QString &pattern);
+
+    QString m_pattern;
+    PatternType m_type;
+
+    // IncludePattern: whole url, MatchPattern: path and query
+    Glob m_glob;
+
+    // MatchPattern only
+    QString m_scheme;
+    QString m_host;
+    bool m_matchSubdomains;
+    bool m_allUrls;
+};
+
+#endif // GM_URLMATCHER_H
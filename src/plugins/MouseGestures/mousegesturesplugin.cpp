@@ -40,9 +40,11 @@ void MouseGesturesPlugin::init(InitState state, const QString &settingsPath)
 
     m_gestures = new MouseGestures(settingsPath, this);
 
-    mApp->plugins()->registerAppEventHandler(PluginProxy::MousePressHandler, this);
-    mApp->plugins()->registerAppEventHandler(PluginProxy::MouseReleaseHandler, this);
-    mApp->plugins()->registerAppEventHandler(PluginProxy::MouseMoveHandler, this);
+    PluginProxy::HandlerFilter filter;
+    filter.objects = {Qz::ON_WebView};
+    mApp->plugins()->registerAppEventHandler(PluginProxy::MousePressHandler, this, filter);
+    mApp->plugins()->registerAppEventHandler(PluginProxy::MouseReleaseHandler, this, filter);
+    mApp->plugins()->registerAppEventHandler(PluginProxy::MouseMoveHandler, this, filter);
 }
 
 void MouseGesturesPlugin::unload()
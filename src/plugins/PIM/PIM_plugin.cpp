@@ -43,7 +43,9 @@ void PIM_Plugin::init(InitState state, const QString &settingsPath)
 
     m_handler = new PIM_Handler(settingsPath, this);
 
-    mApp->plugins()->registerAppEventHandler(PluginProxy::KeyPressHandler, this);
+    PluginProxy::HandlerFilter filter;
+    filter.objects = {Qz::ON_WebView};
+    mApp->plugins()->registerAppEventHandler(PluginProxy::KeyPressHandler, this, filter);
 
     connect(mApp->plugins(), SIGNAL(webPageCreated(WebPage*)), m_handler, SLOT(webPageCreated(WebPage*)));
 }
@@ -52,11 +52,12 @@
 #include "cookiemanager.h"
 
 // downloads
-#include "downloaditem.h"
 #include "downloadmanager.h"
+#include "downloadsmodel.h"
 
 // history
 #include "history.h"
+#include "historydeletejob.h"
 #include "historyitem.h"
 #include "historymodel.h"
 
@@ -58,8 +58,6 @@ void TabManagerPlugin::init(InitState state, const QString &settingsPath)
     m_controller = new TabManagerWidgetController(this);
     connect(mApp->plugins(), SIGNAL(mainWindowCreated(BrowserWindow*)), this, SLOT(mainWindowCreated(BrowserWindow*)));
     connect(mApp->plugins(), SIGNAL(mainWindowDeleted(BrowserWindow*)), m_controller, SLOT(mainWindowDeleted(BrowserWindow*)));
-    connect(mApp->plugins(), SIGNAL(webPageCreated(WebPage*)), m_controller, SIGNAL(requestRefreshTree()));
-    connect(mApp->plugins(), SIGNAL(webPageDeleted(WebPage*)), m_controller, SIGNAL(requestRefreshTree(WebPage*)));
 
     s_settingsPath = settingsPath + QL1S("/TabManager");
     m_initState = true;
@@ -135,9 +133,6 @@ void TabManagerPlugin::mainWindowCreated(BrowserWindow* window, bool refresh)
         if (m_viewType == ShowAsWindow) {
             m_controller->addStatusBarIcon(window);
         }
-
-        connect(window->tabWidget(), SIGNAL(currentChanged(int)), m_controller, SIGNAL(requestRefreshTree()));
-        connect(window->tabWidget(), SIGNAL(pinStateChanged(int,bool)), m_controller, SIGNAL(requestRefreshTree()));
     }
 
     if (refresh) {
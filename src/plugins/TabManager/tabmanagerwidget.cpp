@@ -33,6 +33,7 @@
 #include "tabmanagerdelegate.h"
 #include "tabcontextmenu.h"
 #include "tabbar.h"
+#include "tabmodel.h"
 
 #include <QDesktopWidget>
 #include <QDialogButtonBox>
@@ -49,7 +50,6 @@ TabManagerWidget::TabManagerWidget(BrowserWindow* mainClass, QWidget* parent, bo
     : QWidget(parent)
     , ui(new Ui::TabManagerWidget)
     , m_window(mainClass)
-    , m_webPage(0)
     , m_isRefreshing(false)
     , m_refreshBlocked(false)
     , m_waitForRefresh(false)
@@ -89,7 +89,6 @@ TabManagerWidget::TabManagerWidget(BrowserWindow* mainClass, QWidget* parent, bo
     connect(ui->filterBar, SIGNAL(textChanged(QString)), this, SLOT(filterChanged(QString)));
     connect(ui->treeWidget, &QTreeWidget::itemClicked, this, &TabManagerWidget::onItemActivated);
     connect(ui->treeWidget, SIGNAL(customContextMenuRequested(QPoint)), this, SLOT(customContextMenuRequested(QPoint)));
-    connect(ui->treeWidget, SIGNAL(requestRefreshTree()), this, SLOT(delayedRefreshTree()));
 }
 
 TabManagerWidget::~TabManagerWidget()
@@ -142,55 +141,51 @@ QString TabManagerWidget::domainFromUrl(const QUrl &url, bool useHostName)
 
 void TabManagerWidget::delayedRefreshTree(WebPage* p)
 {
-    if (m_refreshBlocked || m_waitForRefresh) {
+    // Tab changes are applied incrementally from TabModel signals, a full
+    // rebuild is only needed when windows or the grouping change
+    Q_UNUSED(p)
+
+    if (m_refreshBlocked) {
+        // rebuild is scheduled by processActions() once it unblocks refresh
+        m_waitForRefresh = true;
         return;
     }
 
-    if (m_isRefreshing && !p) {
+    if (m_waitForRefresh) {
         return;
     }
 
-    m_webPage = p;
     m_waitForRefresh = true;
     QTimer::singleShot(50, this, &TabManagerWidget::refreshTree);
 }
 
 void TabManagerWidget::refreshTree()
 {
-    if (m_refreshBlocked) {
+    if (m_refreshBlocked || m_isRefreshing) {
         return;
     }
 
-    if (m_isRefreshing && !m_webPage) {
-        return;
-    }
+    m_isRefreshing = true;
 
     // store selected items
-    QList<QWidget*> selectedTabs;
-    for (int i = 0; i < ui->treeWidget->topLevelItemCount(); ++i) {
-        QTreeWidgetItem* winItem = ui->treeWidget->topLevelItem(i);
-        if (winItem->checkState(0) == Qt::Unchecked) {
-            continue;
-        }
-
-        for (int j = 0; j < winItem->childCount(); ++j) {
-            TabItem* tabItem = static_cast<TabItem*>(winItem->child(j));
-            if (!tabItem || tabItem->checkState(0) == Qt::Unchecked) {
-                continue;
-            }
-            selectedTabs << tabItem->webTab();
+    QSet<WebTab*> selectedTabs;
+    for (auto it = m_tabItems.constBegin(); it != m_tabItems.constEnd(); ++it) {
+        if (it.value()->checkState(0) == Qt::Checked) {
+            selectedTabs.insert(it.key());
         }
     }
 
     ui->treeWidget->clear();
+    m_tabItems.clear();
+    m_windowItems.clear();
+    m_domainItems.clear();
+    m_groupKeys.clear();
+
     ui->treeWidget->setEnableDragTabs(m_groupType == GroupByWindow);
 
     QTreeWidgetItem* currentTabItem = nullptr;
 
-    if (m_groupType == GroupByHost) {
-        currentTabItem = groupByDomainName(true);
-    }
-    else if (m_groupType == GroupByDomain) {
+    if (m_groupType == GroupByHost || m_groupType == GroupByDomain) {
         currentTabItem = groupByDomainName();
     }
     else { // fallback to GroupByWindow
@@ -199,15 +194,10 @@ void TabManagerWidget::refreshTree()
     }
 
     // restore selected items
-    for (int i = 0; i < ui->treeWidget->topLevelItemCount(); ++i) {
-        QTreeWidgetItem* winItem = ui->treeWidget->topLevelItem(i);
-
-        for (int j = 0; j < winItem->childCount(); ++j) {
-            TabItem* tabItem = static_cast<TabItem*>(winItem->child(j));
-
-            if (tabItem && selectedTabs.contains(tabItem->webTab())) {
-                tabItem->setCheckState(0, Qt::Checked);
-            }
+    foreach (WebTab* webTab, selectedTabs) {
+        TabItem* tabItem = m_tabItems.value(webTab);
+        if (tabItem) {
+            tabItem->setCheckState(0, Qt::Checked);
         }
     }
 
@@ -221,6 +211,336 @@ void TabManagerWidget::refreshTree()
     m_waitForRefresh = false;
 }
 
+bool TabManagerWidget::isUpdatingIncrementally() const
+{
+    // pending full rebuild will pick up all changes anyway
+    return !m_waitForRefresh && !m_isRefreshing;
+}
+
+void TabManagerWidget::connectTabModel(BrowserWindow* window)
+{
+    TabModel* model = window->tabModel();
+    if (!model || m_tabModels.contains(model)) {
+        return;
+    }
+
+    m_tabModels.insert(model);
+
+    connect(model, &TabModel::rowsInserted, this, [=](const QModelIndex &, int first, int last) {
+        tabsInserted(window, first, last);
+    });
+    connect(model, &TabModel::rowsAboutToBeRemoved, this, [=](const QModelIndex &, int first, int last) {
+        tabsAboutToBeRemoved(window, first, last);
+    });
+    connect(model, &TabModel::rowsMoved, this, [=](const QModelIndex &, int start, int, const QModelIndex &, int row) {
+        tabMoved(window, row > start ? row - 1 : row);
+    });
+    connect(model, &TabModel::dataChanged, this, [=](const QModelIndex &topLeft, const QModelIndex &bottomRight, const QVector<int> &roles) {
+        tabsDataChanged(window, topLeft.row(), bottomRight.row(), roles);
+    });
+    connect(model, &TabModel::modelAboutToBeReset, this, [=]() {
+        removeWindowItems(window);
+    });
+    connect(model, &QObject::destroyed, this, [=]() {
+        m_tabModels.remove(model);
+        removeWindowItems(window);
+    });
+}
+
+void TabManagerWidget::tabsInserted(BrowserWindow* window, int first, int last)
+{
+    if (!isUpdatingIncrementally()) {
+        return;
+    }
+
+    TabModel* model = window->tabModel();
+
+    for (int row = first; row <= last; ++row) {
+        WebTab* webTab = model->tab(model->index(row));
+        if (!webTab) {
+            continue;
+        }
+
+        // tab detached from another window that was not yet removed there
+        if (TabItem* oldItem = m_tabItems.value(webTab)) {
+            removeTabItem(oldItem);
+        }
+
+        TabItem* tabItem = addTabItem(window, webTab, row);
+        if (!tabItem) {
+            // window is not in the tree yet
+            delayedRefreshTree();
+            return;
+        }
+
+        updateItemVisibility(tabItem);
+    }
+}
+
+void TabManagerWidget::tabsAboutToBeRemoved(BrowserWindow* window, int first, int last)
+{
+    if (!isUpdatingIncrementally()) {
+        return;
+    }
+
+    TabModel* model = window->tabModel();
+
+    for (int row = first; row <= last; ++row) {
+        TabItem* tabItem = m_tabItems.value(model->tab(model->index(row)));
+        if (tabItem && tabItem->window() == window) {
+            removeTabItem(tabItem);
+        }
+    }
+}
+
+void TabManagerWidget::tabMoved(BrowserWindow* window, int row)
+{
+    // domain groups are not ordered by tab position
+    if (!isUpdatingIncrementally() || m_groupType != GroupByWindow) {
+        return;
+    }
+
+    TabModel* model = window->tabModel();
+    TabItem* tabItem = m_tabItems.value(model->tab(model->index(row)));
+    QTreeWidgetItem* windowItem = tabItem ? tabItem->parent() : nullptr;
+    if (!windowItem) {
+        return;
+    }
+
+    windowItem->takeChild(windowItem->indexOfChild(tabItem));
+    windowItem->insertChild(qBound(0, row, windowItem->childCount()), tabItem);
+}
+
+void TabManagerWidget::tabsDataChanged(BrowserWindow* window, int first, int last, const QVector<int> &roles)
+{
+    if (!isUpdatingIncrementally()) {
+        return;
+    }
+
+    const bool titleChanged = roles.isEmpty() || roles.contains(TabModel::TitleRole);
+    const bool stateChanged = roles.isEmpty()
+            || roles.contains(TabModel::IconRole)
+            || roles.contains(TabModel::PinnedRole)
+            || roles.contains(TabModel::RestoredRole)
+            || roles.contains(TabModel::CurrentTabRole)
+            || roles.contains(TabModel::LoadingRole)
+            || roles.contains(TabModel::AudioPlayingRole)
+            || roles.contains(TabModel::AudioMutedRole);
+
+    // Qt::DisplayRole and Qt::DecorationRole changes are always paired with
+    // TitleRole and IconRole
+    if (!titleChanged && !stateChanged) {
+        return;
+    }
+
+    TabModel* model = window->tabModel();
+
+    for (int row = first; row <= last; ++row) {
+        WebTab* webTab = model->tab(model->index(row));
+        TabItem* tabItem = m_tabItems.value(webTab);
+        if (!tabItem) {
+            continue;
+        }
+
+        if (titleChanged) {
+            tabItem->setTitle(webTab->title());
+            updateItemVisibility(tabItem);
+        }
+
+        if (stateChanged) {
+            tabItem->updateIcon();
+
+            if (roles.contains(TabModel::CurrentTabRole) && webTab->isCurrentTab() && window == getWindow()) {
+                ui->treeWidget->scrollToItem(tabItem, QAbstractItemView::EnsureVisible);
+            }
+        }
+    }
+}
+
+void TabManagerWidget::tabUrlChanged(WebTab* webTab)
+{
+    if (!isUpdatingIncrementally() || m_groupType == GroupByWindow) {
+        return;
+    }
+
+    TabItem* tabItem = m_tabItems.value(webTab);
+    if (!tabItem) {
+        return;
+    }
+
+    const QString domain = domainFromUrl(webTab->url(), m_groupType == GroupByHost);
+    if (m_groupKeys.value(webTab) == domain) {
+        updateItemVisibility(tabItem);
+        return;
+    }
+
+    QTreeWidgetItem* oldGroupItem = tabItem->parent();
+    if (oldGroupItem) {
+        oldGroupItem->removeChild(tabItem);
+
+        if (oldGroupItem->childCount() == 0) {
+            m_domainItems.remove(m_groupKeys.value(webTab));
+            delete oldGroupItem;
+        }
+        else {
+            updateGroupVisibility(oldGroupItem);
+        }
+    }
+
+    m_groupKeys.insert(webTab, domain);
+    domainGroupItem(domain)->addChild(tabItem);
+    updateItemVisibility(tabItem);
+}
+
+void TabManagerWidget::removeWindowItems(BrowserWindow* window)
+{
+    if (TabItem* windowItem = m_windowItems.take(window)) {
+        for (int i = 0; i < windowItem->childCount(); ++i) {
+            TabItem* tabItem = static_cast<TabItem*>(windowItem->child(i));
+            m_tabItems.remove(tabItem->webTab());
+            m_groupKeys.remove(tabItem->webTab());
+        }
+        delete windowItem;
+    }
+    else {
+        QList<TabItem*> tabItems;
+        foreach (TabItem* tabItem, m_tabItems) {
+            if (tabItem->window() == window) {
+                tabItems.append(tabItem);
+            }
+        }
+        foreach (TabItem* tabItem, tabItems) {
+            removeTabItem(tabItem);
+        }
+    }
+
+    // window numbers have to be updated
+    delayedRefreshTree();
+}
+
+TabItem* TabManagerWidget::addTabItem(BrowserWindow* window, WebTab* webTab, int index)
+{
+    QTreeWidgetItem* parentItem = nullptr;
+
+    if (m_groupType == GroupByWindow) {
+        parentItem = m_windowItems.value(window);
+    }
+    else {
+        const QString domain = domainFromUrl(webTab->url(), m_groupType == GroupByHost);
+        m_groupKeys.insert(webTab, domain);
+        parentItem = domainGroupItem(domain);
+    }
+
+    if (!parentItem) {
+        return nullptr;
+    }
+
+    TabItem* tabItem = new TabItem(ui->treeWidget, m_groupType == GroupByWindow, true, parentItem, false);
+    tabItem->setBrowserWindow(window);
+    tabItem->setWebTab(webTab);
+    tabItem->updateIcon();
+    tabItem->setTitle(webTab->title());
+
+    if (m_groupType == GroupByWindow) {
+        parentItem->insertChild(qBound(0, index, parentItem->childCount()), tabItem);
+    }
+    else {
+        parentItem->addChild(tabItem);
+        connect(webTab->webView(), &QWebEngineView::urlChanged, tabItem, [=]() {
+            tabUrlChanged(webTab);
+        });
+    }
+
+    m_tabItems.insert(webTab, tabItem);
+
+    return tabItem;
+}
+
+void TabManagerWidget::removeTabItem(TabItem* tabItem)
+{
+    QTreeWidgetItem* parentItem = tabItem->parent();
+
+    m_tabItems.remove(tabItem->webTab());
+    const QString domain = m_groupKeys.take(tabItem->webTab());
+    delete tabItem;
+
+    if (!parentItem) {
+        return;
+    }
+
+    if (m_groupType != GroupByWindow && parentItem->childCount() == 0) {
+        m_domainItems.remove(domain);
+        delete parentItem;
+    }
+    else {
+        updateGroupVisibility(parentItem);
+    }
+}
+
+QTreeWidgetItem* TabManagerWidget::domainGroupItem(const QString &domain)
+{
+    TabItem* groupItem = m_domainItems.value(domain);
+    if (groupItem) {
+        return groupItem;
+    }
+
+    groupItem = new TabItem(ui->treeWidget, false, false, 0, false);
+    groupItem->setTitle(domain);
+    groupItem->setIsActiveOrCaption(true);
+
+    // keep groups sorted by name
+    int low = 0;
+    int high = ui->treeWidget->topLevelItemCount();
+    while (low < high) {
+        const int mid = (low + high) / 2;
+        if (ui->treeWidget->topLevelItem(mid)->text(0) < domain) {
+            low = mid + 1;
+        }
+        else {
+            high = mid;
+        }
+    }
+
+    ui->treeWidget->insertTopLevelItem(low, groupItem);
+    groupItem->setExpanded(true);
+    m_domainItems.insert(domain, groupItem);
+
+    return groupItem;
+}
+
+bool TabManagerWidget::matchesFilter(TabItem* tabItem) const
+{
+    if (m_filterText.isEmpty()) {
+        return true;
+    }
+
+    return tabItem->text(0).contains(m_filterRegExp) || tabItem->webTab()->url().toString().simplified().contains(m_filterRegExp);
+}
+
+void TabManagerWidget::updateItemVisibility(TabItem* tabItem)
+{
+    tabItem->setHidden(!matchesFilter(tabItem));
+
+    if (tabItem->parent()) {
+        updateGroupVisibility(tabItem->parent());
+    }
+}
+
+void TabManagerWidget::updateGroupVisibility(QTreeWidgetItem* groupItem)
+{
+    bool visible = m_filterText.isEmpty();
+
+    for (int i = 0; !visible && i < groupItem->childCount(); ++i) {
+        visible = !groupItem->child(i)->isHidden();
+    }
+
+    groupItem->setHidden(!visible);
+
+    if (visible && !m_filterText.isEmpty()) {
+        groupItem->setExpanded(true);
+    }
+}
+
 void TabManagerWidget::onItemActivated(QTreeWidgetItem* item, int column)
 {
     TabItem* tabItem = static_cast<TabItem*>(item);
@@ -342,47 +662,23 @@ void TabManagerWidget::filterChanged(const QString &filter, bool force)
     if (force || filter != m_filterText) {
         m_filterText = filter.simplified();
         ui->treeWidget->itemDelegate()->setProperty("filterText", m_filterText);
-        if (m_filterText.isEmpty()) {
-            for (int i = 0; i < ui->treeWidget->topLevelItemCount(); ++i) {
-                QTreeWidgetItem* parentItem = ui->treeWidget->topLevelItem(i);
-                for (int j = 0; j < parentItem->childCount(); ++j) {
-                    QTreeWidgetItem* childItem = parentItem->child(j);
-                    childItem->setHidden(false);
-                }
-                parentItem->setHidden(false);
-                parentItem->setExpanded(true);
-            }
 
-            return;
+        if (!m_filterText.isEmpty()) {
+            m_filterRegExp = QRegularExpression(filter.simplified().replace(QChar(' '), QLatin1String(".*"))
+                                                .append(QLatin1String(".*")).prepend(QLatin1String(".*")),
+                                                QRegularExpression::CaseInsensitiveOption);
         }
 
-        const QRegularExpression filterRegExp(filter.simplified().replace(QChar(' '), QLatin1String(".*"))
-                                              .append(QLatin1String(".*")).prepend(QLatin1String(".*")),
-                                              QRegularExpression::CaseInsensitiveOption);
-
         for (int i = 0; i < ui->treeWidget->topLevelItemCount(); ++i) {
             QTreeWidgetItem* parentItem = ui->treeWidget->topLevelItem(i);
-            int visibleChildCount = 0;
             for (int j = 0; j < parentItem->childCount(); ++j) {
                 TabItem* childItem = static_cast<TabItem*>(parentItem->child(j));
-                if (!childItem) {
-                    continue;
-                }
-
-                if (childItem->text(0).contains(filterRegExp) || childItem->webTab()->url().toString().simplified().contains(filterRegExp)) {
-                    ++visibleChildCount;
-                    childItem->setHidden(false);
-                }
-                else {
-                    childItem->setHidden(true);
-                }
+                childItem->setHidden(!matchesFilter(childItem));
             }
 
-            if (visibleChildCount == 0) {
-                parentItem->setHidden(true);
-            }
-            else {
-                parentItem->setHidden(false);
+            updateGroupVisibility(parentItem);
+
+            if (m_filterText.isEmpty()) {
                 parentItem->setExpanded(true);
             }
         }
@@ -498,7 +794,12 @@ void TabManagerWidget::processActions()
     }
 
     m_refreshBlocked = false;
-    delayedRefreshTree();
+
+    // rebuild requested while the actions were running
+    if (m_waitForRefresh) {
+        m_waitForRefresh = false;
+        delayedRefreshTree();
+    }
 }
 
 void TabManagerWidget::changeGroupType()
@@ -624,7 +925,7 @@ void TabManagerWidget::unloadSelectedTabs(const QHash<BrowserWindow*, WebTab*> &
     }
 }
 
-QTreeWidgetItem* TabManagerWidget::groupByDomainName(bool useHostName)
+QTreeWidgetItem* TabManagerWidget::groupByDomainName()
 {
     QTreeWidgetItem* currentTabItem = nullptr;
 
@@ -635,50 +936,22 @@ QTreeWidgetItem* TabManagerWidget::groupByDomainName(bool useHostName)
         return nullptr;
     }
 
-    QMap<QString, QTreeWidgetItem*> tabsGroupedByDomain;
-
     for (int win = 0; win < windows.count(); ++win) {
         BrowserWindow* mainWin = windows.at(win);
+        connectTabModel(mainWin);
 
-        QList<WebTab*> tabs = mainWin->tabWidget()->allTabs();
-
-        for (int tab = 0; tab < tabs.count(); ++tab) {
-            WebTab* webTab = tabs.at(tab);
-            if (webTab->webView() && m_webPage == webTab->webView()->page()) {
-                m_webPage = 0;
-                continue;
-            }
-            QString domain = domainFromUrl(webTab->url(), useHostName);
-
-            if (!tabsGroupedByDomain.contains(domain)) {
-                TabItem* groupItem = new TabItem(ui->treeWidget, false, false, 0, false);
-                groupItem->setTitle(domain);
-                groupItem->setIsActiveOrCaption(true);
-
-                tabsGroupedByDomain.insert(domain, groupItem);
-            }
-
-            QTreeWidgetItem* groupItem = tabsGroupedByDomain.value(domain);
-
-            TabItem* tabItem = new TabItem(ui->treeWidget, false, true, groupItem);
-            tabItem->setBrowserWindow(mainWin);
-            tabItem->setWebTab(webTab);
+        TabModel* model = mainWin->tabModel();
 
-            if (webTab == mainWin->weView()->webTab()) {
-                tabItem->setIsActiveOrCaption(true);
+        for (int row = 0; row < model->rowCount(); ++row) {
+            WebTab* webTab = model->tab(model->index(row));
+            TabItem* tabItem = addTabItem(mainWin, webTab, row);
 
-                if (mainWin == getWindow())
-                    currentTabItem = tabItem;
+            if (webTab == mainWin->weView()->webTab() && mainWin == getWindow()) {
+                currentTabItem = tabItem;
             }
-
-
-            tabItem->updateIcon();
-            tabItem->setTitle(webTab->title());
         }
     }
 
-    ui->treeWidget->insertTopLevelItems(0, tabsGroupedByDomain.values());
-
     return currentTabItem;
 }
 
@@ -691,7 +964,6 @@ QTreeWidgetItem* TabManagerWidget::groupByWindow()
     if (currentWindowIdx == -1) {
         return nullptr;
     }
-    m_isRefreshing = true;
 
     if (!m_isDefaultWidget) {
         windows.move(currentWindowIdx, 0);
@@ -706,27 +978,18 @@ QTreeWidgetItem* TabManagerWidget::groupByWindow()
         winItem->setToolTip(0, tr("Double click to switch"));
         winItem->setIsActiveOrCaption(win == currentWindowIdx);
 
-        QList<WebTab*> tabs = mainWin->tabWidget()->allTabs();
+        m_windowItems.insert(mainWin, winItem);
+        connectTabModel(mainWin);
 
-        for (int tab = 0; tab < tabs.count(); ++tab) {
-            WebTab* webTab = tabs.at(tab);
-            if (webTab->webView() && m_webPage == webTab->webView()->page()) {
-                m_webPage = 0;
-                continue;
-            }
-            TabItem* tabItem = new TabItem(ui->treeWidget, true, true, winItem);
-            tabItem->setBrowserWindow(mainWin);
-            tabItem->setWebTab(webTab);
+        TabModel* model = mainWin->tabModel();
 
-            if (webTab == mainWin->weView()->webTab()) {
-                tabItem->setIsActiveOrCaption(true);
+        for (int row = 0; row < model->rowCount(); ++row) {
+            WebTab* webTab = model->tab(model->index(row));
+            TabItem* tabItem = addTabItem(mainWin, webTab, row);
 
-                if (mainWin == getWindow())
-                    currentTabItem = tabItem;
+            if (webTab == mainWin->weView()->webTab() && mainWin == getWindow()) {
+                currentTabItem = tabItem;
             }
-
-            tabItem->updateIcon();
-            tabItem->setTitle(webTab->title());
         }
     }
 
@@ -793,16 +1056,6 @@ void TabItem::setWebTab(WebTab* webTab)
     else
         setIsSavedTab(true);
 
-    connect(m_webTab->webView(), &QWebEngineView::titleChanged, this, &TabItem::setTitle);
-    connect(m_webTab->webView(), &QWebEngineView::iconChanged, this, &TabItem::updateIcon);
-
-    auto pageChanged = [this](WebPage *page) {
-        connect(page, &WebPage::audioMutedChanged, this, &TabItem::updateIcon);
-        connect(page, &WebPage::loadFinished, this, &TabItem::updateIcon);
-        connect(page, &WebPage::loadStarted, this, &TabItem::updateIcon);
-    };
-    pageChanged(m_webTab->webView()->page());
-    connect(m_webTab->webView(), &WebView::pageChanged, this, pageChanged);
 }
 
 void TabItem::updateIcon()
@@ -942,9 +1195,6 @@ bool TabTreeWidget::dropMimeData(QTreeWidgetItem *parent, int index, const QMime
 
             if (index != webTab->tabIndex()) {
                 targetWindow->tabWidget()->tabBar()->moveTab(webTab->tabIndex(), index);
-
-                if (!webTab->isCurrentTab())
-                    emit requestRefreshTree();
             }
             else {
                 return false;
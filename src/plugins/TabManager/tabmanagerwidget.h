@@ -21,6 +21,8 @@
 #include <QWidget>
 #include <QPointer>
 #include <QHash>
+#include <QSet>
+#include <QRegularExpression>
 #include <QTreeWidgetItem>
 
 namespace Ui
@@ -33,7 +35,9 @@ class BrowserWindow;
 class WebPage;
 class WebTab;
 class WebView;
+class TabModel;
 class TLDExtractor;
+class TabItem;
 
 class TabTreeWidget : public QTreeWidget
 {
@@ -48,10 +52,6 @@ public:
     bool dropMimeData(QTreeWidgetItem *parent, int index, const QMimeData *data, Qt::DropAction action) override;
 
     void setEnableDragTabs(bool enable);
-
-Q_SIGNALS:
-    void requestRefreshTree();
-
 };
 
 class TabManagerWidget : public QWidget
@@ -82,13 +82,29 @@ public Q_SLOTS:
     void changeGroupType();
 
 private:
-    QTreeWidgetItem* groupByDomainName(bool useHostName = false);
+    QTreeWidgetItem* groupByDomainName();
     QTreeWidgetItem* groupByWindow();
     BrowserWindow* getWindow();
 
+    void connectTabModel(BrowserWindow* window);
+    void tabsInserted(BrowserWindow* window, int first, int last);
+    void tabsAboutToBeRemoved(BrowserWindow* window, int first, int last);
+    void tabMoved(BrowserWindow* window, int row);
+    void tabsDataChanged(BrowserWindow* window, int first, int last, const QVector<int> &roles);
+    void tabUrlChanged(WebTab* webTab);
+    void removeWindowItems(BrowserWindow* window);
+
+    TabItem* addTabItem(BrowserWindow* window, WebTab* webTab, int index);
+    void removeTabItem(TabItem* tabItem);
+    QTreeWidgetItem* domainGroupItem(const QString &domain);
+    bool isUpdatingIncrementally() const;
+
+    bool matchesFilter(TabItem* tabItem) const;
+    void updateItemVisibility(TabItem* tabItem);
+    void updateGroupVisibility(QTreeWidgetItem* groupItem);
+
     Ui::TabManagerWidget* ui;
     QPointer<BrowserWindow> m_window;
-    WebPage* m_webPage;
 
     bool m_isRefreshing;
     bool m_refreshBlocked;
@@ -97,6 +113,15 @@ private:
     GroupType m_groupType;
 
     QString m_filterText;
+    QRegularExpression m_filterRegExp;
+
+    // Tree state kept in sync with the TabModel of every window, so a single
+    // tab change only touches its own item instead of rebuilding the tree
+    QSet<TabModel*> m_tabModels;
+    QHash<WebTab*, TabItem*> m_tabItems;
+    QHash<BrowserWindow*, TabItem*> m_windowItems;
+    QHash<QString, TabItem*> m_domainItems;
+    QHash<WebTab*, QString> m_groupKeys;
 
     static TLDExtractor* s_tldExtractor;
 
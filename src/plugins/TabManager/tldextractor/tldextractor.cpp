@@ -18,11 +18,17 @@
 #include "tldextractor.h"
 
 #include <QApplication>
+#include <QDataStream>
+#include <QDateTime>
 #include <QDebug>
+#include <QDir>
 #include <QFileInfo>
 #include <QMessageBox>
+#include <QSaveFile>
 #include <QUrl>
 
+#define TLDExtractor_CompiledMagic 0x544c4431 // "TLD1"
+
 TLDExtractor* TLDExtractor::s_instance = 0;
 
 TLDExtractor::TLDExtractor(QObject* parent)
@@ -53,173 +59,114 @@ TLDExtractor::~TLDExtractor()
 
 bool TLDExtractor::isDataLoaded()
 {
-    return !m_tldHash.isEmpty();
+    return m_nodes.size() > 1;
 }
 
 QString TLDExtractor::TLD(const QString &host)
 {
-    if (host.isEmpty() || host.startsWith(QLatin1Char('.'))) {
-        return QString();
-    }
-
-    QString cleanHost = normalizedHost(host);
+    return splitParts(host).tld;
+}
 
-    QString tldPart = cleanHost.mid(cleanHost.lastIndexOf(QLatin1Char('.')) + 1);
-    cleanHost = QString::fromUtf8(QUrl::toAce(cleanHost));
+QString TLDExtractor::domain(const QString &host)
+{
+    return splitParts(host).domain;
+}
 
-    loadData();
+QString TLDExtractor::registrableDomain(const QString &host)
+{
+    return splitParts(host).registrableDomain;
+}
 
-    if (!m_tldHash.contains(tldPart)) {
-        return tldPart;
-    }
+QString TLDExtractor::subdomain(const QString &host)
+{
+    return splitParts(host).subdomain;
+}
 
-    QStringList tldRules = m_tldHash.values(tldPart);
+TLDExtractor::HostParts TLDExtractor::splitParts(const QString &host)
+{
+    HostParts hostParts;
+    hostParts.host = host;
 
-    if (!tldRules.contains(tldPart)) {
-        tldRules << tldPart;
+    if (host.isEmpty() || host.startsWith(QLatin1Char('.'))) {
+        return hostParts;
     }
 
-    int maxLabelCount = 0;
-    bool isExceptionTLD = false;
-    bool isWildcardTLD = false;
-
-    foreach(QString rule, tldRules) {
-        const int labelCount = rule.count(QLatin1Char('.')) + 1;
-
-        if (rule.startsWith(QLatin1Char('!'))) {
-            rule = rule.remove(0, 1);
-
-            rule = QString::fromUtf8(QUrl::toAce(rule));
-            isExceptionTLD = true;
-
-            // matches with exception TLD
-            if (cleanHost.endsWith(rule)) {
-                tldPart = rule.mid(rule.indexOf(QLatin1Char('.')) + 1);
-                break;
-            }
-        }
-        else {
-            isExceptionTLD = false;
-        }
-
-        if (rule.startsWith(QLatin1Char('*'))) {
-            rule.remove(0, 1);
-
-            if (rule.startsWith(QLatin1Char('.'))) {
-                rule.remove(0, 1);
-            }
-
-            isWildcardTLD = true;
-        }
-        else {
-            isWildcardTLD = false;
-        }
-
-        Q_UNUSED(isExceptionTLD)
-
-        rule = QString::fromUtf8(QUrl::toAce(rule));
-        const QString testRule = QLatin1Char('.') + rule;
-        const QString testUrl = QLatin1Char('.') + cleanHost;
-
-        if (labelCount > maxLabelCount && testUrl.endsWith(testRule)) {
-            tldPart = rule;
-            maxLabelCount = labelCount;
-
-            if (isWildcardTLD) {
-                QString temp = cleanHost;
-                temp.remove(temp.lastIndexOf(tldPart), tldPart.size());
+    const auto it = m_cache.constFind(host);
+    if (it != m_cache.constEnd()) {
+        return it.value();
+    }
 
-                if (temp.endsWith(QLatin1Char('.'))) {
-                    temp.remove(temp.size() - 1, 1);
-                }
+    loadData();
 
-                temp = temp.mid(temp.lastIndexOf(QLatin1Char('.')) + 1);
+    const QString cleanHost = normalizedHost(host);
+    const QStringList labels = cleanHost.split(QLatin1Char('.'));
 
-                tldPart = temp.isEmpty() ? rule : (temp + "." + rule);
-            }
-        }
+    QString aceHost = QString::fromUtf8(QUrl::toAce(cleanHost));
+    QStringList aceLabels = aceHost.split(QLatin1Char('.'));
+    if (aceHost.isEmpty() || aceLabels.size() != labels.size()) {
+        aceLabels = labels;
     }
 
-    QString temp = normalizedHost(host);
-    tldPart = temp.section(QLatin1Char('.'), temp.count(QLatin1Char('.')) - tldPart.count(QLatin1Char('.')));
-
-    return tldPart;
-}
+    const int suffixCount = qMin(publicSuffixLabelCount(aceLabels), labels.size());
+    const int domainIndex = labels.size() - suffixCount - 1;
 
-QString TLDExtractor::domain(const QString &host)
-{
-    const QString tldPart = TLD(host);
+    hostParts.tld = labels.mid(labels.size() - suffixCount).join(QLatin1Char('.'));
 
-    return domainHelper(host, tldPart);
-}
-
-QString TLDExtractor::domainHelper(const QString &host, const QString &tldPart)
-{
-    if (host.isEmpty() || tldPart.isEmpty()) {
-        return QString();
+    if (domainIndex >= 0) {
+        hostParts.domain = labels.at(domainIndex);
+        hostParts.registrableDomain = hostParts.domain + QLatin1Char('.') + hostParts.tld;
+        hostParts.subdomain = labels.mid(0, domainIndex).join(QLatin1Char('.'));
     }
 
-    QString temp = normalizedHost(host);
-    temp.remove(temp.lastIndexOf(tldPart), tldPart.size());
-
-    if (temp.endsWith(QLatin1Char('.'))) {
-        temp.remove(temp.size() - 1, 1);
+    // Hosts are mostly repeating (eg. tabs from same site), keep the cache small
+    if (m_cache.size() > 1000) {
+        m_cache.clear();
     }
+    m_cache.insert(host, hostParts);
 
-    return temp.mid(temp.lastIndexOf(QLatin1Char('.')) + 1);
+    return hostParts;
 }
 
-QString TLDExtractor::registrableDomainHelper(const QString &domainPart, const QString &tldPart)
+int TLDExtractor::publicSuffixLabelCount(const QStringList &aceLabels) const
 {
-    if (tldPart.isEmpty() || domainPart.isEmpty()) {
-        return QString();
-    }
-    else {
-        return QString("%1.%2").arg(domainPart).arg(tldPart);
+    // Default rule is "*", so at least last label is always public suffix
+    int suffixCount = 1;
+
+    if (m_nodes.isEmpty()) {
+        return suffixCount;
     }
-}
 
-QString TLDExtractor::subdomainHelper(const QString &host, const QString &registrablePart)
-{
-    if (!registrablePart.isEmpty()) {
-        QString subdomain = normalizedHost(host);
+    int nodeIndex = 0;
+    int depth = 0;
 
-        subdomain.remove(subdomain.lastIndexOf(registrablePart), registrablePart.size());
+    for (int i = aceLabels.size() - 1; i >= 0; --i) {
+        const Node &node = m_nodes.at(nodeIndex);
+        const auto it = node.children.constFind(aceLabels.at(i));
 
-        if (subdomain.endsWith(QLatin1Char('.'))) {
-            subdomain.remove(subdomain.size() - 1, 1);
+        if (it == node.children.constEnd()) {
+            if (node.wildcard) {
+                suffixCount = depth + 1;
+            }
+            break;
         }
 
-        return subdomain;
-    }
-
-    return QString();
-}
-
-QString TLDExtractor::registrableDomain(const QString &host)
-{
-    const QString tldPart = TLD(host);
-
-    return registrableDomainHelper(domainHelper(host, tldPart), tldPart);
-}
+        const Node &child = m_nodes.at(it.value());
 
-QString TLDExtractor::subdomain(const QString &host)
-{
-    return subdomainHelper(host, registrableDomain(host));
-}
+        // Exception rules prevail, public suffix is the parent of exception
+        if (child.exception) {
+            suffixCount = depth;
+            break;
+        }
 
-// a light function that extract all parts with just one call to TLD()
-TLDExtractor::HostParts TLDExtractor::splitParts(const QString &host)
-{
-    HostParts hostParts;
+        if (child.rule || node.wildcard) {
+            suffixCount = depth + 1;
+        }
 
-    hostParts.host = host;
-    hostParts.tld = TLD(host);
-    hostParts.domain = domainHelper(host, hostParts.tld);
-    hostParts.registrableDomain = registrableDomainHelper(hostParts.domain, hostParts.tld);
-    hostParts.subdomain = subdomainHelper(host, hostParts.registrableDomain);
+        nodeIndex = it.value();
+        ++depth;
+    }
 
-    return hostParts;
+    return suffixCount;
 }
 
 QStringList TLDExtractor::dataSearchPaths() const
@@ -234,6 +181,8 @@ void TLDExtractor::setDataSearchPaths(const QStringList &searchPaths)
     m_dataSearchPaths << TLDExtractor::defaultDataSearchPaths();
 
     m_dataSearchPaths.removeDuplicates();
+
+    clearData();
 }
 
 void TLDExtractor::loadData()
@@ -267,14 +216,32 @@ void TLDExtractor::loadData()
 
     m_dataFileName = dataFileName;
 
+    // Compiled rules are stored into first writable (non-resource) search path
+    QString compiledFileName;
+    foreach(const QString &path, m_dataSearchPaths) {
+        if (!path.startsWith(QLatin1Char(':')) && QFileInfo(path).isDir()) {
+            compiledFileName = QDir(path).absoluteFilePath(QLatin1String("effective_tld_names.bin"));
+            break;
+        }
+    }
+
+    if (!compiledFileName.isEmpty() && loadCompiledData(compiledFileName, dataFileName)) {
+        return;
+    }
+
     if (!parseData(dataFileName)) {
         qWarning() << "TLDExtractor: There is some parse errors for file:" << dataFileName;
+        return;
+    }
+
+    if (!compiledFileName.isEmpty()) {
+        saveCompiledData(compiledFileName, dataFileName);
     }
 }
 
 bool TLDExtractor::parseData(const QString &dataFile, bool loadPrivateDomains)
 {
-    m_tldHash.clear();
+    clearData();
 
     QFile file(dataFile);
 
@@ -302,7 +269,7 @@ bool TLDExtractor::parseData(const QString &dataFile, bool loadPrivateDomains)
             }
 
             if (!loadPrivateDomains && line.contains(QLatin1String("===BEGIN PRIVATE DOMAINS==="))) {
-                if (m_tldHash.isEmpty()) {
+                if (!isDataLoaded()) {
                     seekToEndOfPrivateDomains = true;
                 }
                 else {
@@ -318,26 +285,146 @@ bool TLDExtractor::parseData(const QString &dataFile, bool loadPrivateDomains)
         }
 
         // Each line is only read up to the first whitespace
-        line = line.left(line.indexOf(QLatin1Char(' ')));
+        addRule(line.left(line.indexOf(QLatin1Char(' '))));
+    }
 
-        if (!line.contains(QLatin1Char('.'))) {
-            m_tldHash.insertMulti(line, line);
-        }
-        else {
-            QString key = line.mid(line.lastIndexOf(QLatin1Char('.')) + 1);
+    return isDataLoaded();
+}
+
+void TLDExtractor::addRule(QString rule)
+{
+    bool exception = false;
+    bool wildcard = false;
+
+    if (rule.startsWith(QLatin1Char('!'))) {
+        rule.remove(0, 1);
+        exception = true;
+    }
+
+    if (rule.startsWith(QLatin1String("*."))) {
+        rule.remove(0, 2);
+        wildcard = true;
+    }
+
+    const QString aceRule = QString::fromUtf8(QUrl::toAce(rule));
+    if (!aceRule.isEmpty()) {
+        rule = aceRule;
+    }
+
+    const QStringList labels = rule.split(QLatin1Char('.'), QString::SkipEmptyParts);
+    int nodeIndex = 0;
+
+    for (int i = labels.size() - 1; i >= 0; --i) {
+        const QString &label = labels.at(i);
+        int childIndex = m_nodes.at(nodeIndex).children.value(label, -1);
 
-            m_tldHash.insertMulti(key, line);
+        if (childIndex == -1) {
+            childIndex = m_nodes.size();
+            m_nodes.append(Node());
+            m_nodes[nodeIndex].children.insert(label, childIndex);
         }
+
+        nodeIndex = childIndex;
     }
 
-    return isDataLoaded();
+    Node &node = m_nodes[nodeIndex];
+    if (exception) {
+        node.exception = true;
+    }
+    else if (wildcard) {
+        node.wildcard = true;
+    }
+    else {
+        node.rule = true;
+    }
+}
+
+void TLDExtractor::clearData()
+{
+    m_nodes.clear();
+    m_nodes.append(Node());
+    m_cache.clear();
+}
+
+bool TLDExtractor::loadCompiledData(const QString &compiledFile, const QString &dataFile)
+{
+    QFile file(compiledFile);
+
+    if (!file.open(QFile::ReadOnly)) {
+        return false;
+    }
+
+    const QFileInfo dataInfo(dataFile);
+
+    QDataStream stream(&file);
+
+    quint32 magic;
+    QString version;
+    QString sourceFile;
+    qint64 sourceSize;
+    qint64 sourceModified;
+    stream >> magic >> version >> sourceFile >> sourceSize >> sourceModified;
+
+    if (magic != TLDExtractor_CompiledMagic || version != QLatin1String(TLDExtractor_Version) ||
+        sourceFile != dataFile || sourceSize != dataInfo.size() ||
+        sourceModified != dataInfo.lastModified().toMSecsSinceEpoch()) {
+        return false;
+    }
+
+    qint32 count;
+    stream >> count;
+
+    QVector<Node> nodes;
+    nodes.reserve(count);
+
+    for (int i = 0; i < count && stream.status() == QDataStream::Ok; ++i) {
+        quint8 flags;
+        Node node;
+        stream >> flags >> node.children;
+        node.rule = flags & 1;
+        node.wildcard = flags & 2;
+        node.exception = flags & 4;
+        nodes.append(node);
+    }
+
+    if (stream.status() != QDataStream::Ok || nodes.size() != count || count < 2) {
+        return false;
+    }
+
+    m_nodes = nodes;
+    m_cache.clear();
+
+    return true;
+}
+
+void TLDExtractor::saveCompiledData(const QString &compiledFile, const QString &dataFile)
+{
+    QSaveFile file(compiledFile);
+
+    if (!file.open(QFile::WriteOnly)) {
+        qWarning() << "TLDExtractor: Cannot write compiled data to:" << compiledFile;
+        return;
+    }
+
+    const QFileInfo dataInfo(dataFile);
+
+    QDataStream stream(&file);
+    stream << quint32(TLDExtractor_CompiledMagic) << QString(QLatin1String(TLDExtractor_Version));
+    stream << dataFile << qint64(dataInfo.size()) << qint64(dataInfo.lastModified().toMSecsSinceEpoch());
+    stream << qint32(m_nodes.size());
+
+    for (const Node &node : qAsConst(m_nodes)) {
+        const quint8 flags = (node.rule ? 1 : 0) | (node.wildcard ? 2 : 0) | (node.exception ? 4 : 0);
+        stream << flags << node.children;
+    }
+
+    file.commit();
 }
 
 QString TLDExtractor::normalizedHost(const QString &host) const
 {
     return host.toLower();
 }
-
 // methods for testing
 bool TLDExtractor::test()
 {
@@ -402,7 +489,7 @@ bool TLDExtractor::test()
     }
 
     // reset cache for normal use
-    m_tldHash.clear();
+    clearData();
 
     return allTestSuccess;
 }
@@ -18,11 +18,14 @@
 #ifndef TLDEXTRACTOR_H
 #define TLDEXTRACTOR_H
 
-#define TLDExtractor_Version "1.0"
+#define TLDExtractor_Version "1.1"
 
 #include <QHash>
 #include <QObject>
 #include <QStringList>
+#include <QVector>
+
+class QDataStream;
 
 class TLDExtractor : public QObject
 {
@@ -47,6 +50,7 @@ public:
     QString registrableDomain(const QString &host);
     QString subdomain(const QString &host);
 
+    // Extracts all parts with just one walk of rules
     HostParts splitParts(const QString &host);
 
     QStringList dataSearchPaths() const;
@@ -57,6 +61,14 @@ public:
 private:
     Q_DISABLE_COPY(TLDExtractor)
 
+    // Rules are stored in a trie of reversed ACE encoded labels (com -> example -> ...)
+    struct Node {
+        QHash<QString, int> children;
+        bool rule = false;      // "example.com"
+        bool wildcard = false;  // "*.example.com"
+        bool exception = false; // "!www.example.com"
+    };
+
     static TLDExtractor* s_instance;
     TLDExtractor(QObject* parent = 0);
 
@@ -64,10 +76,13 @@ private:
 
     void loadData();
     bool parseData(const QString &dataFile, bool loadPrivateDomains = false);
+    void addRule(QString rule);
+    void clearData();
+
+    bool loadCompiledData(const QString &compiledFile, const QString &dataFile);
+    void saveCompiledData(const QString &compiledFile, const QString &dataFile);
 
-    QString domainHelper(const QString &host, const QString &tldPart);
-    QString registrableDomainHelper(const QString &domainPart, const QString &tldPart);
-    QString subdomainHelper(const QString &host, const QString &registrablePart);
+    int publicSuffixLabelCount(const QStringList &aceLabels) const;
 
     QString normalizedHost(const QString &host) const;
 
@@ -76,7 +91,8 @@ private:
     QString m_dataFileName;
     QStringList m_dataSearchPaths;
 
-    QMultiHash<QString, QString> m_tldHash;
+    QVector<Node> m_nodes;
+    QHash<QString, HostParts> m_cache;
 };
 
 #endif // TLDEXTRACTOR_H
@@ -18,39 +18,9 @@
 #include "loadinganimator.h"
 
 #include "tabicon.h"
+#include "tabiconanimator.h"
 #include "tabmodel.h"
 
-#include <QTimer>
-
-class LoadingAnimation : public QObject
-{
-public:
-    explicit LoadingAnimation(LoadingAnimator *animator)
-        : QObject(animator)
-        , m_animator(animator)
-    {
-        QTimer *timer = new QTimer(this);
-        timer->setInterval(TabIcon::data()->animationInterval);
-        connect(timer, &QTimer::timeout, this, [this]() {
-            m_currentFrame = (m_currentFrame + 1) % TabIcon::data()->framesCount;
-            m_animator->updatePixmap(this);
-        });
-        timer->start();
-    }
-
-    QPixmap pixmap() const
-    {
-        const QPixmap p = TabIcon::data()->animationPixmap;
-        const int size = 16;
-        const int pixmapSize = qRound(size * p.devicePixelRatioF());
-        return p.copy(m_currentFrame * pixmapSize, 0, pixmapSize, pixmapSize);
-    }
-
-private:
-    int m_currentFrame = 0;
-    LoadingAnimator *m_animator;
-};
-
 LoadingAnimator::LoadingAnimator(QObject *parent)
     : QObject(parent)
 {
@@ -58,23 +28,36 @@ LoadingAnimator::LoadingAnimator(QObject *parent)
 
 QPixmap LoadingAnimator::pixmap(const QModelIndex &index)
 {
-    LoadingAnimation *animation = m_animations.value(index);
-    if (!animation) {
-        animation = new LoadingAnimation(this);
-        m_indexes[animation] = index;
-        m_animations[index] = animation;
+    if (m_indexes.isEmpty()) {
+        TabIconAnimator *animator = TabIconAnimator::instance();
+        connect(animator, &TabIconAnimator::frameChanged, this, &LoadingAnimator::updateFrame, Qt::UniqueConnection);
+        animator->start(this);
     }
-    return animation->pixmap();
+    m_indexes.insert(index);
+
+    const QPixmap p = TabIcon::data()->animationPixmap;
+    const int size = 16;
+    const int pixmapSize = qRound(size * p.devicePixelRatioF());
+    const int frame = TabIconAnimator::instance()->currentFrame();
+    return p.copy(frame * pixmapSize, 0, pixmapSize, pixmapSize);
 }
 
-void LoadingAnimator::updatePixmap(LoadingAnimation *animation)
+void LoadingAnimator::updateFrame()
 {
-    const QModelIndex index = m_indexes.value(animation);
-    if (!index.isValid() || !index.data(TabModel::LoadingRole).toBool()) {
-        animation->deleteLater();
-        m_indexes.remove(animation);
-        m_animations.remove(index);
-    } else {
-        emit updateIndex(index);
+    auto it = m_indexes.begin();
+    while (it != m_indexes.end()) {
+        const QModelIndex index = *it;
+        if (!index.isValid() || !index.data(TabModel::LoadingRole).toBool()) {
+            it = m_indexes.erase(it);
+        } else {
+            emit updateIndex(index);
+            ++it;
+        }
+    }
+
+    if (m_indexes.isEmpty()) {
+        TabIconAnimator *animator = TabIconAnimator::instance();
+        disconnect(animator, &TabIconAnimator::frameChanged, this, &LoadingAnimator::updateFrame);
+        animator->stop(this);
     }
 }
@@ -17,12 +17,10 @@
 * ============================================================ */
 #pragma once
 
-#include <QHash>
+#include <QSet>
 #include <QObject>
 #include <QPersistentModelIndex>
 
-class LoadingAnimation;
-
 class LoadingAnimator : public QObject
 {
     Q_OBJECT
@@ -36,10 +34,7 @@ Q_SIGNALS:
     void updateIndex(const QModelIndex &index);
 
 private:
-    void updatePixmap(LoadingAnimation *animation);
-
-    QHash<LoadingAnimation*, QPersistentModelIndex> m_indexes;
-    QHash<QPersistentModelIndex, LoadingAnimation*> m_animations;
+    void updateFrame();
 
-    friend class LoadingAnimation;
+    QSet<QPersistentModelIndex> m_indexes;
 };
@@ -126,8 +126,15 @@ void TabListView::dataChanged(const QModelIndex &topLeft, const QModelIndex &bot
 {
     QListView::dataChanged(topLeft, bottomRight, roles);
 
-    if (roles.size() == 1 && roles.at(0) == TabModel::CurrentTabRole && topLeft.data(TabModel::CurrentTabRole).toBool()) {
-        setCurrentIndex(topLeft);
+    // Changes are coalesced, range may contain both previous and new current tab
+    if (roles.contains(TabModel::CurrentTabRole)) {
+        for (int row = topLeft.row(); row <= bottomRight.row(); ++row) {
+            const QModelIndex index = topLeft.sibling(row, 0);
+            if (index.data(TabModel::CurrentTabRole).toBool()) {
+                setCurrentIndex(index);
+                break;
+            }
+        }
     }
 }
 
@@ -60,7 +60,9 @@ void VerticalTabsPlugin::init(InitState state, const QString &settingsPath)
     m_schemeHandler = new VerticalTabsSchemeHandler(this);
     mApp->networkManager()->registerExtensionSchemeHandler(QSL("verticaltabs"), m_schemeHandler);
 
-    mApp->plugins()->registerAppEventHandler(PluginProxy::KeyPressHandler, this);
+    PluginProxy::HandlerFilter filter;
+    filter.objects = {Qz::ON_TabWidget};
+    mApp->plugins()->registerAppEventHandler(PluginProxy::KeyPressHandler, this, filter);
 
     setWebTabBehavior(m_addChildBehavior);
     loadStyleSheet(m_theme);
@@ -0,0 +1,211 @@
+/* ============================================================
+* Falkon - Qt web browser
+* Copyright (C) 2018 David Rosca <nowrep@gmail.com>
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program.  If not, see <http://www.gnu.org/licenses/>.
+* ============================================================ */
+#include "bookmarkitem.h"
+#include "bookmarksimport/htmlimporter.h"
+#include "bookmarksimport/chromeimporter.h"
+#include "bookmarksimport/firefoximporter.h"
+#include "benchmarks.h"
+
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QSqlDatabase>
+#include <QSqlQuery>
+#include <QTemporaryDir>
+
+class BookmarksImportBenchmark : public QObject
+{
+    Q_OBJECT
+
+private Q_SLOTS:
+    void initTestCase();
+
+    void importHtml();
+    void importChrome();
+    void importFirefox();
+
+private:
+    void createHtmlFile();
+    void createChromeFile();
+    void createFirefoxDatabase();
+
+    QTemporaryDir m_tempDir;
+};
+
+static const int bookmarksCount = 50000;
+static const int bookmarksPerFolder = 100;
+
+static int countBookmarks(BookmarkItem *item)
+{
+    int count = item->isUrl() ? 1 : 0;
+    const auto children = item->children();
+    for (BookmarkItem *child : children) {
+        count += countBookmarks(child);
+    }
+    return count;
+}
+
+void BookmarksImportBenchmark::initTestCase()
+{
+    QVERIFY(m_tempDir.isValid());
+
+    createHtmlFile();
+    createChromeFile();
+    createFirefoxDatabase();
+}
+
+void BookmarksImportBenchmark::createHtmlFile()
+{
+    QFile file(m_tempDir.filePath(QSL("bookmarks.html")));
+    QVERIFY(file.open(QFile::WriteOnly));
+
+    QTextStream stream(&file);
+    stream.setCodec("UTF-8");
+    stream << "<!DOCTYPE NETSCAPE-Bookmark-file-1>\n"
+              "<TITLE>Bookmarks</TITLE>\n"
+              "<H1>Bookmarks</H1>\n"
+              "<DL><p>\n";
+
+    for (int i = 0; i < bookmarksCount; ++i) {
+        if (i % bookmarksPerFolder == 0) {
+            if (i > 0) {
+                stream << "    </DL><p>\n";
+            }
+            stream << "    <DT><H3 ADD_DATE=\"1500000000\">Folder " << i / bookmarksPerFolder << "</H3>\n"
+                      "    <DL><p>\n";
+        }
+        stream << "        <DT><A HREF=\"https://example.com/page/" << i << "\" ADD_DATE=\"1500000000\">Page " << i << "</A>\n";
+    }
+
+    stream << "    </DL><p>\n"
+              "</DL><p>\n";
+}
+
+void BookmarksImportBenchmark::createChromeFile()
+{
+    QJsonArray folders;
+    QJsonArray children;
+
+    for (int i = 0; i < bookmarksCount; ++i) {
+        QJsonObject bookmark;
+        bookmark.insert(QSL("type"), QSL("url"));
+        bookmark.insert(QSL("name"), QSL("Page %1").arg(i));
+        bookmark.insert(QSL("url"), QSL("https://example.com/page/%1").arg(i));
+        children.append(bookmark);
+
+        if (children.size() == bookmarksPerFolder) {
+            QJsonObject folder;
+            folder.insert(QSL("type"), QSL("folder"));
+            folder.insert(QSL("name"), QSL("Folder %1").arg(folders.size()));
+            folder.insert(QSL("children"), children);
+            folders.append(folder);
+            children = QJsonArray();
+        }
+    }
+
+    QJsonObject bookmarkBar;
+    bookmarkBar.insert(QSL("name"), QSL("Bookmarks bar"));
+    bookmarkBar.insert(QSL("children"), folders);
+
+    QJsonObject roots;
+    roots.insert(QSL("bookmark_bar"), bookmarkBar);
+
+    QJsonObject document;
+    document.insert(QSL("roots"), roots);
+
+    QFile file(m_tempDir.filePath(QSL("Bookmarks")));
+    QVERIFY(file.open(QFile::WriteOnly));
+    file.write(QJsonDocument(document).toJson());
+}
+
+void BookmarksImportBenchmark::createFirefoxDatabase()
+{
+    {
+        QSqlDatabase db = QSqlDatabase::addDatabase(QSL("QSQLITE"), QSL("benchmark-places"));
+        db.setDatabaseName(m_tempDir.filePath(QSL("places.sqlite")));
+        QVERIFY(db.open());
+
+        QSqlQuery query(db);
+        QVERIFY(query.exec(QSL("CREATE TABLE moz_places (id INTEGER PRIMARY KEY, url LONGVARCHAR)")));
+        QVERIFY(query.exec(QSL("CREATE TABLE moz_bookmarks (id INTEGER PRIMARY KEY, type INTEGER, fk INTEGER, parent INTEGER, title LONGVARCHAR)")));
+
+        db.transaction();
+
+        QSqlQuery placeQuery(db);
+        placeQuery.prepare(QSL("INSERT INTO moz_places (id, url) VALUES (?, ?)"));
+        QSqlQuery bookmarkQuery(db);
+        bookmarkQuery.prepare(QSL("INSERT INTO moz_bookmarks (type, fk, parent, title) VALUES (1, ?, 1, ?)"));
+
+        for (int i = 0; i < bookmarksCount; ++i) {
+            placeQuery.addBindValue(i + 1);
+            placeQuery.addBindValue(QSL("https://example.com/page/%1").arg(i));
+            placeQuery.exec();
+
+            bookmarkQuery.addBindValue(i + 1);
+            bookmarkQuery.addBindValue(QSL("Page %1").arg(i));
+            bookmarkQuery.exec();
+        }
+
+        db.commit();
+    }
+    QSqlDatabase::removeDatabase(QSL("benchmark-places"));
+}
+
+void BookmarksImportBenchmark::importHtml()
+{
+    HtmlImporter importer;
+    importer.setPath(m_tempDir.filePath(QSL("bookmarks.html")));
+
+    QBENCHMARK {
+        QVERIFY(importer.prepareImport());
+        BookmarkItem *root = importer.importBookmarks();
+        QCOMPARE(countBookmarks(root), bookmarksCount);
+        delete root;
+    }
+}
+
+void BookmarksImportBenchmark::importChrome()
+{
+    ChromeImporter importer;
+    importer.setPath(m_tempDir.filePath(QSL("Bookmarks")));
+
+    QBENCHMARK {
+        QVERIFY(importer.prepareImport());
+        BookmarkItem *root = importer.importBookmarks();
+        QVERIFY(root);
+        QCOMPARE(countBookmarks(root), bookmarksCount);
+        delete root;
+    }
+}
+
+void BookmarksImportBenchmark::importFirefox()
+{
+    FirefoxImporter importer;
+    importer.setPath(m_tempDir.filePath(QSL("places.sqlite")));
+
+    QBENCHMARK {
+        QVERIFY(importer.prepareImport());
+        BookmarkItem *root = importer.importBookmarks();
+        QCOMPARE(countBookmarks(root), bookmarksCount);
+        delete root;
+    }
+}
+
+FALKONBENCHMARK_MAIN(BookmarksImportBenchmark)
+
+#include "bookmarksimport.moc"
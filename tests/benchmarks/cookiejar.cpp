@@ -0,0 +1,129 @@
+/* ============================================================
+* Falkon - Qt web browser
+* Copyright (C) 2018 David Rosca <nowrep@gmail.com>
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program.  If not, see <http://www.gnu.org/licenses/>.
+* ============================================================ */
+#include "cookiejar.h"
+#include "benchmarks.h"
+
+#include <QNetworkCookie>
+#include <QWebEngineProfile>
+#include <QWebEngineCookieStore>
+
+class CookieJar_Bench : public CookieJar
+{
+public:
+    // Emulate cookie store notifications, CookieJar only listens to its signals
+    void addCookie(const QNetworkCookie &cookie)
+    {
+        emit mApp->webProfile()->cookieStore()->cookieAdded(cookie);
+    }
+
+    void removeCookie(const QNetworkCookie &cookie)
+    {
+        emit mApp->webProfile()->cookieStore()->cookieRemoved(cookie);
+    }
+
+    static DomainSet compileDomainList(const QStringList &list)
+    {
+        return CookieJar::compileDomainList(list);
+    }
+
+    static bool domainSetMatches(const DomainSet &set, const QString &domain)
+    {
+        return CookieJar::domainSetMatches(set, domain);
+    }
+};
+
+class CookieJarBenchmark : public QObject
+{
+    Q_OBJECT
+
+private Q_SLOTS:
+    void initTestCase();
+
+    void addRemoveCookies();
+    void getAllCookies();
+    void domainListMatching();
+
+private:
+    QVector<QNetworkCookie> m_cookies;
+};
+
+static const int cookiesCount = 50000;
+
+void CookieJarBenchmark::initTestCase()
+{
+    // 50k cookies spread over 5k domains
+    m_cookies.reserve(cookiesCount);
+    for (int i = 0; i < cookiesCount; ++i) {
+        QNetworkCookie cookie(QByteArray("cookie") + QByteArray::number(i / 5000), QByteArray("value"));
+        cookie.setDomain(QSL(".sub%1.domain%2.com").arg(i % 3).arg(i % 5000));
+        cookie.setPath(QSL("/"));
+        m_cookies.append(cookie);
+    }
+}
+
+void CookieJarBenchmark::addRemoveCookies()
+{
+    CookieJar_Bench jar;
+
+    QBENCHMARK {
+        for (const QNetworkCookie &cookie : qAsConst(m_cookies)) {
+            jar.addCookie(cookie);
+        }
+        for (const QNetworkCookie &cookie : qAsConst(m_cookies)) {
+            jar.removeCookie(cookie);
+        }
+    }
+
+    QVERIFY(jar.getAllCookies().isEmpty());
+}
+
+void CookieJarBenchmark::getAllCookies()
+{
+    CookieJar_Bench jar;
+    for (const QNetworkCookie &cookie : qAsConst(m_cookies)) {
+        jar.addCookie(cookie);
+    }
+
+    QBENCHMARK {
+        jar.getAllCookies();
+    }
+}
+
+void CookieJarBenchmark::domainListMatching()
+{
+    QStringList list;
+    for (int i = 0; i < 1000; ++i) {
+        list.append(QSL("domain%1.com").arg(i * 5));
+    }
+
+    const auto set = CookieJar_Bench::compileDomainList(list);
+
+    QBENCHMARK {
+        int matches = 0;
+        for (const QNetworkCookie &cookie : qAsConst(m_cookies)) {
+            if (CookieJar_Bench::domainSetMatches(set, cookie.domain())) {
+                ++matches;
+            }
+        }
+        QCOMPARE(matches, cookiesCount / 5);
+    }
+}
+
+FALKONBENCHMARK_MAIN(CookieJarBenchmark)
+
+#include "cookiejar.moc"
@@ -0,0 +1,100 @@
+/* ============================================================
+* Falkon - Qt web browser
+* Copyright (C) 2018 David Rosca <nowrep@gmail.com>
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program.  If not, see <http://www.gnu.org/licenses/>.
+* ============================================================ */
+#include "tabbar.h"
+#include "tabwidget.h"
+#include "browserwindow.h"
+#include "benchmarks.h"
+
+class TabBarBenchmark : public QObject
+{
+    Q_OBJECT
+
+private Q_SLOTS:
+    void initTestCase();
+    void cleanupTestCase();
+
+    void openTabs();
+    void closeTabs();
+
+private:
+    void fillTabs();
+
+    BrowserWindow *m_window = nullptr;
+};
+
+static const int tabsCount = 500;
+
+void TabBarBenchmark::initTestCase()
+{
+    m_window = mApp->createWindow(Qz::BW_NewWindow);
+    m_window->resize(1200, 800);
+    m_window->show();
+    QVERIFY(QTest::qWaitForWindowExposed(m_window));
+}
+
+void TabBarBenchmark::cleanupTestCase()
+{
+    delete m_window;
+}
+
+void TabBarBenchmark::fillTabs()
+{
+    TabWidget *tabWidget = m_window->tabWidget();
+    while (tabWidget->count() < tabsCount) {
+        tabWidget->addView(QUrl(), Qz::NT_NotSelectedTab);
+    }
+}
+
+void TabBarBenchmark::openTabs()
+{
+    TabWidget *tabWidget = m_window->tabWidget();
+
+    QBENCHMARK {
+        while (tabWidget->count() > 1) {
+            tabWidget->closeTab(tabWidget->count() - 1);
+        }
+
+        for (int i = 1; i < tabsCount; ++i) {
+            tabWidget->addView(QUrl(), Qz::NT_SelectedTab);
+            // Tab bar layout is done in the event loop
+            QCoreApplication::processEvents();
+        }
+    }
+
+    QCOMPARE(tabWidget->count(), tabsCount);
+}
+
+void TabBarBenchmark::closeTabs()
+{
+    TabWidget *tabWidget = m_window->tabWidget();
+
+    QBENCHMARK {
+        fillTabs();
+
+        while (tabWidget->count() > 1) {
+            tabWidget->closeTab(tabWidget->currentIndex());
+            QCoreApplication::processEvents();
+        }
+    }
+
+    QCOMPARE(tabWidget->count(), 1);
+}
+
+FALKONBENCHMARK_MAIN(TabBarBenchmark)
+
+#include "tabbar.moc"
@@ -0,0 +1,128 @@
+/* ============================================================
+* Falkon - Qt web browser
+* Copyright (C) 2018 David Rosca <nowrep@gmail.com>
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program.  If not, see <http://www.gnu.org/licenses/>.
+* ============================================================ */
+#include "tabiconanimator.h"
+#include "tabicon.h"
+#include "tabwidget.h"
+#include "webtab.h"
+#include "tabbedwebview.h"
+#include "browserwindow.h"
+#include "benchmarks.h"
+
+#include <QElapsedTimer>
+
+class TabIconBenchmark : public QObject
+{
+    Q_OBJECT
+
+private Q_SLOTS:
+    void initTestCase();
+    void cleanupTestCase();
+
+    void reloadAllTabs();
+    void idle();
+
+private:
+    bool isLoading() const;
+
+    BrowserWindow *m_window = nullptr;
+};
+
+static const int tabsCount = 200;
+
+void TabIconBenchmark::initTestCase()
+{
+    m_window = mApp->createWindow(Qz::BW_NewWindow);
+    m_window->resize(1200, 800);
+    m_window->show();
+    QVERIFY(QTest::qWaitForWindowExposed(m_window));
+
+    TabWidget *tabWidget = m_window->tabWidget();
+    for (int i = 1; i < tabsCount; ++i) {
+        tabWidget->addView(QUrl(QSL("data:text/html,<title>Tab %1</title>").arg(i)), Qz::NT_NotSelectedTab);
+    }
+
+    QTRY_VERIFY_WITH_TIMEOUT(!isLoading(), 30000);
+}
+
+void TabIconBenchmark::cleanupTestCase()
+{
+    delete m_window;
+}
+
+bool TabIconBenchmark::isLoading() const
+{
+    const auto tabs = m_window->tabWidget()->allTabs();
+    for (WebTab *tab : tabs) {
+        if (tab->isLoading()) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void TabIconBenchmark::reloadAllTabs()
+{
+    TabIconAnimator *animator = TabIconAnimator::instance();
+    animator->resetStatistics();
+
+    int iterations = 0;
+    QElapsedTimer timer;
+    timer.start();
+
+    // Most of the tabs are scrolled out of view and don't need to be repainted
+    QBENCHMARK {
+        ++iterations;
+        m_window->tabWidget()->reloadAllTabs();
+        QTRY_VERIFY_WITH_TIMEOUT(!isLoading(), 30000);
+    }
+
+    const qint64 elapsed = timer.elapsed();
+    const TabIconAnimator::Statistics stats = animator->statistics();
+
+    int onScreen = 0;
+    const auto tabs = m_window->tabWidget()->allTabs();
+    for (WebTab *tab : tabs) {
+        TabIcon *icon = tab->tabIcon();
+        if (icon->isVisible() && !icon->visibleRegion().isEmpty()) {
+            ++onScreen;
+        }
+    }
+    QVERIFY(onScreen > 0);
+    QVERIFY(onScreen < tabsCount);
+
+    // One timer wakeup per frame for all tabs together
+    QVERIFY(stats.ticks <= elapsed / TabIcon::data()->animationInterval + iterations);
+
+    // At most one repaint per frame, and only for tabs on screen
+    QVERIFY(stats.repaints <= (stats.ticks + iterations) * onScreen);
+}
+
+void TabIconBenchmark::idle()
+{
+    TabIconAnimator *animator = TabIconAnimator::instance();
+    animator->resetStatistics();
+
+    QTest::qWait(2000);
+
+    QVERIFY(!animator->isRunning());
+    QCOMPARE(animator->statistics().ticks, 0);
+}
+
+FALKONBENCHMARK_MAIN(TabIconBenchmark)
+
+#include "tabicon.moc"
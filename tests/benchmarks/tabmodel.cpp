@@ -0,0 +1,95 @@
+/* ============================================================
+* Falkon - Qt web browser
+* Copyright (C) 2018 David Rosca <nowrep@gmail.com>
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program.  If not, see <http://www.gnu.org/licenses/>.
+* ============================================================ */
+#include "tabmodel.h"
+#include "tabtreemodel.h"
+#include "tabwidget.h"
+#include "webtab.h"
+#include "browserwindow.h"
+#include "benchmarks.h"
+
+#include <QTreeView>
+
+class TabModelBenchmark : public QObject
+{
+    Q_OBJECT
+
+private Q_SLOTS:
+    void initTestCase();
+
+    void restoreTabs();
+
+private:
+    QVector<WebTab::SavedTab> m_tabs;
+};
+
+static const int tabsCount = 500;
+
+void TabModelBenchmark::initTestCase()
+{
+    // 500 tabs, every fifth tab has four children
+    m_tabs.reserve(tabsCount);
+    for (int i = 0; i < tabsCount; ++i) {
+        WebTab::SavedTab tab;
+        tab.title = QSL("Tab %1").arg(i);
+        tab.url = QUrl(QSL("http://tab%1.test.com/").arg(i));
+        tab.zoomLevel = 0;
+        tab.parentTab = -1;
+        if (i % 5 == 0) {
+            // Restored tabs are inserted after the initial tab of new window
+            tab.childTabs = {i + 2, i + 3, i + 4, i + 5};
+        }
+        m_tabs.append(tab);
+    }
+}
+
+void TabModelBenchmark::restoreTabs()
+{
+    QBENCHMARK {
+        BrowserWindow *window = mApp->createWindow(Qz::BW_NewWindow);
+        QTest::qWait(0);
+
+        TabModel sourceModel(window);
+        TabTreeModel model(window);
+        model.setSourceModel(&sourceModel);
+
+        QTreeView view;
+        view.setModel(&model);
+        view.show();
+
+        int dataChangedCount = 0;
+        connect(&sourceModel, &TabModel::dataChanged, this, [&]() {
+            ++dataChangedCount;
+        });
+
+        window->tabWidget()->restoreState(m_tabs, 0);
+
+        // Coalesced changes are flushed in next event loop iteration
+        QCoreApplication::processEvents();
+
+        QCOMPARE(sourceModel.rowCount(), tabsCount + 1);
+
+        // All changes of the restore are emitted as one batch
+        QCOMPARE(dataChangedCount, 1);
+
+        delete window;
+    }
+}
+
+FALKONBENCHMARK_MAIN(TabModelBenchmark)
+
+#include "tabmodel.moc"